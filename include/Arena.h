@@ -0,0 +1,173 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Scratch memory for simulation kernels.
+//
+// An Arena hands out 64-byte-aligned blocks by bumping an offset and is reset in O(1)
+// between pricing calls. Its memory is mapped lazily and is first written by the worker
+// that owns it, so on a NUMA machine the pages land on that worker's node (pin the
+// workers, e.g. ThreadPoolExecutor(n, true), for this to hold). Regions of 2 MB and more
+// are advised for transparent huge pages. Once the arena is large enough for the
+// workload, allocate()/reset() never call the system allocator again.
+namespace Memory {
+
+const std::size_t CACHE_LINE = 64;
+const std::size_t HUGE_PAGE = 2 * 1024 * 1024;
+
+inline std::size_t alignUp(std::size_t bytes, std::size_t alignment) {
+    return (bytes + alignment - 1) & ~(alignment - 1);
+}
+
+// Page-aligned, zero-filled region; physical pages are assigned on first touch
+inline void* mapRegion(std::size_t bytes) {
+#if defined(__linux__)
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+    if (bytes >= HUGE_PAGE) ::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+    return p;
+#else
+    return ::operator new(bytes, std::align_val_t(CACHE_LINE));
+#endif
+}
+
+inline void unmapRegion(void* p, std::size_t bytes) {
+#if defined(__linux__)
+    ::munmap(p, bytes);
+#else
+    (void)bytes;
+    ::operator delete(p, std::align_val_t(CACHE_LINE));
+#endif
+}
+
+} // namespace Memory
+
+class Arena {
+private:
+    struct Region {
+        char* base;
+        std::size_t size;
+    };
+
+    std::vector<Region> regions_;   // regions_.back() is the one being filled
+    std::size_t offset_ = 0;        // Bytes used in the current region
+    std::size_t used_ = 0;          // Bytes handed out since the last reset
+    std::size_t highWater_ = 0;
+    std::size_t initialBytes_;
+    std::uint64_t systemAllocations_ = 0;
+
+    void addRegion(std::size_t atLeast) {
+        std::size_t size = Memory::alignUp(std::max(atLeast, std::max(initialBytes_, capacity())), Memory::CACHE_LINE);
+        if (size >= Memory::HUGE_PAGE) size = Memory::alignUp(size, Memory::HUGE_PAGE);
+        regions_.reserve(regions_.size() + 1);
+        regions_.push_back({static_cast<char*>(Memory::mapRegion(size)), size});
+        offset_ = 0;
+        ++systemAllocations_;
+    }
+
+    void releaseAll() {
+        for (const Region& r : regions_) Memory::unmapRegion(r.base, r.size);
+        regions_.clear();
+        offset_ = 0;
+    }
+
+public:
+    explicit Arena(std::size_t initialBytes = 256 * 1024) : initialBytes_(initialBytes) {}
+
+    ~Arena() { releaseAll(); }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // 64-byte-aligned, uninitialized storage valid until the next reset()
+    void* allocateBytes(std::size_t bytes) {
+        bytes = Memory::alignUp(bytes == 0 ? 1 : bytes, Memory::CACHE_LINE);
+        if (regions_.empty() || offset_ + bytes > regions_.back().size) addRegion(bytes);
+        void* p = regions_.back().base + offset_;
+        offset_ += bytes;
+        used_ += bytes;
+        if (used_ > highWater_) highWater_ = used_;
+        return p;
+    }
+
+    template <typename T>
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(allocateBytes(count * sizeof(T)));
+    }
+
+    // Makes all memory reusable. If the last call needed several regions, they are
+    // merged into one big enough for it, so the next identical call stays in one region.
+    void reset() {
+        if (regions_.size() > 1) {
+            std::size_t total = capacity();
+            releaseAll();
+            addRegion(total);
+        }
+        offset_ = 0;
+        used_ = 0;
+    }
+
+    std::size_t capacity() const {
+        std::size_t total = 0;
+        for (const Region& r : regions_) total += r.size;
+        return total;
+    }
+    std::size_t used() const { return used_; }
+    std::size_t highWater() const { return highWater_; }
+    std::uint64_t systemAllocations() const { return systemAllocations_; }
+};
+
+// One arena per executor worker, each on its own cache lines.
+// prepare() is called by the pricer before its parallel region; workers then only touch
+// arena(worker), so no synchronisation is needed.
+class WorkspacePool {
+private:
+    struct alignas(Memory::CACHE_LINE) Slot {
+        Arena arena;
+    };
+
+    std::vector<std::unique_ptr<Slot>> slots_;
+
+public:
+    WorkspacePool() = default;
+
+    // Workspaces are scratch, not state: a copied pricer starts with empty arenas
+    WorkspacePool(const WorkspacePool&) {}
+    WorkspacePool& operator=(const WorkspacePool&) { return *this; }
+
+    // Ensures 'workers' arenas exist and resets all of them
+    void prepare(int workers) {
+        while (static_cast<int>(slots_.size()) < workers) slots_.emplace_back(new Slot());
+        for (auto& s : slots_) s->arena.reset();
+    }
+
+    Arena& arena(int worker) { return slots_[worker]->arena; }
+
+    int size() const { return static_cast<int>(slots_.size()); }
+
+    std::uint64_t systemAllocations() const {
+        std::uint64_t total = 0;
+        for (const auto& s : slots_) total += s->arena.systemAllocations();
+        return total;
+    }
+
+    std::size_t capacity() const {
+        std::size_t total = 0;
+        for (const auto& s : slots_) total += s->arena.capacity();
+        return total;
+    }
+};
+
+#endif // ARENA_H
@@ -0,0 +1,210 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include "BenchmarkHarness.h"
+#include "EuropeanOption.h"
+#include "Executor.h"
+#include "HestonMC.h"
+#include "MonteCarlo.h"
+#include "Tuning.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// One measured candidate of the search
+struct TuningTrial {
+    std::string parameter;   // "executor", "mc_block_size" or "heston_tile_width"
+    std::string value;
+    double mcMs = 0.0;       // Median time of the MC workload (0 when not measured)
+    double hestonMs = 0.0;   // Median time of the Heston workload (0 when not measured)
+};
+
+struct TuningReport {
+    TuningConfig config;               // Best settings, stamped with this machine
+    std::vector<TuningTrial> trials;
+    double defaultMcMs = 0.0, tunedMcMs = 0.0;
+    double defaultHestonMs = 0.0, tunedHestonMs = 0.0;
+    double seconds = 0.0;              // Wall time of the search
+};
+
+// Short search of the kernel settings on this host.
+//
+// The workloads are an ATM call priced by MonteCarloPricer::price() (standard mode,
+// antithetic) and by HestonPricer::price(); each candidate is timed as the median of a few
+// runs. The search goes coordinate by coordinate from the built-in defaults:
+//   1. executor kind and thread count (OpenMP team, thread pool, pinned pool; powers of two
+//      up to the hardware threads), scored on both workloads (they share the executor);
+//   2. MC block size on the MC workload, with the chosen executor;
+//   3. Heston tile width on the Heston workload, with the chosen executor.
+// A candidate replaces the current best only if it is faster by more than minGain, and the
+// result is kept only if it still beats the defaults when both are timed alternately, so
+// timing noise does not move the settings away from the defaults.
+// The deterministic chunk size is not searched: it fixes the RNG streams, and shards run on
+// different machines must agree on it.
+class Autotuner {
+private:
+    int mc_paths_;
+    int heston_paths_;
+    int heston_steps_;
+    int repetitions_ = 5;
+    double min_gain_ = 0.03;
+    std::vector<int> thread_counts_;
+    std::vector<int> block_sizes_ = {256, 512, 1024, 2048, 4096, 8192};
+    std::vector<int> tile_widths_ = {4, 8, 16, 32, 64, 128};
+
+    template <typename Run>
+    double medianMs(Run&& run) const {
+        using Clock = std::chrono::steady_clock;
+        run();   // Warm-up: arenas, thread start-up, caches
+        std::vector<double> samples;
+        for (int r = 0; r < repetitions_; ++r) {
+            auto t0 = Clock::now();
+            run();
+            samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+
+    double timeMonteCarlo(Executor& executor, int block_size) const {
+        MonteCarloPricer mc(mc_paths_, 42, executor);
+        mc.setBlockSize(block_size);
+        EuropeanOption call(100.0, 1.0, OptionType::CALL);
+        return medianMs([&]() { doNotOptimize(mc.price(call, 100.0, 0.05, 0.2, true).first); });
+    }
+
+    double timeHeston(Executor& executor, int tile_width) const {
+        HestonPricer heston(heston_paths_, heston_steps_, executor);
+        heston.setTileWidth(tile_width);
+        EuropeanOption call(100.0, 1.0, OptionType::CALL);
+        return medianMs([&]() { doNotOptimize(heston.price(call, 100.0, 0.05, 0.04, 1.5, 0.04, 0.5, -0.7)); });
+    }
+
+    bool better(double candidate, double best) const { return candidate < best * (1.0 - min_gain_); }
+
+public:
+    explicit Autotuner(int mc_paths = 200000, int heston_paths = 4000, int heston_steps = 50)
+        : mc_paths_(mc_paths), heston_paths_(heston_paths), heston_steps_(heston_steps) {
+        int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int t = 1; t < hw; t *= 2) thread_counts_.push_back(t);
+        thread_counts_.push_back(hw);
+    }
+
+    // Executor described by a configuration (what defaultExecutor() builds from it)
+    static std::unique_ptr<Executor> makeExecutor(const TuningConfig& c) {
+#ifdef _OPENMP
+        if (c.executor == "openmp") return std::unique_ptr<Executor>(new OpenMPExecutor(c.threads));
+#endif
+        return std::unique_ptr<Executor>(new ThreadPoolExecutor(c.threads, c.pinThreads));
+    }
+
+    void setRepetitions(int n) { repetitions_ = std::max(1, n); }
+    void setMinGain(double fraction) { min_gain_ = std::max(0.0, fraction); }
+    void setThreadCounts(const std::vector<int>& counts) { thread_counts_ = counts; }
+    void setBlockSizes(const std::vector<int>& sizes) { block_sizes_ = sizes; }
+    void setTileWidths(const std::vector<int>& widths) { tile_widths_ = widths; }
+
+    TuningReport tune() const {
+        auto start = std::chrono::steady_clock::now();
+        TuningReport report;
+        TuningConfig best;   // Built-in defaults
+
+        // 1. Executor kind and thread count, both workloads
+        std::vector<TuningConfig> executors;
+#ifdef _OPENMP
+        for (int t : thread_counts_) {
+            TuningConfig c;
+            c.executor = "openmp";
+            c.threads = t;
+            executors.push_back(c);
+        }
+#endif
+        for (bool pin : {false, true}) {
+            for (int t : thread_counts_) {
+                TuningConfig c;
+                c.executor = "thread-pool";
+                c.threads = t;
+                c.pinThreads = pin;
+                executors.push_back(c);
+            }
+        }
+        {
+            std::unique_ptr<Executor> ex = makeExecutor(best);
+            report.defaultMcMs = timeMonteCarlo(*ex, best.mcBlockSize);
+            report.defaultHestonMs = timeHeston(*ex, best.hestonTileWidth);
+            report.trials.push_back({"executor", "default", report.defaultMcMs, report.defaultHestonMs});
+        }
+        // Score relative to the defaults, so both workloads weigh the same
+        double bestScore = 2.0;
+        for (const TuningConfig& c : executors) {
+            std::unique_ptr<Executor> ex = makeExecutor(c);
+            double mcMs = timeMonteCarlo(*ex, best.mcBlockSize);
+            double hestonMs = timeHeston(*ex, best.hestonTileWidth);
+            report.trials.push_back({"executor", c.executor + (c.pinThreads ? " pinned x" : " x") + std::to_string(c.threads),
+                                     mcMs, hestonMs});
+            double score = mcMs / report.defaultMcMs + hestonMs / report.defaultHestonMs;
+            if (better(score, bestScore)) {
+                bestScore = score;
+                best.executor = c.executor;
+                best.threads = c.threads;
+                best.pinThreads = c.pinThreads;
+            }
+        }
+        std::unique_ptr<Executor> chosen = makeExecutor(best);
+
+        // 2. MC block size
+        double bestMc = timeMonteCarlo(*chosen, best.mcBlockSize);
+        for (int size : block_sizes_) {
+            if (size == best.mcBlockSize) continue;
+            double ms = timeMonteCarlo(*chosen, size);
+            report.trials.push_back({"mc_block_size", std::to_string(size), ms, 0.0});
+            if (better(ms, bestMc)) {
+                bestMc = ms;
+                best.mcBlockSize = size;
+            }
+        }
+
+        // 3. Heston tile width
+        double bestHeston = timeHeston(*chosen, best.hestonTileWidth);
+        for (int width : tile_widths_) {
+            if (width == best.hestonTileWidth) continue;
+            double ms = timeHeston(*chosen, width);
+            report.trials.push_back({"heston_tile_width", std::to_string(width), 0.0, ms});
+            if (better(ms, bestHeston)) {
+                bestHeston = ms;
+                best.hestonTileWidth = width;
+            }
+        }
+
+        // 4. Confirmation: defaults and candidate timed alternately, so drifts of the machine's
+        //    state (clock frequency, other load) hit both; the candidate must still win
+        const TuningConfig defaults;
+        std::unique_ptr<Executor> builtin = makeExecutor(defaults);
+        double d[2] = {1e300, 1e300}, t[2] = {1e300, 1e300};
+        for (int round = 0; round < 3; ++round) {
+            d[0] = std::min(d[0], timeMonteCarlo(*builtin, defaults.mcBlockSize));
+            t[0] = std::min(t[0], timeMonteCarlo(*chosen, best.mcBlockSize));
+            d[1] = std::min(d[1], timeHeston(*builtin, defaults.hestonTileWidth));
+            t[1] = std::min(t[1], timeHeston(*chosen, best.hestonTileWidth));
+        }
+        report.defaultMcMs = d[0];
+        report.defaultHestonMs = d[1];
+        if (best != defaults && better(t[0] / d[0] + t[1] / d[1], 2.0)) {
+            report.tunedMcMs = t[0];
+            report.tunedHestonMs = t[1];
+        } else {
+            best = defaults;
+            report.tunedMcMs = d[0];
+            report.tunedHestonMs = d[1];
+        }
+        best.stampMachine();
+        report.config = best;
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
+};
+
+#endif // AUTOTUNE_H
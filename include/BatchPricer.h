@@ -0,0 +1,138 @@
+#ifndef BATCH_PRICER_H
+#define BATCH_PRICER_H
+
+#include "Executor.h"
+#include "JumpDiffusion.h"
+#include "TermStructure.h"
+#include "Option.h"
+#include "Utils.h"
+#include <cmath>
+#include <cstddef>
+
+// Structure-of-arrays view over a batch of European options.
+// The pointers are not owned: they can point into std::vectors, a book or a mapped file.
+struct OptionBatch {
+    std::size_t size = 0;
+    const double* spot = nullptr;
+    const double* strike = nullptr;
+    const double* rate = nullptr;
+    const double* volatility = nullptr;
+    const double* maturity = nullptr;
+    const OptionType* type = nullptr;
+    const double* dividend = nullptr;   // Continuous dividend yields (nullptr = none)
+};
+
+// Output columns of a batch run. Any pointer left to nullptr is simply not computed.
+struct GreeksBatch {
+    double* price = nullptr;
+    double* delta = nullptr;
+    double* gamma = nullptr;
+    double* vega = nullptr;
+};
+
+class BatchPricer {
+public:
+    // Black-Scholes price and Greeks for every option of the batch (same formulas as BlackScholes)
+    static void priceBlackScholes(const OptionBatch& batch, const GreeksBatch& out,
+                                  Executor& executor = defaultExecutor()) {
+        executor.parallelFor(batch.size, [&](std::size_t begin, std::size_t end, int) {
+            priceRange(batch, out, begin, end);
+        });
+    }
+
+    // Black-Scholes price and Greeks for a chain of n options sharing one expiry.
+    // The context carries the curve lookups and dividend sums of that expiry, and the kernel
+    // works in forward terms, so a chain costs no more than flat-rate pricing.
+    static void priceExpiry(const ExpiryContext& ctx, const double* strike, const double* volatility,
+                            const OptionType* type, std::size_t n, const GreeksBatch& out,
+                            Executor& executor = defaultExecutor()) {
+        executor.parallelFor(n, [&](std::size_t begin, std::size_t end, int) {
+            priceExpiryRange(ctx, strike, volatility, type, out, begin, end);
+        });
+    }
+
+    static void priceExpiryRange(const ExpiryContext& ctx, const double* strike, const double* volatility,
+                                 const OptionType* type, const GreeksBatch& out, std::size_t begin, std::size_t end) {
+        // Per-expiry constants
+        const double T = ctx.maturity;
+        const double sqrt_T = std::sqrt(T);
+        const double F = ctx.forward;
+        const double log_F = std::log(F);
+        const double df = ctx.discount;
+        const double carry = df * F / ctx.spot;   // exp(-q T)
+
+        for (std::size_t i = begin; i < end; ++i) {
+            double K = strike[i];
+            double sig_sqrt_T = volatility[i] * sqrt_T;
+            double d1 = (log_F - std::log(K)) / sig_sqrt_T + 0.5 * sig_sqrt_T;
+            double d2 = d1 - sig_sqrt_T;
+            double nd1 = normalCDF(d1);
+            bool is_call = (type[i] == OptionType::CALL);
+
+            if (out.price) {
+                out.price[i] = is_call
+                    ? df * (F * nd1 - K * normalCDF(d2))
+                    : df * (K * normalCDF(-d2) - F * normalCDF(-d1));
+            }
+            if (out.delta) out.delta[i] = is_call ? carry * nd1 : carry * (nd1 - 1.0);
+            if (out.gamma || out.vega) {
+                double pdf = normalPDF(d1);
+                if (out.gamma) out.gamma[i] = carry * pdf / (ctx.spot * sig_sqrt_T);
+                if (out.vega) out.vega[i] = carry * ctx.spot * pdf * sqrt_T;
+            }
+        }
+    }
+
+    // Merton jump-diffusion prices for every option of the batch, all sharing one set of jump
+    // parameters (a chain or a calibration slice). Only out.price is filled.
+    static void priceMerton(const OptionBatch& batch, const JumpParams& jumps, const GreeksBatch& out,
+                            Executor& executor = defaultExecutor()) {
+        if (!out.price) return;
+        executor.parallelFor(batch.size, [&](std::size_t begin, std::size_t end, int) {
+            for (std::size_t i = begin; i < end; ++i) {
+                ExpiryContext ctx;
+                ctx.maturity = batch.maturity[i];
+                ctx.spot = batch.spot[i];
+                ctx.rate = batch.rate[i];
+                ctx.dividendYield = batch.dividend ? batch.dividend[i] : 0.0;
+                out.price[i] = MertonJumpDiffusion(ctx, batch.strike[i], batch.volatility[i], batch.type[i], jumps).price();
+            }
+        });
+    }
+
+    // Serial kernel over options [begin, end)
+    static void priceRange(const OptionBatch& batch, const GreeksBatch& out, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            double S = batch.spot[i];
+            double K = batch.strike[i];
+            double r = batch.rate[i];
+            double sigma = batch.volatility[i];
+            double T = batch.maturity[i];
+            double q = batch.dividend ? batch.dividend[i] : 0.0;
+            bool is_call = (batch.type[i] == OptionType::CALL);
+
+            double sqrt_T = std::sqrt(T);
+            double sig_sqrt_T = sigma * sqrt_T;
+            double d1 = (std::log(S / K) + (r - q + 0.5 * sigma * sigma) * T) / sig_sqrt_T;
+            double d2 = d1 - sig_sqrt_T;
+            double nd1 = normalCDF(d1);
+            double carry = batch.dividend ? std::exp(-q * T) : 1.0;
+            double carry_spot = S * carry;
+
+            if (out.price) {
+                double discount_factor = std::exp(-r * T);
+                out.price[i] = is_call
+                    ? carry_spot * nd1 - K * discount_factor * normalCDF(d2)
+                    : K * discount_factor * normalCDF(-d2) - carry_spot * normalCDF(-d1);
+            }
+            if (out.delta) out.delta[i] = is_call ? carry * nd1 : carry * (nd1 - 1.0);
+            if (out.gamma || out.vega) {
+                double pdf = normalPDF(d1);
+                if (out.gamma) out.gamma[i] = carry * pdf / (S * sig_sqrt_T);
+                if (out.vega) out.vega[i] = carry_spot * pdf * sqrt_T;
+            }
+        }
+    }
+};
+
+#endif // BATCH_PRICER_H
@@ -0,0 +1,175 @@
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Keeps a value alive so the optimizer cannot drop the computation that produced it
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile T sink;
+    sink = value;
+#endif
+}
+
+// Timing statistics over the measured repetitions of one benchmark
+struct BenchResult {
+    std::string name;
+    int threads = 1;
+    double items = 0.0;                // Work items per repetition (options, paths, ...)
+    std::string unit;                  // What an item is
+    std::vector<double> samples_ms;
+    double min_ms = 0.0, median_ms = 0.0, mean_ms = 0.0, stddev_ms = 0.0, p90_ms = 0.0;
+    double throughput = 0.0;           // items / second at the median
+    std::map<std::string, double> extra; // Free-form metrics (bias, std error, ...)
+};
+
+class BenchmarkHarness {
+private:
+    int warmup_;
+    int repetitions_;
+    std::vector<BenchResult> results_;
+
+    static double percentile(std::vector<double> v, double q) {
+        std::sort(v.begin(), v.end());
+        double pos = q * (v.size() - 1);
+        std::size_t lo = static_cast<std::size_t>(pos);
+        std::size_t hi = std::min(lo + 1, v.size() - 1);
+        return v[lo] + (pos - lo) * (v[hi] - v[lo]);
+    }
+
+    static std::string escape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+public:
+    BenchmarkHarness(int warmup = 2, int repetitions = 10)
+        : warmup_(warmup), repetitions_(repetitions) {}
+
+    // Runs 'body' warmup + repetitions times; 'setup' (untimed) runs before every repetition
+    BenchResult& run(const std::string& name, double items, const std::string& unit, int threads,
+                     const std::function<void()>& body,
+                     const std::function<void()>& setup = std::function<void()>()) {
+        BenchResult r;
+        r.name = name;
+        r.items = items;
+        r.unit = unit;
+        r.threads = threads;
+
+        for (int i = 0; i < warmup_ + repetitions_; ++i) {
+            if (setup) setup();
+            auto start = std::chrono::steady_clock::now();
+            body();
+            auto end = std::chrono::steady_clock::now();
+            if (i >= warmup_) r.samples_ms.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+
+        double sum = 0.0, sq = 0.0;
+        for (double s : r.samples_ms) { sum += s; sq += s * s; }
+        std::size_t n = r.samples_ms.size();
+        r.mean_ms = sum / n;
+        r.stddev_ms = n > 1 ? std::sqrt(std::max(0.0, (sq - sum * sum / n) / (n - 1))) : 0.0;
+        r.min_ms = *std::min_element(r.samples_ms.begin(), r.samples_ms.end());
+        r.median_ms = percentile(r.samples_ms, 0.5);
+        r.p90_ms = percentile(r.samples_ms, 0.9);
+        r.throughput = r.median_ms > 0.0 ? items / (r.median_ms / 1000.0) : 0.0;
+
+        results_.push_back(r);
+        print(results_.back());
+        return results_.back();
+    }
+
+    static void printHeader() {
+        std::cout << std::left << std::setw(34) << "Benchmark" << std::right
+                  << std::setw(5) << "Thr"
+                  << std::setw(11) << "median ms"
+                  << std::setw(10) << "min ms"
+                  << std::setw(9) << "+/- %"
+                  << std::setw(16) << "throughput" << "\n";
+        std::cout << std::string(85, '-') << "\n";
+    }
+
+    static void print(const BenchResult& r) {
+        double rsd = r.mean_ms > 0.0 ? 100.0 * r.stddev_ms / r.mean_ms : 0.0;
+        std::cout << std::left << std::setw(34) << r.name << std::right
+                  << std::setw(5) << r.threads
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(11) << r.median_ms
+                  << std::setw(10) << r.min_ms
+                  << std::setprecision(1) << std::setw(9) << rsd
+                  << std::setprecision(0) << std::setw(16) << r.throughput << " " << r.unit << "/s\n";
+    }
+
+    const std::vector<BenchResult>& results() const { return results_; }
+
+    // Machine-readable report for regression tracking.
+    // 'sections' are extra top-level members whose values are already JSON.
+    bool writeJson(const std::string& path, const std::map<std::string, std::string>& context,
+                   const std::map<std::string, std::string>& sections = {}) const {
+        std::ofstream out(path);
+        if (!out) return false;
+        out << std::setprecision(10);
+        out << "{\n  \"context\": {";
+        bool first = true;
+        for (const auto& kv : context) {
+            out << (first ? "\n" : ",\n") << "    \"" << escape(kv.first) << "\": \"" << escape(kv.second) << "\"";
+            first = false;
+        }
+        out << "\n  },\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results_.size(); ++i) {
+            const BenchResult& r = results_[i];
+            out << (i ? ",\n" : "\n") << "    {\"name\": \"" << escape(r.name) << "\", \"threads\": " << r.threads
+                << ", \"items\": " << r.items << ", \"unit\": \"" << escape(r.unit) << "\""
+                << ", \"repetitions\": " << r.samples_ms.size()
+                << ", \"median_ms\": " << r.median_ms << ", \"mean_ms\": " << r.mean_ms
+                << ", \"min_ms\": " << r.min_ms << ", \"p90_ms\": " << r.p90_ms
+                << ", \"stddev_ms\": " << r.stddev_ms << ", \"throughput\": " << r.throughput;
+            for (const auto& kv : r.extra) out << ", \"" << escape(kv.first) << "\": " << kv.second;
+            out << "}";
+        }
+        out << "\n  ]";
+        for (const auto& kv : sections) out << ",\n  \"" << escape(kv.first) << "\": " << kv.second;
+        out << "\n}\n";
+        return true;
+    }
+
+    static std::string timestamp() {
+        std::time_t t = std::time(nullptr);
+        char buf[32];
+        std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", std::localtime(&t));
+        return buf;
+    }
+
+    static std::string compiler() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc " + std::to_string(_MSC_VER);
+#else
+        return "unknown";
+#endif
+    }
+};
+
+#endif // BENCHMARK_HARNESS_H
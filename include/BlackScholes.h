@@ -2,6 +2,7 @@
 #define BLACK_SCHOLES_H
 
 #include "EuropeanOption.h"
+#include "TermStructure.h"
 #include "Utils.h"
 #include <cmath>
 
@@ -13,10 +14,11 @@ private:
     double volatility_;    // Volatility (sigma)
     double maturity_;      // Time to maturity (T)
     OptionType type_;      // Call or Put
+    double dividend_;      // Continuous dividend yield (q)
     
     // Calculate d1 parameter
     double calculateD1() const {
-        return (std::log(spot_ / strike_) + (rate_ + 0.5 * volatility_ * volatility_) * maturity_) 
+        return (std::log(spot_ / strike_) + (rate_ - dividend_ + 0.5 * volatility_ * volatility_) * maturity_) 
                / (volatility_ * std::sqrt(maturity_));
     }
     
@@ -28,9 +30,13 @@ private:
 public:
     // Constructor
     BlackScholes(double spot, double strike, double rate, double volatility, 
-                 double maturity, OptionType type)
+                 double maturity, OptionType type, double dividend = 0.0)
         : spot_(spot), strike_(strike), rate_(rate), 
-          volatility_(volatility), maturity_(maturity), type_(type) {}
+          volatility_(volatility), maturity_(maturity), type_(type), dividend_(dividend) {}
+
+    // Constructor from an expiry's market context (curves and dividends already resolved)
+    BlackScholes(const ExpiryContext& ctx, double strike, double volatility, OptionType type)
+        : BlackScholes(ctx.spot, strike, ctx.rate, volatility, ctx.maturity, type, ctx.dividendYield) {}
     
     // Calculate option price using Black-Scholes formula
     double price() const {
@@ -38,37 +44,39 @@ public:
         double d2 = calculateD2();
         
         double discount_factor = std::exp(-rate_ * maturity_);
+        double carry_spot = spot_ * std::exp(-dividend_ * maturity_);
         
         if (type_ == OptionType::CALL) {
-            // Call price: S*N(d1) - K*e^(-rT)*N(d2)
-            return spot_ * normalCDF(d1) - strike_ * discount_factor * normalCDF(d2);
+            // Call price: S*e^(-qT)*N(d1) - K*e^(-rT)*N(d2)
+            return carry_spot * normalCDF(d1) - strike_ * discount_factor * normalCDF(d2);
         } else {
-            // Put price: K*e^(-rT)*N(-d2) - S*N(-d1)
-            return strike_ * discount_factor * normalCDF(-d2) - spot_ * normalCDF(-d1);
+            // Put price: K*e^(-rT)*N(-d2) - S*e^(-qT)*N(-d1)
+            return strike_ * discount_factor * normalCDF(-d2) - carry_spot * normalCDF(-d1);
         }
     }
     
     // Calculate Delta (∂V/∂S)
     double delta() const {
         double d1 = calculateD1();
+        double carry = std::exp(-dividend_ * maturity_);
         
         if (type_ == OptionType::CALL) {
-            return normalCDF(d1);
+            return carry * normalCDF(d1);
         } else {
-            return normalCDF(d1) - 1.0;
+            return carry * (normalCDF(d1) - 1.0);
         }
     }
     
     // Calculate Gamma (∂²V/∂S²)
     double gamma() const {
         double d1 = calculateD1();
-        return normalPDF(d1) / (spot_ * volatility_ * std::sqrt(maturity_));
+        return std::exp(-dividend_ * maturity_) * normalPDF(d1) / (spot_ * volatility_ * std::sqrt(maturity_));
     }
     
     // Calculate Vega (∂V/∂σ)
     double vega() const {
         double d1 = calculateD1();
-        return spot_ * normalPDF(d1) * std::sqrt(maturity_);
+        return spot_ * std::exp(-dividend_ * maturity_) * normalPDF(d1) * std::sqrt(maturity_);
     }
     
     // Calculate Theta (∂V/∂t)
@@ -76,14 +84,17 @@ public:
         double d1 = calculateD1();
         double d2 = calculateD2();
         
-        double term1 = -(spot_ * normalPDF(d1) * volatility_) / (2.0 * std::sqrt(maturity_));
+        double carry_spot = spot_ * std::exp(-dividend_ * maturity_);
+        double term1 = -(carry_spot * normalPDF(d1) * volatility_) / (2.0 * std::sqrt(maturity_));
         
         if (type_ == OptionType::CALL) {
             double term2 = rate_ * strike_ * std::exp(-rate_ * maturity_) * normalCDF(d2);
-            return term1 - term2;
+            double term3 = dividend_ * carry_spot * normalCDF(d1);
+            return term1 - term2 + term3;
         } else {
             double term2 = rate_ * strike_ * std::exp(-rate_ * maturity_) * normalCDF(-d2);
-            return term1 + term2;
+            double term3 = dividend_ * carry_spot * normalCDF(-d1);
+            return term1 + term2 - term3;
         }
     }
     
@@ -105,6 +116,7 @@ public:
     double getVolatility() const { return volatility_; }
     double getMaturity() const { return maturity_; }
     OptionType getType() const { return type_; }
+    double getDividend() const { return dividend_; }
 };
 
 #endif // BLACK_SCHOLES_H
\ No newline at end of file
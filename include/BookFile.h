@@ -0,0 +1,351 @@
+#ifndef BOOK_FILE_H
+#define BOOK_FILE_H
+
+#include "BatchPricer.h"
+#include "Option.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BOOK_FILE_HAS_MMAP 1
+#endif
+
+// Column-oriented binary file for option books and pricing results.
+//
+// Layout (little-endian):
+//   FileHeader | ColumnEntry x numColumns | column data (each column 64-byte aligned)
+//
+// Every column holds numRows x width values of a single type, so a mapped file can be
+// handed to BatchPricer without any copy. Scenario P&L is stored as one column of
+// width = number of scenarios (row-major: row i occupies [i*width, (i+1)*width)).
+//
+// Schema versions: 1 = original trade columns; 2 adds the optional dividend column.
+// Version 1 files are still read (they never carry dividends).
+namespace BookFile {
+
+const char MAGIC[8] = {'O', 'P', 'T', 'B', 'O', 'O', 'K', '\0'};
+const std::uint32_t VERSION = 2;
+const std::uint32_t MIN_VERSION = 1;
+const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+const std::size_t ALIGNMENT = 64;
+
+enum class DataType : std::uint32_t {
+    FLOAT64 = 1,
+    INT32 = 2
+};
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t numRows;
+    std::uint32_t numColumns;
+    std::uint32_t reserved;
+};
+
+struct ColumnEntry {
+    char name[24];
+    DataType type;
+    std::uint32_t width;   // Values per row
+    std::uint64_t offset;  // From the start of the file
+    std::uint64_t bytes;
+};
+
+static_assert(sizeof(FileHeader) == 32, "FileHeader layout");
+static_assert(sizeof(ColumnEntry) == 48, "ColumnEntry layout");
+static_assert(sizeof(OptionType) == sizeof(std::int32_t), "OptionType is stored as an INT32 column");
+
+// Standard column names used by the trade/market/result helpers
+namespace Columns {
+    const char* const SPOT = "spot";
+    const char* const STRIKE = "strike";
+    const char* const RATE = "rate";
+    const char* const VOLATILITY = "volatility";
+    const char* const MATURITY = "maturity";
+    const char* const TYPE = "type";
+    const char* const DIVIDEND = "dividend";   // Optional: absent = no dividends
+    const char* const PRICE = "price";
+    const char* const DELTA = "delta";
+    const char* const GAMMA = "gamma";
+    const char* const VEGA = "vega";
+    const char* const SCENARIO_PNL = "scenario_pnl";
+}
+
+// Non-owning view over one column
+template <typename T>
+struct ColumnView {
+    const T* data = nullptr;
+    std::size_t rows = 0;
+    std::size_t width = 1;
+
+    const T& operator[](std::size_t i) const { return data[i]; }
+    const T* row(std::size_t i) const { return data + i * width; }
+    bool empty() const { return data == nullptr; }
+};
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+class Writer {
+private:
+    struct PendingColumn {
+        std::string name;
+        DataType type;
+        std::uint32_t width;
+        const void* data;
+        std::size_t bytes;
+    };
+
+    std::uint64_t numRows_;
+    std::vector<PendingColumn> columns_;
+
+    static std::uint64_t alignUp(std::uint64_t x) {
+        return (x + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    void add(const std::string& name, DataType type, std::uint32_t width, const void* data, std::size_t elem_size) {
+        if (name.size() >= sizeof(ColumnEntry::name)) {
+            throw std::invalid_argument("BookFile: column name too long: " + name);
+        }
+        columns_.push_back({name, type, width, data, numRows_ * width * elem_size});
+    }
+
+public:
+    explicit Writer(std::size_t num_rows) : numRows_(num_rows) {}
+
+    // The data must stay alive until write() returns
+    void addColumn(const std::string& name, const double* data, std::uint32_t width = 1) {
+        add(name, DataType::FLOAT64, width, data, sizeof(double));
+    }
+
+    void addColumn(const std::string& name, const std::int32_t* data, std::uint32_t width = 1) {
+        add(name, DataType::INT32, width, data, sizeof(std::int32_t));
+    }
+
+    void addColumn(const std::string& name, const OptionType* data) {
+        add(name, DataType::INT32, 1, data, sizeof(std::int32_t));
+    }
+
+    // Trades and market data as the six standard columns, plus the dividend column when
+    // the batch has one
+    void addTrades(const OptionBatch& batch) {
+        if (batch.size != numRows_) throw std::invalid_argument("BookFile: batch size does not match row count");
+        addColumn(Columns::SPOT, batch.spot);
+        addColumn(Columns::STRIKE, batch.strike);
+        addColumn(Columns::RATE, batch.rate);
+        addColumn(Columns::VOLATILITY, batch.volatility);
+        addColumn(Columns::MATURITY, batch.maturity);
+        addColumn(Columns::TYPE, batch.type);
+        if (batch.dividend) addColumn(Columns::DIVIDEND, batch.dividend);
+    }
+
+    // Every non-null output of a batch run
+    void addResults(const GreeksBatch& results) {
+        if (results.price) addColumn(Columns::PRICE, results.price);
+        if (results.delta) addColumn(Columns::DELTA, results.delta);
+        if (results.gamma) addColumn(Columns::GAMMA, results.gamma);
+        if (results.vega) addColumn(Columns::VEGA, results.vega);
+    }
+
+    void write(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("BookFile: cannot open " + path + " for writing");
+
+        FileHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.byteOrder = BYTE_ORDER_MARK;
+        header.numRows = numRows_;
+        header.numColumns = static_cast<std::uint32_t>(columns_.size());
+
+        // Directory, with data offsets assigned on 64-byte boundaries
+        std::vector<ColumnEntry> entries(columns_.size());
+        std::uint64_t offset = alignUp(sizeof(FileHeader) + entries.size() * sizeof(ColumnEntry));
+        for (std::size_t c = 0; c < columns_.size(); ++c) {
+            ColumnEntry& e = entries[c];
+            std::memset(&e, 0, sizeof(e));
+            std::memcpy(e.name, columns_[c].name.c_str(), columns_[c].name.size());
+            e.type = columns_[c].type;
+            e.width = columns_[c].width;
+            e.offset = offset;
+            e.bytes = columns_[c].bytes;
+            offset = alignUp(offset + e.bytes);
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ColumnEntry));
+
+        const char zeros[ALIGNMENT] = {};
+        std::uint64_t pos = sizeof(FileHeader) + entries.size() * sizeof(ColumnEntry);
+        for (std::size_t c = 0; c < columns_.size(); ++c) {
+            out.write(zeros, entries[c].offset - pos);
+            out.write(static_cast<const char*>(columns_[c].data), columns_[c].bytes);
+            pos = entries[c].offset + entries[c].bytes;
+        }
+        if (!out) throw std::runtime_error("BookFile: write failed for " + path);
+    }
+};
+
+// ============================================================================
+// READER (memory-mapped, zero-copy)
+// ============================================================================
+
+class MappedFile {
+private:
+    const char* base_ = nullptr;
+    std::size_t size_ = 0;
+    std::vector<char> fallback_; // Used when mmap is not available
+    const FileHeader* header_ = nullptr;
+    const ColumnEntry* entries_ = nullptr;
+
+    void unmap() {
+#ifdef BOOK_FILE_HAS_MMAP
+        if (base_ && fallback_.empty()) munmap(const_cast<char*>(base_), size_);
+#endif
+        base_ = nullptr;
+        size_ = 0;
+        fallback_.clear();
+    }
+
+    void validate(const std::string& path) {
+        if (size_ < sizeof(FileHeader)) throw std::runtime_error("BookFile: truncated header in " + path);
+        header_ = reinterpret_cast<const FileHeader*>(base_);
+        if (std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error("BookFile: bad magic in " + path);
+        }
+        if (header_->byteOrder != BYTE_ORDER_MARK) {
+            throw std::runtime_error("BookFile: byte order mismatch in " + path);
+        }
+        if (header_->version < MIN_VERSION || header_->version > VERSION) {
+            throw std::runtime_error("BookFile: unsupported schema version " + std::to_string(header_->version));
+        }
+        std::size_t dir_end = sizeof(FileHeader) + static_cast<std::size_t>(header_->numColumns) * sizeof(ColumnEntry);
+        if (size_ < dir_end) throw std::runtime_error("BookFile: truncated column directory in " + path);
+        entries_ = reinterpret_cast<const ColumnEntry*>(base_ + sizeof(FileHeader));
+
+        // Every field is checked before it is used: names must end inside their slot and
+        // extents are compared without overflow, so a hostile file cannot make a read leave the mapping
+        for (std::uint32_t c = 0; c < header_->numColumns; ++c) {
+            const ColumnEntry& e = entries_[c];
+            if (std::memchr(e.name, '\0', sizeof(e.name)) == nullptr) {
+                throw std::runtime_error("BookFile: unterminated name of column " + std::to_string(c) + " in " + path);
+            }
+            if (e.type != DataType::FLOAT64 && e.type != DataType::INT32) {
+                throw std::runtime_error("BookFile: unknown type of column '" + std::string(e.name) + "' in " + path);
+            }
+            const std::uint64_t elem = (e.type == DataType::FLOAT64) ? sizeof(double) : sizeof(std::int32_t);
+            const std::uint64_t max_values = UINT64_MAX / elem;
+            const bool sized = e.width == 0 || header_->numRows <= max_values / e.width;
+            if (e.offset % ALIGNMENT != 0 || e.offset < dir_end || e.offset > size_ || e.bytes > size_ - e.offset ||
+                !sized || e.bytes != header_->numRows * e.width * elem) {
+                throw std::runtime_error("BookFile: corrupt column '" + std::string(e.name) + "' in " + path);
+            }
+        }
+    }
+
+    const ColumnEntry* find(const std::string& name, DataType type) const {
+        for (std::uint32_t c = 0; c < header_->numColumns; ++c) {
+            if (name == entries_[c].name) {
+                if (entries_[c].type != type) throw std::runtime_error("BookFile: column '" + name + "' has another type");
+                return &entries_[c];
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    ColumnView<T> view(const std::string& name, DataType type) const {
+        ColumnView<T> v;
+        const ColumnEntry* e = find(name, type);
+        if (e) {
+            v.data = reinterpret_cast<const T*>(base_ + e->offset);
+            v.rows = header_->numRows;
+            v.width = e->width;
+        }
+        return v;
+    }
+
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef BOOK_FILE_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("BookFile: cannot open " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("BookFile: cannot stat " + path);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        void* p = size_ > 0 ? mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (p == MAP_FAILED) throw std::runtime_error("BookFile: mmap failed for " + path);
+        base_ = static_cast<const char*>(p);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) throw std::runtime_error("BookFile: cannot open " + path);
+        fallback_.resize(static_cast<std::size_t>(in.tellg()));
+        in.seekg(0);
+        in.read(fallback_.data(), fallback_.size());
+        base_ = fallback_.data();
+        size_ = fallback_.size();
+#endif
+        try {
+            validate(path);
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    ~MappedFile() { unmap(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::size_t rows() const { return header_->numRows; }
+    std::uint32_t version() const { return header_->version; }
+    std::uint32_t numColumns() const { return header_->numColumns; }
+    std::string columnName(std::uint32_t c) const { return entries_[c].name; }
+    bool hasColumn(const std::string& name) const {
+        for (std::uint32_t c = 0; c < header_->numColumns; ++c) {
+            if (name == entries_[c].name) return true;
+        }
+        return false;
+    }
+
+    // Empty view when the column does not exist
+    ColumnView<double> doubles(const std::string& name) const { return view<double>(name, DataType::FLOAT64); }
+    ColumnView<std::int32_t> ints(const std::string& name) const { return view<std::int32_t>(name, DataType::INT32); }
+
+    // Zero-copy batch over the standard trade columns, ready for BatchPricer
+    OptionBatch optionBatch() const {
+        const char* required[] = {Columns::SPOT, Columns::STRIKE, Columns::RATE,
+                                  Columns::VOLATILITY, Columns::MATURITY, Columns::TYPE};
+        for (const char* name : required) {
+            if (!hasColumn(name)) throw std::runtime_error(std::string("BookFile: missing column '") + name + "'");
+        }
+        OptionBatch batch;
+        batch.size = rows();
+        batch.spot = doubles(Columns::SPOT).data;
+        batch.strike = doubles(Columns::STRIKE).data;
+        batch.rate = doubles(Columns::RATE).data;
+        batch.volatility = doubles(Columns::VOLATILITY).data;
+        batch.maturity = doubles(Columns::MATURITY).data;
+        batch.type = reinterpret_cast<const OptionType*>(ints(Columns::TYPE).data);
+        batch.dividend = doubles(Columns::DIVIDEND).data;   // nullptr when the book has none
+        return batch;
+    }
+};
+
+} // namespace BookFile
+
+#endif // BOOK_FILE_H
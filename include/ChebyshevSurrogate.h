@@ -0,0 +1,328 @@
+#ifndef CHEBYSHEV_SURROGATE_H
+#define CHEBYSHEV_SURROGATE_H
+
+#include "EuropeanOption.h"
+#include "Executor.h"
+#include "HestonMC.h"
+#include "Utils.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// One dimension of the interpolation box: [lo, hi] sampled on 'nodes' Chebyshev points
+// (polynomial degree nodes - 1 along this axis)
+struct ChebyshevAxis {
+    double lo;
+    double hi;
+    int nodes;
+};
+
+// Tensor-product Chebyshev interpolant of an expensive pricer.
+//
+// build() samples f on the Chebyshev points of the first kind of every axis (in parallel)
+// and turns the samples into Chebyshev coefficients with one discrete cosine transform
+// per axis. evaluate() contracts the coefficient tensor with T_k(x) of each axis: a few
+// multiply-adds per coefficient, no allocation, thread-safe.
+//
+// errorEstimate() is a heuristic, not a bound: the sum of |c| of the coefficients in the
+// two highest degrees of some axis. It tracks the truncation error only when the
+// coefficients decay geometrically (smooth inputs) and can badly underestimate it near
+// kinks or when the degree is too low to resolve the function. It also knows nothing about
+// noise in the sampled function: a surrogate of an MC pricer reproduces that pricer's
+// sampling error, whatever the tail says. validate() measures the actual error at random
+// points of the box against the original function and is the number to trust.
+class ChebyshevSurrogate {
+public:
+    static const int MAX_DIMS = 8;
+    static const int MAX_NODES = 64;
+
+private:
+    std::vector<ChebyshevAxis> axes_;
+    std::vector<double> coeffs_;      // Row-major, last axis fastest
+    double error_estimate_ = 0.0;
+
+    static constexpr double PI = 3.14159265358979323846;
+
+    std::size_t size() const {
+        std::size_t n = 1;
+        for (const ChebyshevAxis& a : axes_) n *= static_cast<std::size_t>(a.nodes);
+        return n;
+    }
+
+    // Chebyshev point j of the first kind on [-1, 1]
+    static double node(int j, int n) { return std::cos(PI * (j + 0.5) / n); }
+
+    void checkAxes() const {
+        if (axes_.empty() || axes_.size() > static_cast<std::size_t>(MAX_DIMS)) {
+            throw std::invalid_argument("ChebyshevSurrogate: between 1 and 8 axes");
+        }
+        for (const ChebyshevAxis& a : axes_) {
+            if (a.nodes < 2 || a.nodes > MAX_NODES || !(a.hi > a.lo)) {
+                throw std::invalid_argument("ChebyshevSurrogate: each axis needs 2 to 64 nodes and hi > lo");
+            }
+        }
+    }
+
+    // Values on the grid -> coefficients, one axis at a time (separable DCT-II)
+    void transform(std::vector<double>& values) {
+        std::vector<double> line, cosines;
+        std::size_t stride = 1;
+        for (int d = static_cast<int>(axes_.size()) - 1; d >= 0; --d) {
+            const int n = axes_[d].nodes;
+            const std::size_t block = stride * n;
+            line.resize(n);
+            cosines.resize(static_cast<std::size_t>(n) * n);
+            for (int k = 0; k < n; ++k) {
+                for (int j = 0; j < n; ++j) cosines[k * n + j] = std::cos(PI * k * (j + 0.5) / n);
+            }
+            for (std::size_t outer = 0; outer < values.size(); outer += block) {
+                for (std::size_t inner = 0; inner < stride; ++inner) {
+                    double* v = values.data() + outer + inner;
+                    for (int j = 0; j < n; ++j) line[j] = v[j * stride];
+                    for (int k = 0; k < n; ++k) {
+                        double c = 0.0;
+                        for (int j = 0; j < n; ++j) c += line[j] * cosines[k * n + j];
+                        v[k * stride] = c * (k == 0 ? 1.0 : 2.0) / n;
+                    }
+                }
+            }
+            stride = block;
+        }
+    }
+
+    // Sum of |c| over the coefficients in the top two degrees of some axis
+    double tailBound() const {
+        double tail = 0.0;
+        const std::size_t D = axes_.size();
+        std::vector<int> index(D, 0);
+        for (std::size_t i = 0; i < coeffs_.size(); ++i) {
+            std::size_t rest = i;
+            bool in_tail = false;
+            for (int d = static_cast<int>(D) - 1; d >= 0; --d) {
+                index[d] = static_cast<int>(rest % axes_[d].nodes);
+                rest /= axes_[d].nodes;
+                in_tail = in_tail || index[d] >= axes_[d].nodes - 2;
+            }
+            if (in_tail) tail += std::abs(coeffs_[i]);
+        }
+        return tail;
+    }
+
+public:
+    ChebyshevSurrogate() = default;
+
+    // Samples f(const double* x, int worker) on the tensor grid. The grid points are spread
+    // over the executor's workers; f must be safe to call concurrently for distinct workers.
+    template <typename F>
+    static ChebyshevSurrogate build(const std::vector<ChebyshevAxis>& axes, F&& f,
+                                    Executor& executor = defaultExecutor()) {
+        ChebyshevSurrogate s;
+        s.axes_ = axes;
+        s.checkAxes();
+        const std::size_t D = axes.size();
+        std::vector<double> values(s.size());
+
+        executor.parallelFor(values.size(), [&](std::size_t begin, std::size_t end, int worker) {
+            double x[MAX_DIMS];
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t rest = i;
+                for (int d = static_cast<int>(D) - 1; d >= 0; --d) {
+                    const ChebyshevAxis& a = axes[d];
+                    int j = static_cast<int>(rest % a.nodes);
+                    rest /= a.nodes;
+                    x[d] = 0.5 * (a.lo + a.hi) + 0.5 * (a.hi - a.lo) * node(j, a.nodes);
+                }
+                values[i] = f(static_cast<const double*>(x), worker);
+            }
+        });
+
+        s.transform(values);
+        s.coeffs_ = std::move(values);
+        s.error_estimate_ = s.tailBound();
+        return s;
+    }
+
+    // Interpolated value at x (one coordinate per axis, clamped to the box)
+    double evaluate(const double* x) const {
+        double T[MAX_DIMS][MAX_NODES];
+        for (std::size_t d = 0; d < axes_.size(); ++d) {
+            const ChebyshevAxis& a = axes_[d];
+            double t = (2.0 * x[d] - a.lo - a.hi) / (a.hi - a.lo);
+            t = std::min(1.0, std::max(-1.0, t));
+            T[d][0] = 1.0;
+            T[d][1] = t;
+            for (int k = 2; k < a.nodes; ++k) T[d][k] = 2.0 * t * T[d][k - 1] - T[d][k - 2];
+        }
+
+        // Rows along the last axis, walked with an odometer over the other axes; each row's
+        // dot product is weighted by the product of the other axes' T values
+        const int D = static_cast<int>(axes_.size());
+        const int last = axes_[D - 1].nodes;
+        const double* t_last = T[D - 1];
+        int index[MAX_DIMS] = {0};
+        double weight[MAX_DIMS + 1];
+        weight[0] = 1.0;
+        for (int d = 0; d < D - 1; ++d) weight[d + 1] = weight[d] * T[d][0];
+
+        const double* c = coeffs_.data();
+        double sum = 0.0;
+        for (;;) {
+            double dot = 0.0;
+            for (int i = 0; i < last; ++i) dot += c[i] * t_last[i];
+            sum += weight[D - 1] * dot;
+            c += last;
+
+            int d = D - 2;
+            while (d >= 0 && ++index[d] == axes_[d].nodes) index[d--] = 0;
+            if (d < 0) break;
+            for (int e = d; e < D - 1; ++e) weight[e + 1] = weight[e] * T[e][index[e]];
+        }
+        return sum;
+    }
+
+    double evaluate(std::initializer_list<double> x) const { return evaluate(x.begin()); }
+
+    // Largest |surrogate - f| over 'samples' uniform random points of the box
+    template <typename F>
+    double validate(F&& f, int samples, unsigned int seed = 7) const {
+        RandomGenerator rng(seed);
+        double x[MAX_DIMS];
+        double worst = 0.0;
+        for (int s = 0; s < samples; ++s) {
+            for (std::size_t d = 0; d < axes_.size(); ++d) {
+                x[d] = axes_[d].lo + (axes_[d].hi - axes_[d].lo) * rng.getUniform();
+            }
+            worst = std::max(worst, std::abs(evaluate(x) - f(static_cast<const double*>(x), 0)));
+        }
+        return worst;
+    }
+
+    // Tail-coefficient heuristic (see the class comment); not a guaranteed error bound
+    double errorEstimate() const { return error_estimate_; }
+    const std::vector<ChebyshevAxis>& axes() const { return axes_; }
+    const std::vector<double>& coefficients() const { return coeffs_; }
+    std::size_t dimensions() const { return axes_.size(); }
+
+    // --- SERIALISATION ---
+    // Layout: magic | version | dims | (lo, hi, nodes) per axis | error estimate | coefficients
+    void save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("ChebyshevSurrogate: cannot open " + path + " for writing");
+        const std::uint32_t version = 1;
+        const std::uint32_t dims = static_cast<std::uint32_t>(axes_.size());
+        out.write(MAGIC, sizeof(MAGIC));
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&dims), sizeof(dims));
+        for (const ChebyshevAxis& a : axes_) {
+            std::int32_t nodes = a.nodes;
+            out.write(reinterpret_cast<const char*>(&a.lo), sizeof(double));
+            out.write(reinterpret_cast<const char*>(&a.hi), sizeof(double));
+            out.write(reinterpret_cast<const char*>(&nodes), sizeof(nodes));
+        }
+        out.write(reinterpret_cast<const char*>(&error_estimate_), sizeof(double));
+        out.write(reinterpret_cast<const char*>(coeffs_.data()), coeffs_.size() * sizeof(double));
+        if (!out) throw std::runtime_error("ChebyshevSurrogate: write failed for " + path);
+    }
+
+    static ChebyshevSurrogate load(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("ChebyshevSurrogate: cannot open " + path);
+        char magic[sizeof(MAGIC)];
+        std::uint32_t version = 0, dims = 0;
+        in.read(magic, sizeof(magic));
+        in.read(reinterpret_cast<char*>(&version), sizeof(version));
+        in.read(reinterpret_cast<char*>(&dims), sizeof(dims));
+        if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error("ChebyshevSurrogate: bad magic in " + path);
+        }
+        if (version != 1) throw std::runtime_error("ChebyshevSurrogate: unsupported version in " + path);
+        if (dims == 0 || dims > static_cast<std::uint32_t>(MAX_DIMS)) {
+            throw std::runtime_error("ChebyshevSurrogate: corrupt header in " + path);
+        }
+
+        ChebyshevSurrogate s;
+        s.axes_.resize(dims);
+        for (ChebyshevAxis& a : s.axes_) {
+            std::int32_t nodes = 0;
+            in.read(reinterpret_cast<char*>(&a.lo), sizeof(double));
+            in.read(reinterpret_cast<char*>(&a.hi), sizeof(double));
+            in.read(reinterpret_cast<char*>(&nodes), sizeof(nodes));
+            a.nodes = nodes;
+        }
+        if (!in) throw std::runtime_error("ChebyshevSurrogate: truncated header in " + path);
+        s.checkAxes();
+        in.read(reinterpret_cast<char*>(&s.error_estimate_), sizeof(double));
+        s.coeffs_.resize(s.size());
+        in.read(reinterpret_cast<char*>(s.coeffs_.data()), s.coeffs_.size() * sizeof(double));
+        if (!in) throw std::runtime_error("ChebyshevSurrogate: truncated coefficients in " + path);
+        return s;
+    }
+
+private:
+    static constexpr char MAGIC[8] = {'C', 'H', 'E', 'B', 'S', 'U', 'R', 'R'};
+};
+
+// --- HESTON SURROGATE ---
+
+// Heston inputs a surrogate axis can move; everything else stays at the base point.
+// VOL moves the initial volatility (v0 = vol^2), as the dashboard's "BS Vol" slider does.
+enum class HestonInput { SPOT, STRIKE, RATE, VOL, KAPPA, THETA, XI, RHO, MATURITY };
+
+struct HestonPoint {
+    double spot = 100.0;
+    double strike = 100.0;
+    double rate = 0.05;
+    double vol = 0.2;
+    double kappa = 2.0;
+    double theta = 0.04;
+    double xi = 0.3;
+    double rho = -0.7;
+    double maturity = 1.0;
+
+    double& operator[](HestonInput input) {
+        switch (input) {
+            case HestonInput::SPOT: return spot;
+            case HestonInput::STRIKE: return strike;
+            case HestonInput::RATE: return rate;
+            case HestonInput::VOL: return vol;
+            case HestonInput::KAPPA: return kappa;
+            case HestonInput::THETA: return theta;
+            case HestonInput::XI: return xi;
+            case HestonInput::RHO: return rho;
+            default: return maturity;
+        }
+    }
+};
+
+struct HestonAxis {
+    HestonInput input;
+    ChebyshevAxis range;
+};
+
+// Heston price at a point, with one pricer run serially: every node sees the same draws
+// (common random numbers), so the sampled function is smooth in its inputs
+inline double hestonPointPrice(const HestonPoint& p, OptionType type, int paths, int steps) {
+    SerialExecutor serial;
+    HestonPricer heston(paths, steps, serial);
+    return heston.price(EuropeanOption(p.strike, p.maturity, type), p.spot, p.rate, p.vol * p.vol,
+                        p.kappa, p.theta, p.xi, p.rho);
+}
+
+// Surrogate of the Heston MC price over the given axes (in that order), other inputs at 'base'
+inline ChebyshevSurrogate buildHestonSurrogate(const HestonPoint& base, OptionType type,
+                                               const std::vector<HestonAxis>& axes, int paths, int steps,
+                                               Executor& executor = defaultExecutor()) {
+    std::vector<ChebyshevAxis> ranges;
+    for (const HestonAxis& a : axes) ranges.push_back(a.range);
+    return ChebyshevSurrogate::build(ranges, [&](const double* x, int) {
+        HestonPoint p = base;
+        for (std::size_t d = 0; d < axes.size(); ++d) p[axes[d].input] = x[d];
+        return hestonPointPrice(p, type, paths, steps);
+    }, executor);
+}
+
+#endif // CHEBYSHEV_SURROGATE_H
@@ -0,0 +1,347 @@
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Tuning.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Parallel algorithms need a backend library (TBB with libstdc++); the build defines
+// PRICING_PARALLEL_STL=1 when one was found.
+#ifndef PRICING_PARALLEL_STL
+#define PRICING_PARALLEL_STL 0
+#endif
+
+#if PRICING_PARALLEL_STL
+#include <execution>
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Non-owning reference to a range body (a lambda living on the caller's stack).
+// Unlike std::function it never allocates, which keeps steady-state pricing heap-free.
+class RangeBody {
+private:
+    const void* object_;
+    void (*call_)(const void*, std::size_t, std::size_t, int);
+
+public:
+    template <typename F>
+    RangeBody(const F& f)
+        : object_(&f),
+          call_([](const void* o, std::size_t begin, std::size_t end, int worker) {
+              (*static_cast<const F*>(o))(begin, end, worker);
+          }) {}
+
+    void operator()(std::size_t begin, std::size_t end, int worker) const { call_(object_, begin, end, worker); }
+};
+
+// Where the parallel loops of the pricers run.
+//
+// A kernel calls parallelFor(n, body): [0, n) is split into at most concurrency()
+// contiguous ranges and body(begin, end, worker) is called once per range, with
+// worker in [0, concurrency()). Kernels size their per-worker scratch (partial sums,
+// RNG streams) with concurrency(). The split is the same as OpenMP schedule(static),
+// so the same worker count gives the same ranges on every executor.
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    virtual int concurrency() const = 0;
+    virtual const char* name() const = 0;
+    virtual void parallelFor(std::size_t n, const RangeBody& body) = 0;
+
+    // Range of 'part' when [0, n) is split into 'parts' near-equal contiguous pieces
+    static void splitRange(std::size_t n, int parts, int part, std::size_t& begin, std::size_t& end) {
+        std::size_t chunk = n / parts;
+        std::size_t extra = n % parts;
+        std::size_t p = static_cast<std::size_t>(part);
+        begin = p * chunk + std::min(p, extra);
+        end = begin + chunk + (p < extra ? 1 : 0);
+    }
+};
+
+// Runs everything on the calling thread
+class SerialExecutor : public Executor {
+public:
+    int concurrency() const override { return 1; }
+    const char* name() const override { return "serial"; }
+    void parallelFor(std::size_t n, const RangeBody& body) override {
+        if (n > 0) body(0, n, 0);
+    }
+};
+
+// OpenMP team of 'threads' threads (0 = omp_get_max_threads()).
+// Inside an active parallel region the team has one thread, so nesting does not oversubscribe.
+// Without OpenMP it degrades to serial execution.
+class OpenMPExecutor : public Executor {
+private:
+    int threads_;
+
+public:
+    explicit OpenMPExecutor(int threads = 0) {
+#ifdef _OPENMP
+        threads_ = threads > 0 ? threads : omp_get_max_threads();
+#else
+        (void)threads;
+        threads_ = 1;
+#endif
+    }
+
+    int concurrency() const override { return threads_; }
+    const char* name() const override { return "openmp"; }
+
+    void parallelFor(std::size_t n, const RangeBody& body) override {
+        if (n == 0) return;
+#ifdef _OPENMP
+        #pragma omp parallel num_threads(threads_)
+        {
+            int worker = omp_get_thread_num();
+            std::size_t begin, end;
+            splitRange(n, omp_get_num_threads(), worker, begin, end);
+            if (begin < end) body(begin, end, worker);
+        }
+#else
+        body(0, n, 0);
+#endif
+    }
+};
+
+// C++17 parallel algorithms: one std::execution::par task per worker range.
+// Without a parallel backend (PRICING_PARALLEL_STL=0) it runs the ranges sequentially.
+class ParallelAlgorithmsExecutor : public Executor {
+private:
+    int workers_;
+
+public:
+    explicit ParallelAlgorithmsExecutor(int workers = 0)
+        : workers_(workers > 0 ? workers : std::max(1u, std::thread::hardware_concurrency())) {
+#if !PRICING_PARALLEL_STL
+        workers_ = 1;
+#endif
+    }
+
+    int concurrency() const override { return workers_; }
+    const char* name() const override { return "std::execution"; }
+
+    void parallelFor(std::size_t n, const RangeBody& body) override {
+        if (n == 0) return;
+        int parts = static_cast<int>(std::min<std::size_t>(n, workers_));
+        std::vector<int> ids(parts);
+        for (int i = 0; i < parts; ++i) ids[i] = i;
+        auto run = [&](int worker) {
+            std::size_t begin, end;
+            splitRange(n, parts, worker, begin, end);
+            body(begin, end, worker);
+        };
+#if PRICING_PARALLEL_STL
+        std::for_each(std::execution::par, ids.begin(), ids.end(), run);
+#else
+        std::for_each(ids.begin(), ids.end(), run);
+#endif
+    }
+};
+
+// Persistent pool of worker threads, optionally pinned to cores (worker i on the i-th CPU
+// of the NUMA-ordered list, so neighbouring ranges stay on one node).
+//
+// The calling thread takes range 0 and the workers the others, so a parallelFor costs
+// one wake-up instead of thread creation. Calls made from inside a running parallelFor
+// of the same pool (nested book/path parallelism), or while another thread is using
+// the pool, run inline on the caller: the pool never has more than concurrency()
+// threads busy. The inline run still goes through the same ranges with the same worker
+// indices, one after the other, so per-worker RNG streams (and hence prices) do not
+// depend on whether the pool was free.
+class ThreadPoolExecutor : public Executor {
+private:
+    int size_;
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::uint64_t generation_ = 0;
+    bool stopping_ = false;
+
+    // Current job (valid while remaining_ > 0)
+    const RangeBody* body_ = nullptr;
+    std::size_t n_ = 0;
+    int parts_ = 0;
+    int remaining_ = 0;
+    std::exception_ptr error_;
+
+    std::mutex submitMutex_;
+
+    static ThreadPoolExecutor*& activePool() {
+        thread_local ThreadPoolExecutor* pool = nullptr;
+        return pool;
+    }
+
+    // Runs one range, recording the first exception for the caller
+    void runPart(int part) {
+        std::size_t begin, end;
+        splitRange(n_, parts_, part, begin, end);
+        try {
+            if (begin < end) (*body_)(begin, end, part);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+    }
+
+    void workerLoop(int index) {
+        activePool() = this;
+        std::uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&]() { return stopping_ || generation_ != seen; });
+                if (stopping_) return;
+                seen = generation_;
+                if (index >= parts_) continue;
+            }
+            runPart(index);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--remaining_ == 0) done_.notify_one();
+        }
+    }
+
+public:
+    explicit ThreadPoolExecutor(int threads = 0, bool pinThreads = false)
+        : size_(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+        std::vector<int> cpus = pinThreads ? cpusByNumaNode() : std::vector<int>();
+        for (int i = 1; i < size_; ++i) {
+            workers_.emplace_back(&ThreadPoolExecutor::workerLoop, this, i);
+            if (!cpus.empty()) pinThread(workers_.back(), cpus[i % cpus.size()]);
+        }
+    }
+
+    ~ThreadPoolExecutor() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& t : workers_) t.join();
+    }
+
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    int concurrency() const override { return size_; }
+    const char* name() const override { return "thread-pool"; }
+
+    void parallelFor(std::size_t n, const RangeBody& body) override {
+        if (n == 0) return;
+        std::unique_lock<std::mutex> submit(submitMutex_, std::try_to_lock);
+        const int parts = static_cast<int>(std::min<std::size_t>(n, size_));
+        if (parts == 1 || activePool() == this || !submit.owns_lock()) {
+            for (int part = 0; part < parts; ++part) {
+                std::size_t begin, end;
+                splitRange(n, parts, part, begin, end);
+                body(begin, end, part);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            body_ = &body;
+            n_ = n;
+            parts_ = parts;
+            remaining_ = parts_ - 1;
+            error_ = nullptr;
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        ThreadPoolExecutor* previous = activePool();
+        activePool() = this;
+        runPart(0);
+        activePool() = previous;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [&]() { return remaining_ == 0; });
+        body_ = nullptr;
+        if (error_) std::rethrow_exception(error_);
+    }
+
+    // --- CPU TOPOLOGY (Linux) ---
+
+    // Online CPUs ordered node by node, so consecutive workers share a NUMA node
+    static std::vector<int> cpusByNumaNode() {
+        std::vector<int> cpus;
+#if defined(__linux__)
+        for (int node = 0; node < 1024; ++node) {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!in) {
+                if (node == 0) break;
+                continue;
+            }
+            std::string list;
+            std::getline(in, list);
+            std::size_t pos = 0;
+            while (pos < list.size()) {
+                std::size_t comma = list.find(',', pos);
+                std::string item = list.substr(pos, comma - pos);
+                std::size_t dash = item.find('-');
+                int lo = std::stoi(item);
+                int hi = (dash == std::string::npos) ? lo : std::stoi(item.substr(dash + 1));
+                for (int c = lo; c <= hi; ++c) cpus.push_back(c);
+                pos = (comma == std::string::npos) ? list.size() : comma + 1;
+            }
+        }
+        if (cpus.empty()) {
+            unsigned int hw = std::thread::hardware_concurrency();
+            for (unsigned int c = 0; c < hw; ++c) cpus.push_back(static_cast<int>(c));
+        }
+#endif
+        return cpus;
+    }
+
+    static bool pinThread(std::thread& t, int cpu) {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(t.native_handle(), sizeof(set), &set) == 0;
+#else
+        (void)t; (void)cpu;
+        return false;
+#endif
+    }
+};
+
+// Executor used by pricers that were not given one: OpenMP when available, else a shared pool.
+// Kind, thread count and pinning come from the machine's tuning file when it has one.
+inline Executor& defaultExecutor() {
+    static Executor& executor = []() -> Executor& {
+        const TuningConfig& tuning = machineTuning();
+#ifdef _OPENMP
+        if (tuning.executor == "openmp") {
+            static OpenMPExecutor team(tuning.threads);
+            return team;
+        }
+#endif
+        static ThreadPoolExecutor pool(tuning.threads, tuning.pinThreads);
+        return pool;
+    }();
+    return executor;
+}
+
+#endif // EXECUTOR_H
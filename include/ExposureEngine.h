@@ -0,0 +1,593 @@
+#ifndef EXPOSURE_ENGINE_H
+#define EXPOSURE_ENGINE_H
+
+#include "Arena.h"
+#include "BatchPricer.h"
+#include "BlackScholes.h"
+#include "Executor.h"
+#include "Instrumentation.h"
+#include "JumpDiffusion.h"
+#include "MultiAssetMC.h"
+#include "OptionBook.h"
+#include "QuantileSketch.h"
+#include "TermStructure.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Exposure of a book on a date grid. Values are in time-t money (not discounted to today)
+// and the whole book is one netting set: exposure is max(V(t), 0).
+struct ExposureProfile {
+    std::vector<double> dates;
+    std::vector<double> expectedValue;              // E[V(t)]
+    std::vector<double> expectedExposure;           // EE(t)  = E[max(V(t), 0)]
+    std::vector<double> expectedNegativeExposure;   // ENE(t) = E[max(-V(t), 0)]
+    std::vector<double> pfe;                        // PFE(t) at 'quantile'
+    std::vector<QuantileSketch> distributions;      // Distribution of max(V(t), 0), any quantile
+    double quantile = 0.95;
+    int paths = 0;
+
+    double pfeAt(std::size_t date, double q) const { return distributions[date].quantile(q); }
+
+    // Time average of EE over the grid (EPE)
+    double expectedPositiveExposure() const {
+        double area = 0.0, previous = 0.0;
+        for (std::size_t j = 0; j < dates.size(); ++j) {
+            area += expectedExposure[j] * (dates[j] - previous);
+            previous = dates[j];
+        }
+        return dates.empty() ? 0.0 : area / dates.back();
+    }
+};
+
+// Exposure profiles of an OptionBook by simulation of outer market paths, without nested
+// simulation.
+//
+// Each underlying is one risk factor, simulated as GBM at its volatility, or Heston when it
+// carries Heston/Bates trades; Merton jumps are added when it carries Merton/Bates trades.
+// Underlyings share a uniform correlation through a common factor.
+// At each date every live trade is revalued along the path:
+//   - Black-Scholes and Merton trades in closed form (BatchPricer kernel, Merton series);
+//   - Heston and Bates trades by a regression proxy: a polynomial in (log-spot, variance)
+//     plus a Black-Scholes control at the expected average variance, fitted by least
+//     squares to the discounted payoffs of separate pilot paths (Longstaff-Schwartz style),
+//     one set of coefficients per trade and date.
+// Paths run in fixed blocks, each with its own counter-based stream, on the executor.
+// Per-date sums and quantile sketches are accumulated per worker and merged, so memory does
+// not grow with the path count and results do not depend on the thread count (a sketch
+// does not depend on how its values were split and merged, even once low buckets are
+// folded; sums agree to rounding).
+class ExposureEngine {
+public:
+    static constexpr int MAX_BASIS = 10;
+
+private:
+    // One simulated underlying
+    struct Factor {
+        double spot = 0.0;
+        double volatility = 0.0;
+        HestonParams heston;
+        JumpParams jumps;
+        YieldCurve dividendYield;
+        bool stochasticVol = false;
+        bool hasJumps = false;
+        bool needsRegression = false;
+        int basis = 5;            // Size of the polynomial part of the regression basis
+    };
+
+    // A trade resolved against its factor
+    struct Position {
+        std::size_t factor;
+        Trade trade;
+        bool regression;
+    };
+
+    int num_paths_;
+    int regression_paths_ = 20000;
+    int steps_per_year_ = 52;
+    int block_size_ = 256;
+    double quantile_ = 0.95;
+    double correlation_ = 0.0;
+    double sketch_accuracy_ = 0.005;
+    bool analytic_ = true;
+    std::uint64_t seed_ = 42;
+    Executor* executor_;
+    WorkspacePool workspaces_;
+
+    // Per-run state
+    std::vector<Factor> factors_;
+    std::vector<Position> positions_;
+    std::vector<double> dates_;
+    YieldCurve rates_;
+    std::vector<double> pos_rate_;        // positions x dates: forward rate to maturity
+    std::vector<double> pos_dividend_;    // positions x dates: forward dividend yield
+    std::vector<double> coefficients_;    // positions x dates x MAX_BASIS
+
+    // --- DYNAMICS ---
+
+    // Regression basis at log-spot x (relative to today) and variance v
+    static void basis(const Factor& f, double x, double v, double* phi) {
+        double x2 = x * x;
+        phi[0] = 1.0;
+        phi[1] = x;
+        phi[2] = x2;
+        phi[3] = x2 * x;
+        phi[4] = x2 * x2;
+        if (f.stochasticVol) {
+            phi[5] = v;
+            phi[6] = x * v;
+            phi[7] = x2 * v;
+            phi[8] = v * v;
+        }
+    }
+
+    // Risk-neutral drift of the log-spot over [t0, t1] (before the -v/2 term)
+    double drift(const Factor& f, double t0, double t1) const {
+        double mu = rates_.forwardRate(t0, t1) - f.dividendYield.forwardRate(t0, t1);
+        if (f.hasJumps) mu -= f.jumps.intensity * f.jumps.meanJump();
+        return mu;
+    }
+
+    // Advances one path of factor f by dt; z is its (already correlated) spot shock
+    static void advance(const Factor& f, double mu, double dt, double sqrt_dt, double z,
+                        CounterRNG& rng, double& x, double& v) {
+        if (f.stochasticVol) {
+            const HestonParams& h = f.heston;
+            double vp = std::max(v, 0.0);
+            double sv = std::sqrt(vp) * sqrt_dt;
+            double zv = h.rho * z + std::sqrt(1.0 - h.rho * h.rho) * rng.getNormal();
+            x += (mu - 0.5 * vp) * dt + sv * z;
+            v += h.kappa * (h.theta - vp) * dt + h.xi * sv * zv;
+        } else {
+            x += (mu - 0.5 * f.volatility * f.volatility) * dt + f.volatility * sqrt_dt * z;
+        }
+        if (f.hasJumps) {
+            // Poisson count by inversion of a uniform (Phi of a normal draw)
+            double u = normalCDF(rng.getNormal());
+            double mean = f.jumps.intensity * dt;
+            double p = std::exp(-mean), cdf = p;
+            int n = 0;
+            while (u > cdf && n < 64) {
+                ++n;
+                p *= mean / n;
+                cdf += p;
+            }
+            if (n > 0) x += n * f.jumps.mean + std::sqrt(static_cast<double>(n)) * f.jumps.stddev * rng.getNormal();
+        }
+    }
+
+    // Steps over [t0, t1]: GBM (with or without jumps) is exact in one step, Heston is not
+    int stepsBetween(double t0, double t1, bool stochastic) const {
+        if (!stochastic) return 1;
+        return std::max(1, static_cast<int>(std::ceil((t1 - t0) * steps_per_year_ - 1e-9)));
+    }
+
+    // --- VALUATION ---
+
+    static double payoff(const Trade& t, double spot) {
+        return t.type == OptionType::CALL ? std::max(spot - t.strike, 0.0) : std::max(t.strike - spot, 0.0);
+    }
+
+    // Least-squares coefficients from accumulated normal equations, with the columns scaled
+    // to a unit diagonal (the raw powers of x and v differ by orders of magnitude)
+    static void solveNormalEquations(int n, const double* A, const double* b, double* beta) {
+        std::vector<double> scale(n), M(static_cast<std::size_t>(n) * n), L;
+        for (int i = 0; i < n; ++i) scale[i] = A[i * n + i] > 0.0 ? 1.0 / std::sqrt(A[i * n + i]) : 0.0;
+        for (double ridge = 1e-12; ridge < 1.0; ridge *= 100.0) {
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) M[i * n + j] = scale[i] * A[i * n + j] * scale[j] + (i == j ? ridge : 0.0);
+            }
+            if (choleskyFactor(M, n, L)) break;
+        }
+        std::vector<double> y(n);
+        for (int i = 0; i < n; ++i) {
+            double s = scale[i] * b[i];
+            for (int k = 0; k < i; ++k) s -= L[i * n + k] * y[k];
+            y[i] = s / L[i * n + i];
+        }
+        for (int i = n - 1; i >= 0; --i) {
+            double s = y[i];
+            for (int k = i + 1; k < n; ++k) s -= L[k * n + i] * beta[k];
+            beta[i] = s / L[i * n + i];
+        }
+        for (int i = 0; i < n; ++i) beta[i] *= scale[i];
+    }
+
+    // Control regressor of a position: Black-Scholes at the path's state, with the expected
+    // average variance to maturity under Heston and the jump variance added under Merton/Bates.
+    // It carries the kink of the payoff, which the polynomial part cannot fit near expiry.
+    static double controlValue(const Factor& f, const Trade& t, double spot, double v, double tau,
+                               double rate, double dividend) {
+        double var = f.volatility * f.volatility;
+        if (f.stochasticVol) {
+            const HestonParams& h = f.heston;
+            double kt = h.kappa * tau;
+            double w = kt > 1e-8 ? -std::expm1(-kt) / kt : 1.0;
+            var = h.theta + (std::max(v, 0.0) - h.theta) * w;
+        }
+        if (f.hasJumps) var += f.jumps.intensity * (f.jumps.mean * f.jumps.mean + f.jumps.stddev * f.jumps.stddev);
+        return BlackScholes(spot, t.strike, rate, std::sqrt(std::max(var, 1e-8)), tau, t.type, dividend).price();
+    }
+
+    // Pilot simulation of one factor: accumulates, per regression position and date, the
+    // normal equations of the discounted payoff on the basis (polynomial + control), then
+    // solves them
+    void fitRegressions(std::size_t fi) {
+        const Factor& f = factors_[fi];
+        const std::size_t D = dates_.size();
+        const int np = f.basis;          // Polynomial part
+        const int nb = np + 1;           // + control regressor
+        std::vector<std::size_t> owned;
+        double horizon = 0.0;
+        for (std::size_t p = 0; p < positions_.size(); ++p) {
+            if (positions_[p].factor == fi && positions_[p].regression) {
+                owned.push_back(p);
+                horizon = std::max(horizon, positions_[p].trade.maturity);
+            }
+        }
+
+        // Event times: dates before the last maturity, then the maturities themselves
+        std::vector<double> times;
+        for (double t : dates_) if (t < horizon) times.push_back(t);
+        for (std::size_t p : owned) times.push_back(positions_[p].trade.maturity);
+        std::sort(times.begin(), times.end());
+        times.erase(std::unique(times.begin(), times.end()), times.end());
+
+        const int B = block_size_;
+        const std::size_t blocks = (static_cast<std::size_t>(regression_paths_) + B - 1) / B;
+        const int workers = executor_->concurrency();
+        const std::size_t a_size = owned.size() * D * nb * nb, b_size = owned.size() * D * nb;
+        std::vector<std::vector<double>> A(workers, std::vector<double>(a_size, 0.0));
+        std::vector<std::vector<double>> rhs(workers, std::vector<double>(b_size, 0.0));
+        workspaces_.prepare(workers);
+
+        executor_->parallelFor(blocks, [&](std::size_t begin, std::size_t end, int worker) {
+            Arena& arena = workspaces_.arena(worker);
+            double* x = arena.allocate<double>(B);
+            double* v = arena.allocate<double>(B);
+            double* pay = arena.allocate<double>(B);
+            double* phi = arena.allocate<double>(D * np * B);                 // [date][basis][path]
+            double* control = arena.allocate<double>(owned.size() * D * B);   // [position][date][path]
+            double* a = A[worker].data();
+            double* r = rhs[worker].data();
+
+            for (std::size_t block = begin; block < end; ++block) {
+                const int n = static_cast<int>(std::min<std::size_t>(B, regression_paths_ - block * B));
+                CounterRNG rng(seed_, ((static_cast<std::uint64_t>(fi) + 1) << 32) + block);
+                for (int i = 0; i < n; ++i) {
+                    x[i] = 0.0;
+                    v[i] = f.heston.v0;
+                }
+                std::size_t date = 0;
+                double t = 0.0;
+                for (double t1 : times) {
+                    int steps = stepsBetween(t, t1, f.stochasticVol);
+                    double dt = (t1 - t) / steps, sqrt_dt = std::sqrt(dt), mu = drift(f, t, t1);
+                    for (int s = 0; s < steps; ++s) {
+                        for (int i = 0; i < n; ++i) advance(f, mu, dt, sqrt_dt, rng.getNormal(), rng, x[i], v[i]);
+                    }
+                    t = t1;
+
+                    // Regressors at a date
+                    if (date < D && dates_[date] == t1) {
+                        double* slab = phi + date * np * B;
+                        for (int i = 0; i < n; ++i) {
+                            double row[MAX_BASIS];
+                            basis(f, x[i], v[i], row);
+                            for (int k = 0; k < np; ++k) slab[k * B + i] = row[k];
+                        }
+                        for (std::size_t o = 0; o < owned.size(); ++o) {
+                            std::size_t p = owned[o];
+                            const Trade& trade = positions_[p].trade;
+                            if (trade.maturity <= t1) continue;
+                            double* c = control + (o * D + date) * B;
+                            for (int i = 0; i < n; ++i) {
+                                c[i] = controlValue(f, trade, f.spot * std::exp(x[i]), v[i], trade.maturity - t1,
+                                                    pos_rate_[p * D + date], pos_dividend_[p * D + date]);
+                            }
+                        }
+                        ++date;
+                    }
+
+                    // Payoffs at a maturity, regressed on the regressors of every earlier date
+                    for (std::size_t o = 0; o < owned.size(); ++o) {
+                        const std::size_t p = owned[o];
+                        const Trade& trade = positions_[p].trade;
+                        if (trade.maturity != t1) continue;
+                        for (int i = 0; i < n; ++i) pay[i] = payoff(trade, f.spot * std::exp(x[i]));
+                        for (std::size_t j = 0; j < date && dates_[j] < t1; ++j) {
+                            double df = std::exp(-pos_rate_[p * D + j] * (t1 - dates_[j]));
+                            const double* slab = phi + j * np * B;
+                            const double* c = control + (o * D + j) * B;
+                            double* aj = a + (o * D + j) * nb * nb;
+                            double* rj = r + (o * D + j) * nb;
+                            for (int i = 0; i < n; ++i) {
+                                double row[MAX_BASIS];
+                                for (int k = 0; k < np; ++k) row[k] = slab[k * B + i];
+                                row[np] = c[i];
+                                double y = df * pay[i];
+                                for (int k = 0; k < nb; ++k) {
+                                    rj[k] += row[k] * y;
+                                    for (int l = 0; l < nb; ++l) aj[k * nb + l] += row[k] * row[l];
+                                }
+                            }
+                        }
+                    }
+                }
+                PERF_COUNT(PATHS, n);
+            }
+        });
+
+        for (int w = 1; w < workers; ++w) {
+            for (std::size_t i = 0; i < a_size; ++i) A[0][i] += A[w][i];
+            for (std::size_t i = 0; i < b_size; ++i) rhs[0][i] += rhs[w][i];
+        }
+        for (std::size_t o = 0; o < owned.size(); ++o) {
+            for (std::size_t j = 0; j < D && dates_[j] < positions_[owned[o]].trade.maturity; ++j) {
+                solveNormalEquations(nb, A[0].data() + (o * D + j) * nb * nb, rhs[0].data() + (o * D + j) * nb,
+                                     coefficients_.data() + (owned[o] * D + j) * MAX_BASIS);
+            }
+        }
+    }
+
+    // Resolves the book into factors and positions for the given grid
+    void setup(const OptionBook& book, const std::vector<double>& dates) {
+        if (dates.empty()) throw std::invalid_argument("ExposureEngine: empty date grid");
+        for (std::size_t j = 0; j < dates.size(); ++j) {
+            if (dates[j] <= 0.0 || (j > 0 && dates[j] <= dates[j - 1])) {
+                throw std::invalid_argument("ExposureEngine: dates must be positive and increasing");
+            }
+        }
+        dates_ = dates;
+        rates_ = book.getYieldCurve();
+        factors_.clear();
+        positions_.clear();
+
+        std::vector<std::string> names;
+        for (std::size_t id = 0; id < book.size(); ++id) {
+            const Trade& t = book.trade(id);
+            std::size_t fi = std::find(names.begin(), names.end(), t.underlying) - names.begin();
+            if (fi == names.size()) {
+                const DividendCurve& dividends = book.getDividends(t.underlying);
+                if (!dividends.cash().empty()) {
+                    throw std::invalid_argument("ExposureEngine: cash dividends on '" + t.underlying + "' are not supported");
+                }
+                Factor f;
+                f.spot = book.getSpot(t.underlying);
+                f.volatility = book.getVolatility(t.underlying);
+                f.heston = book.getHestonParams(t.underlying);
+                f.jumps = book.getJumpParams(t.underlying);
+                f.dividendYield = dividends.yieldCurve();
+                names.push_back(t.underlying);
+                factors_.push_back(f);
+            }
+            Factor& f = factors_[fi];
+            if (t.model == PricingModel::HESTON || t.model == PricingModel::BATES) f.stochasticVol = true;
+            if ((t.model == PricingModel::MERTON || t.model == PricingModel::BATES) && f.jumps.active()) f.hasJumps = true;
+            bool regression = !analytic_ || t.model == PricingModel::HESTON || t.model == PricingModel::BATES;
+            f.needsRegression = f.needsRegression || regression;
+            positions_.push_back({fi, t, regression});
+        }
+        for (Factor& f : factors_) f.basis = f.stochasticVol ? 9 : 5;
+
+        const std::size_t D = dates_.size();
+        pos_rate_.assign(positions_.size() * D, 0.0);
+        pos_dividend_.assign(positions_.size() * D, 0.0);
+        coefficients_.assign(positions_.size() * D * MAX_BASIS, 0.0);
+        for (std::size_t p = 0; p < positions_.size(); ++p) {
+            const double T = positions_[p].trade.maturity;
+            for (std::size_t j = 0; j < D && dates_[j] < T; ++j) {
+                pos_rate_[p * D + j] = rates_.forwardRate(dates_[j], T);
+                pos_dividend_[p * D + j] = factors_[positions_[p].factor].dividendYield.forwardRate(dates_[j], T);
+            }
+        }
+    }
+
+public:
+    explicit ExposureEngine(int num_paths = 10000, Executor& executor = defaultExecutor())
+        : num_paths_(num_paths), executor_(&executor) {}
+
+    void setExecutor(Executor& executor) { executor_ = &executor; }
+    void setPaths(int paths) { num_paths_ = std::max(1, paths); }
+    void setRegressionPaths(int paths) { regression_paths_ = std::max(1, paths); }
+    void setStepsPerYear(int steps) { steps_per_year_ = std::max(1, steps); }
+    void setBlockSize(int paths) { block_size_ = std::max(1, paths); }
+    void setQuantile(double q) { quantile_ = q; }
+    void setSketchAccuracy(double accuracy) { sketch_accuracy_ = accuracy; }
+    void setSeed(std::uint64_t seed) { seed_ = seed; }
+
+    // Uniform correlation of the underlyings' spot shocks (one common factor)
+    void setCorrelation(double rho) {
+        if (rho < 0.0 || rho >= 1.0) throw std::invalid_argument("ExposureEngine: correlation must be in [0, 1)");
+        correlation_ = rho;
+    }
+
+    // false: every trade uses the regression proxy (to validate the proxies against the
+    // closed forms)
+    void setAnalyticValuation(bool analytic) { analytic_ = analytic; }
+
+    // Regression coefficients of position p (book order) at date j, after profile()
+    const double* regressionCoefficients(std::size_t p, std::size_t j) const {
+        return coefficients_.data() + (p * dates_.size() + j) * MAX_BASIS;
+    }
+
+    ExposureProfile profile(const OptionBook& book, const std::vector<double>& dates) {
+        setup(book, dates);
+        for (std::size_t fi = 0; fi < factors_.size(); ++fi) {
+            if (factors_[fi].needsRegression) fitRegressions(fi);
+        }
+
+        const std::size_t D = dates_.size();
+        const std::size_t F = factors_.size();
+        const int B = block_size_;
+        const std::size_t blocks = (static_cast<std::size_t>(num_paths_) + B - 1) / B;
+        const int workers = executor_->concurrency();
+        bool stochastic = false;
+        for (const Factor& f : factors_) stochastic = stochastic || f.stochasticVol;
+        const double common = std::sqrt(correlation_), own = std::sqrt(1.0 - correlation_);
+
+        struct Accumulator {
+            std::vector<NeumaierSum> value, positive, negative;
+            std::vector<QuantileSketch> sketches;
+        };
+        std::vector<Accumulator> acc(workers);
+        for (Accumulator& a : acc) {
+            a.value.assign(D, NeumaierSum());
+            a.positive.assign(D, NeumaierSum());
+            a.negative.assign(D, NeumaierSum());
+            a.sketches.assign(D, QuantileSketch(sketch_accuracy_));
+        }
+        workspaces_.prepare(workers);
+
+        executor_->parallelFor(blocks, [&](std::size_t begin, std::size_t end, int worker) {
+            Arena& arena = workspaces_.arena(worker);
+            double* x = arena.allocate<double>(F * B);
+            double* v = arena.allocate<double>(F * B);
+            double* S = arena.allocate<double>(F * B);
+            double* phi = arena.allocate<double>(F * MAX_BASIS * B);   // [factor][basis][path]
+            double* value = arena.allocate<double>(B);
+            double* price = arena.allocate<double>(B);
+            double* col = arena.allocate<double>(5 * B);               // strike, rate, vol, tau, dividend
+            OptionType* types = arena.allocate<OptionType>(B);
+            double* mu = arena.allocate<double>(F);
+            Accumulator& a = acc[worker];
+
+            for (std::size_t block = begin; block < end; ++block) {
+                const int n = static_cast<int>(std::min<std::size_t>(B, num_paths_ - block * B));
+                CounterRNG rng(seed_, block);
+                for (std::size_t fi = 0; fi < F; ++fi) {
+                    for (int i = 0; i < n; ++i) {
+                        x[fi * B + i] = 0.0;
+                        v[fi * B + i] = factors_[fi].heston.v0;
+                    }
+                }
+
+                double t = 0.0;
+                for (std::size_t j = 0; j < D; ++j) {
+                    // 1. Evolve every factor to the date
+                    const double t1 = dates_[j];
+                    const int steps = stepsBetween(t, t1, stochastic);
+                    const double dt = (t1 - t) / steps, sqrt_dt = std::sqrt(dt);
+                    for (std::size_t fi = 0; fi < F; ++fi) mu[fi] = drift(factors_[fi], t, t1);
+                    for (int s = 0; s < steps; ++s) {
+                        for (int i = 0; i < n; ++i) {
+                            double m = (F > 1 && correlation_ > 0.0) ? rng.getNormal() : 0.0;
+                            for (std::size_t fi = 0; fi < F; ++fi) {
+                                double z = common * m + own * rng.getNormal();
+                                advance(factors_[fi], mu[fi], dt, sqrt_dt, z, rng, x[fi * B + i], v[fi * B + i]);
+                            }
+                        }
+                    }
+                    t = t1;
+
+                    for (std::size_t fi = 0; fi < F; ++fi) {
+                        const Factor& f = factors_[fi];
+                        for (int i = 0; i < n; ++i) S[fi * B + i] = f.spot * std::exp(x[fi * B + i]);
+                        if (!f.needsRegression) continue;
+                        double* slab = phi + fi * MAX_BASIS * B;
+                        for (int i = 0; i < n; ++i) {
+                            double row[MAX_BASIS];
+                            basis(f, x[fi * B + i], v[fi * B + i], row);
+                            for (int k = 0; k < f.basis; ++k) slab[k * B + i] = row[k];
+                        }
+                    }
+
+                    // 2. Revalue every live position along the paths
+                    std::fill(value, value + n, 0.0);
+                    for (std::size_t p = 0; p < positions_.size(); ++p) {
+                        const Position& pos = positions_[p];
+                        const Trade& trade = pos.trade;
+                        if (trade.maturity <= t1) continue;
+                        const Factor& f = factors_[pos.factor];
+                        const double* spots = S + pos.factor * B;
+
+                        if (pos.regression) {
+                            const double* beta = coefficients_.data() + (p * D + j) * MAX_BASIS;
+                            const double* slab = phi + pos.factor * MAX_BASIS * B;
+                            const double* vars = v + pos.factor * B;
+                            const double tau = trade.maturity - t1;
+                            for (int i = 0; i < n; ++i) {
+                                price[i] = beta[f.basis] * controlValue(f, trade, spots[i], vars[i], tau,
+                                                                        pos_rate_[p * D + j], pos_dividend_[p * D + j]);
+                            }
+                            for (int k = 0; k < f.basis; ++k) {
+                                for (int i = 0; i < n; ++i) price[i] += beta[k] * slab[k * B + i];
+                            }
+                            // A European option is worth at least nothing
+                            for (int i = 0; i < n; ++i) price[i] = std::max(price[i], 0.0);
+                        } else if (trade.model == PricingModel::MERTON) {
+                            ExpiryContext ctx;
+                            ctx.maturity = trade.maturity - t1;
+                            ctx.rate = pos_rate_[p * D + j];
+                            ctx.dividendYield = pos_dividend_[p * D + j];
+                            for (int i = 0; i < n; ++i) {
+                                ctx.spot = spots[i];
+                                price[i] = MertonJumpDiffusion(ctx, trade.strike, f.volatility, trade.type, f.jumps).price();
+                            }
+                        } else {
+                            double* strike = col;
+                            double* rate = col + B;
+                            double* vol = col + 2 * B;
+                            double* tau = col + 3 * B;
+                            double* dividend = col + 4 * B;
+                            std::fill(strike, strike + n, trade.strike);
+                            std::fill(rate, rate + n, pos_rate_[p * D + j]);
+                            std::fill(vol, vol + n, f.volatility);
+                            std::fill(tau, tau + n, trade.maturity - t1);
+                            std::fill(dividend, dividend + n, pos_dividend_[p * D + j]);
+                            std::fill(types, types + n, trade.type);
+                            OptionBatch batch;
+                            batch.size = n;
+                            batch.spot = spots;
+                            batch.strike = strike;
+                            batch.rate = rate;
+                            batch.volatility = vol;
+                            batch.maturity = tau;
+                            batch.type = types;
+                            batch.dividend = dividend;
+                            GreeksBatch out;
+                            out.price = price;
+                            BatchPricer::priceRange(batch, out, 0, n);
+                        }
+                        for (int i = 0; i < n; ++i) value[i] += trade.quantity * price[i];
+                    }
+
+                    // 3. Streaming statistics of the date
+                    for (int i = 0; i < n; ++i) {
+                        a.value[j].add(value[i]);
+                        a.positive[j].add(std::max(value[i], 0.0));
+                        a.negative[j].add(std::max(-value[i], 0.0));
+                        a.sketches[j].add(value[i]);
+                    }
+                }
+                PERF_COUNT(PATHS, n);
+            }
+        });
+
+        ExposureProfile profile;
+        profile.dates = dates_;
+        profile.quantile = quantile_;
+        profile.paths = num_paths_;
+        profile.distributions.assign(D, QuantileSketch(sketch_accuracy_));
+        for (std::size_t j = 0; j < D; ++j) {
+            NeumaierSum value, positive, negative;
+            for (Accumulator& a : acc) {
+                value.merge(a.value[j]);
+                positive.merge(a.positive[j]);
+                negative.merge(a.negative[j]);
+                profile.distributions[j].merge(a.sketches[j]);
+            }
+            profile.expectedValue.push_back(value.value() / num_paths_);
+            profile.expectedExposure.push_back(positive.value() / num_paths_);
+            profile.expectedNegativeExposure.push_back(negative.value() / num_paths_);
+            profile.pfe.push_back(profile.distributions[j].quantile(quantile_));
+        }
+        return profile;
+    }
+};
+
+#endif // EXPOSURE_ENGINE_H
@@ -0,0 +1,340 @@
+#ifndef HEDGE_SIMULATOR_H
+#define HEDGE_SIMULATOR_H
+
+#include "Arena.h"
+#include "BlackScholes.h"
+#include "EuropeanOption.h"
+#include "Executor.h"
+#include "Instrumentation.h"
+#include "MCAccumulator.h"
+#include "OptionBook.h"
+#include "QuantileSketch.h"
+#include "SimdMath.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Distribution of the hedged P&L of a short option, in time-T money
+struct HedgeResult {
+    int paths = 0;
+    int rebalances = 0;
+    double premium = 0.0;       // Black-Scholes price received for the option, at the hedge volatility
+    double mean = 0.0;          // Mean hedged P&L
+    double stdDev = 0.0;        // Hedging error
+    double min = 0.0;
+    double max = 0.0;
+    double meanCost = 0.0;      // Mean transaction costs paid (included in the P&L)
+    QuantileSketch losses;      // -P&L of the paths that lose money
+    QuantileSketch gains;       // P&L of the other paths
+
+    double stdError() const { return paths > 0 ? stdDev / std::sqrt(static_cast<double>(paths)) : 0.0; }
+
+    // P&L at quantile q in [0, 1]: the losses sketch holds the lower tail (reversed), the
+    // gains sketch the upper one
+    double quantile(double q) const {
+        const double lossCount = static_cast<double>(losses.count());
+        const double total = lossCount + static_cast<double>(gains.count());
+        if (total == 0.0) return 0.0;
+        double rank = std::min(1.0, std::max(0.0, q)) * (total - 1.0);
+        if (rank < lossCount) {
+            return lossCount > 1.0 ? -losses.quantile(1.0 - rank / (lossCount - 1.0)) : -losses.quantile(1.0);
+        }
+        double gainCount = total - lossCount;
+        return gainCount > 1.0 ? gains.quantile((rank - lossCount) / (gainCount - 1.0)) : gains.quantile(0.0);
+    }
+
+    // Loss not exceeded with probability 'level' (0 when even that quantile is a gain)
+    double valueAtRisk(double level) const { return std::max(0.0, -quantile(1.0 - level)); }
+};
+
+// Delta-hedging backtest of a short European option.
+//
+// The option is sold at its Black-Scholes price at the hedge volatility and delta-hedged
+// with the underlying at 'rebalances' equally spaced dates; the underlying follows GBM
+// (exact steps) or Heston (full truncation, 'steps per rebalance' Euler steps). Every trade
+// pays a proportional cost on its notional, the cash account accrues at the rate, and the
+// hedge is unwound at maturity, so the P&L is the final cash (costs paid) - payoff(S_T).
+//
+// Paths run in blocks of SoA tiles on the executor. A rebalance is one pass over the tile:
+// advance the spots, then the Black-Scholes delta of every path at the common time to
+// maturity (the BlackScholes formulas with the per-date constants hoisted, exp and log from
+// the math policy, the normal CDF without branches), so the loop vectorizes and no pricer
+// object is built per step. Block b draws CounterRNG(seed, b); per-block sums are added
+// into exact sums and the P&L sketches count integers, so the result is identical, bit for
+// bit, for any thread count.
+class HedgeSimulator {
+private:
+    int num_paths_;
+    int rebalances_;
+    int steps_per_rebalance_ = 1;
+    int block_size_ = 256;
+    double cost_rate_ = 0.0;            // Proportional transaction cost (fraction of the notional)
+    double hedge_volatility_ = 0.0;     // 0: the volatility of the dynamics
+    double sketch_accuracy_ = 0.005;
+    std::uint64_t seed_ = 42;
+    MathPolicy math_ = MathPolicy::LIBM;
+    Executor* executor_;
+    WorkspacePool workspaces_;
+
+    // Dynamics of one run
+    struct Model {
+        double spot;
+        double rate;
+        double volatility;      // GBM
+        HestonParams heston;
+        bool stochasticVol;
+    };
+
+    // SoA state of one block of paths (worker arena)
+    struct Tile {
+        double* S;
+        double* v;
+        double* delta;
+        double* next;
+        double* cash;
+        double* cost;
+        double* z1;
+        double* z2;
+
+        Tile(Arena& arena, int B)
+            : S(arena.allocate<double>(B)), v(arena.allocate<double>(B)), delta(arena.allocate<double>(B)),
+              next(arena.allocate<double>(B)), cash(arena.allocate<double>(B)), cost(arena.allocate<double>(B)),
+              z1(arena.allocate<double>(B)), z2(arena.allocate<double>(B)) {}
+    };
+
+    double hedgeVolatility(const Model& m) const {
+        if (hedge_volatility_ > 0.0) return hedge_volatility_;
+        return m.stochasticVol ? std::sqrt(m.heston.theta) : m.volatility;
+    }
+
+    // Per-date constants of the delta kernel
+    struct DeltaConstants {
+        double inv_strike;
+        double inv_sig_sqrt_tau;   // 1 / (sigma sqrt(tau))
+        double shift;              // (r + sigma^2 / 2) tau / (sigma sqrt(tau))
+        double offset;             // 0 for a call, -1 for a put
+    };
+
+    static DeltaConstants deltaConstants(const EuropeanOption& option, double rate, double sigma, double tau) {
+        double sig_sqrt_tau = sigma * std::sqrt(tau);
+        return {1.0 / option.getStrike(), 1.0 / sig_sqrt_tau, (rate + 0.5 * sigma * sigma) * tau / sig_sqrt_tau,
+                option.getType() == OptionType::CALL ? 0.0 : -1.0};
+    }
+
+    // Black-Scholes delta of every path: normalCDF(d1) (- 1 for a put), with the
+    // Abramowitz-Stegun approximation of Utils written branch-free (the sign of d1 through
+    // copysign)
+    template <typename Math>
+    static void deltaTile(const double* S, double* delta, int n, const DeltaConstants& c) {
+        const double a1 = 0.254829592, a2 = -0.284496736, a3 = 1.421413741;
+        const double a4 = -1.453152027, a5 = 1.061405429, p = 0.3275911;
+        const double inv_sqrt2 = 0.70710678118654752;
+        SIMD_LOOP
+        for (int i = 0; i < n; ++i) {
+            double d1 = Math::log(S[i] * c.inv_strike) * c.inv_sig_sqrt_tau + c.shift;
+            double x = std::abs(d1) * inv_sqrt2;
+            double t = 1.0 / (1.0 + p * x);
+            double y = 1.0 - (((((a5 * t + a4) * t) + a3) * t + a2) * t + a1) * t * Math::exp(-x * x);
+            delta[i] = 0.5 * (1.0 + std::copysign(y, d1)) + c.offset;
+        }
+    }
+
+    // Simulates and hedges one block of n paths; adds each path's P&L to the statistics
+    template <typename Math>
+    void hedgeBlock(const EuropeanOption& option, const Model& m, double premium, double delta0,
+                    std::uint64_t block, int n, const Tile& tile, NeumaierSum sums[3], double& lo, double& hi,
+                    QuantileSketch& losses, QuantileSketch& gains) const {
+        double* S = tile.S;
+        double* v = tile.v;
+        double* delta = tile.delta;
+        double* next = tile.next;
+        double* cash = tile.cash;
+        double* cost = tile.cost;
+        double* z1 = tile.z1;
+        double* z2 = tile.z2;
+
+        const double T = option.getMaturity();
+        const double dt_hedge = T / rebalances_;
+        const int substeps = m.stochasticVol ? steps_per_rebalance_ : 1;
+        const double dt = dt_hedge / substeps, sqrt_dt = std::sqrt(dt);
+        const double growth = std::exp(m.rate * dt_hedge);
+        const double sigma = hedgeVolatility(m);
+        const double gbm_drift = (m.rate - 0.5 * m.volatility * m.volatility) * dt;
+        const double gbm_diffusion = m.volatility * sqrt_dt;
+        const HestonParams& h = m.heston;
+        const double c2 = std::sqrt(1.0 - h.rho * h.rho);
+        const double half = 0.5;
+
+        // Sell the option, buy the initial hedge
+        const double entry = cost_rate_ * std::abs(delta0) * m.spot;
+        for (int i = 0; i < n; ++i) {
+            S[i] = m.spot;
+            v[i] = h.v0;
+            delta[i] = delta0;
+            cash[i] = premium - delta0 * m.spot - entry;
+            cost[i] = entry;
+        }
+
+        CounterRNG rng(seed_, block);
+        for (int k = 1; k <= rebalances_; ++k) {
+            // 1. Spots to the next rebalancing date
+            for (int s = 0; s < substeps; ++s) {
+                for (int i = 0; i < n; ++i) z1[i] = rng.getNormal();
+                if (m.stochasticVol) {
+                    for (int i = 0; i < n; ++i) z2[i] = rng.getNormal();
+                    SIMD_LOOP
+                    for (int i = 0; i < n; ++i) {
+                        // Full truncation; max(v, 0) as (v + |v|) / 2
+                        double v_curr = half * (v[i] + std::abs(v[i]));
+                        double sqrt_v = Math::sqrt(v_curr);
+                        double dWv = (h.rho * z1[i] + c2 * z2[i]) * sqrt_dt;
+                        v[i] += h.kappa * (h.theta - v_curr) * dt + h.xi * sqrt_v * dWv;
+                        S[i] *= Math::exp((m.rate - half * v_curr) * dt + sqrt_v * z1[i] * sqrt_dt);
+                    }
+                } else {
+                    SIMD_LOOP
+                    for (int i = 0; i < n; ++i) S[i] *= Math::exp(gbm_drift + gbm_diffusion * z1[i]);
+                }
+            }
+
+            // 2. New hedge ratio (0 at maturity: the hedge is unwound), trade and pay its cost
+            if (k < rebalances_) {
+                deltaTile<Math>(S, next, n, deltaConstants(option, m.rate, sigma, T - k * dt_hedge));
+            } else {
+                std::fill(next, next + n, 0.0);
+            }
+            SIMD_LOOP
+            for (int i = 0; i < n; ++i) {
+                double trade = next[i] - delta[i];
+                double fee = cost_rate_ * std::abs(trade) * S[i];
+                cash[i] = cash[i] * growth - trade * S[i] - fee;
+                cost[i] += fee;
+                delta[i] = next[i];
+            }
+        }
+
+        // 3. Deliver the payoff and record the P&L
+        NeumaierSum sum, squares, fees;
+        for (int i = 0; i < n; ++i) {
+            double pnl = cash[i] - option.payoff(S[i]);
+            sum.add(pnl);
+            squares.add(pnl * pnl);
+            fees.add(cost[i]);
+            lo = std::min(lo, pnl);
+            hi = std::max(hi, pnl);
+            if (pnl < 0.0) losses.add(-pnl);
+            else gains.add(pnl);
+        }
+        sums[0].merge(sum);
+        sums[1].merge(squares);
+        sums[2].merge(fees);
+    }
+
+    HedgeResult run(const EuropeanOption& option, const Model& m) {
+        if (rebalances_ < 1 || num_paths_ < 1) throw std::invalid_argument("HedgeSimulator: paths and rebalances must be >= 1");
+        const double sigma = hedgeVolatility(m);
+        if (!(sigma > 0.0)) throw std::invalid_argument("HedgeSimulator: hedge volatility must be positive");
+        BlackScholes bs(m.spot, option.getStrike(), m.rate, sigma, option.getMaturity(), option.getType());
+        const double premium = bs.price();
+        const double delta0 = bs.delta();
+
+        const int B = block_size_;
+        const std::size_t blocks = (static_cast<std::size_t>(num_paths_) + B - 1) / B;
+        const int workers = executor_->concurrency();
+
+        struct Accumulator {
+            ExactSum sum, squares, fees;
+            double lo = std::numeric_limits<double>::infinity();
+            double hi = -std::numeric_limits<double>::infinity();
+            QuantileSketch losses, gains;
+        };
+        std::vector<Accumulator> acc(workers);
+        for (Accumulator& a : acc) {
+            a.losses = QuantileSketch(sketch_accuracy_);
+            a.gains = QuantileSketch(sketch_accuracy_);
+        }
+        workspaces_.prepare(workers);
+
+        executor_->parallelFor(blocks, [&](std::size_t begin, std::size_t end, int worker) {
+            Accumulator& a = acc[worker];
+            const Tile tile(workspaces_.arena(worker), B);
+            withMathPolicy(math_, [&](auto math) {
+                using Math = decltype(math);
+                for (std::size_t block = begin; block < end; ++block) {
+                    const int n = static_cast<int>(std::min<std::size_t>(B, num_paths_ - block * B));
+                    NeumaierSum sums[3];
+                    hedgeBlock<Math>(option, m, premium, delta0, block, n, tile, sums, a.lo, a.hi, a.losses, a.gains);
+                    // One exact addition per block: the totals do not depend on the split
+                    a.sum.add(sums[0].value());
+                    a.squares.add(sums[1].value());
+                    a.fees.add(sums[2].value());
+                    PERF_COUNT(PATHS, n);
+                }
+            });
+        });
+
+        HedgeResult result;
+        result.paths = num_paths_;
+        result.rebalances = rebalances_;
+        result.premium = premium;
+        result.losses = QuantileSketch(sketch_accuracy_);
+        result.gains = QuantileSketch(sketch_accuracy_);
+        ExactSum sum, squares, fees;
+        result.min = std::numeric_limits<double>::infinity();
+        result.max = -std::numeric_limits<double>::infinity();
+        for (const Accumulator& a : acc) {
+            sum.merge(a.sum);
+            squares.merge(a.squares);
+            fees.merge(a.fees);
+            result.min = std::min(result.min, a.lo);
+            result.max = std::max(result.max, a.hi);
+            result.losses.merge(a.losses);
+            result.gains.merge(a.gains);
+        }
+        const double N = static_cast<double>(num_paths_);
+        result.mean = sum.value() / N;
+        result.stdDev = std::sqrt(std::max(0.0, squares.value() / N - result.mean * result.mean));
+        result.meanCost = fees.value() / N;
+        return result;
+    }
+
+public:
+    HedgeSimulator(int num_paths = 100000, int rebalances = 52, Executor& executor = defaultExecutor())
+        : num_paths_(num_paths), rebalances_(rebalances), executor_(&executor) {}
+
+    void setExecutor(Executor& executor) { executor_ = &executor; }
+    void setPaths(int paths) { num_paths_ = std::max(1, paths); }
+    void setRebalances(int rebalances) { rebalances_ = std::max(1, rebalances); }
+    void setStepsPerRebalance(int steps) { steps_per_rebalance_ = std::max(1, steps); }   // Heston only
+    void setBlockSize(int paths) { block_size_ = std::max(1, paths); }
+    void setSketchAccuracy(double accuracy) { sketch_accuracy_ = accuracy; }
+    void setSeed(std::uint64_t seed) { seed_ = seed; }
+    void setMathPolicy(MathPolicy policy) { math_ = policy; }
+    MathPolicy getMathPolicy() const { return math_; }
+
+    // Proportional cost of a trade, as a fraction of its notional |change in delta| S
+    void setTransactionCost(double rate) {
+        if (rate < 0.0) throw std::invalid_argument("HedgeSimulator: transaction cost must be non-negative");
+        cost_rate_ = rate;
+    }
+
+    // Volatility of the hedge (and of the premium); 0 = the volatility of the dynamics
+    // (sqrt(theta) under Heston)
+    void setHedgeVolatility(double volatility) { hedge_volatility_ = std::max(0.0, volatility); }
+
+    // Underlying under GBM at 'volatility'
+    HedgeResult simulate(const EuropeanOption& option, double spot, double rate, double volatility) {
+        return run(option, Model{spot, rate, volatility, HestonParams(), false});
+    }
+
+    // Underlying under Heston
+    HedgeResult simulate(const EuropeanOption& option, double spot, double rate, const HestonParams& heston) {
+        return run(option, Model{spot, rate, 0.0, heston, true});
+    }
+};
+
+#endif // HEDGE_SIMULATOR_H
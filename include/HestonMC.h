@@ -1,22 +1,513 @@
 #ifndef HESTON_MC_H
 #define HESTON_MC_H
 
+#include "Arena.h"
+#include "Executor.h"
+#include "Instrumentation.h"
+#include "JumpDiffusion.h"
+#include "TermStructure.h"
 #include "Option.h"
+#include "SimdMath.h"
 #include "Utils.h"
 #include <cmath>
 #include <vector>
 #include <algorithm>
-#include <omp.h>
+#include <stdexcept>
+
+// Prices of a whole option chain (every strike at every expiry) from one simulation.
+// Quotes are stored expiry-major, in the order of the sorted expiries and of the strikes given.
+struct HestonChain {
+    std::vector<double> expiries;   // Sorted, distinct
+    std::vector<double> strikes;    // As given
+    std::vector<double> calls;      // calls[e * strikes.size() + k]
+    std::vector<double> puts;
+
+    double call(std::size_t e, std::size_t k) const { return calls[e * strikes.size() + k]; }
+    double put(std::size_t e, std::size_t k) const { return puts[e * strikes.size() + k]; }
+};
+
+// Hull-White one-factor short rate for the hybrid Heston-Hull-White model:
+// r(t) = x(t) + phi(t), dx = -a x dt + sigma_r dW_r, x(0) = 0, with phi fitted to the initial
+// curve. W_r is correlated with the spot and the variance Brownian motions.
+struct HullWhiteParams {
+    double meanReversion = 0.05;   // a
+    double volatility = 0.0;       // sigma_r (0 = deterministic rates)
+    double rhoSpot = 0.0;          // Corr(dW_r, dW_S)
+    double rhoVariance = 0.0;      // Corr(dW_r, dW_v)
+
+    bool active() const { return volatility > 0.0; }
+
+    bool operator==(const HullWhiteParams& o) const {
+        return meanReversion == o.meanReversion && volatility == o.volatility &&
+               rhoSpot == o.rhoSpot && rhoVariance == o.rhoVariance;
+    }
+    bool operator!=(const HullWhiteParams& o) const { return !(*this == o); }
+};
 
 class HestonPricer {
 private:
     int num_sims_;
     int num_steps_; // Number of time steps (e.g., 252 for daily simulations)
+    Executor* executor_; // Runs the path loop (not owned)
+    int tile_width_; // Paths evolved together, step by step (default: the machine's tuning file)
+
+    // Scratch reused across calls (no heap allocation once warmed up)
+    WorkspacePool workspaces_;
+    std::vector<double> partial_sums_;
+
+    // Arithmetic of the path evolution; payoffs are always summed in double
+    Precision precision_ = Precision::DOUBLE;
+
+    // exp/sqrt of the step loop: libm (reference) or the vectorizable tiers of SimdMath.h
+    MathPolicy math_ = MathPolicy::LIBM;
+
+    // Bates extension: lognormal jumps in the spot (none by default)
+    JumpParams jumps_;
+    std::vector<double> jump_cdf_; // Poisson(lambda T) CDF of the jump count over the option's life
+    int jump_base_ = 0;            // Count of jump_cdf_[0] (counts below it have negligible mass)
+
+    // Hybrid extension: Hull-White short rate (none by default)
+    HullWhiteParams rates_;
+    std::vector<double> rate_shift_; // Deterministic part of the integral of r over each step
+
+    // Chain pricing: spot of every path at every expiry, and the strikes in increasing order
+    std::vector<double> chain_states_;
+    std::vector<std::size_t> strike_order_;
+
+    // Jump count of one path by inversion of the CDF table (a few comparisons for typical
+    // lambda T, a binary search for the wide tables of large ones)
+    int sampleJumpCount(double u) const {
+        const int last = static_cast<int>(jump_cdf_.size()) - 1;
+        if (last > 32) {
+            auto it = std::lower_bound(jump_cdf_.begin(), jump_cdf_.end() - 1, u);
+            return jump_base_ + static_cast<int>(it - jump_cdf_.begin());
+        }
+        int n = 0;
+        while (n < last && u > jump_cdf_[n]) ++n;
+        return jump_base_ + n;
+    }
+
+    // Poisson(mean) CDF table from the mode outwards: the mode's weight is taken in log space
+    // (exp(-mean) alone underflows past mean ~ 745) and the others follow by the ratio
+    // recursion. Counts whose weight is below 1e-18 of the mode's are left out.
+    void buildJumpTable(double mean) {
+        if (!(mean >= 0.0) || mean > 1e7) {
+            throw std::invalid_argument("HestonPricer: jump intensity * maturity must be finite and at most 1e7");
+        }
+        const int mode = static_cast<int>(std::floor(mean));
+        const double peak = std::exp(-mean + mode * std::log(mean > 0.0 ? mean : 1.0) - std::lgamma(mode + 1.0));
+        const double cutoff = 1e-18 * peak;
+
+        std::vector<double> below;   // Weights of mode - 1, mode - 2, ...
+        double weight = peak;
+        for (int k = mode; k > 0; --k) {
+            weight *= k / mean;
+            if (weight < cutoff) break;
+            below.push_back(weight);
+        }
+        jump_base_ = mode - static_cast<int>(below.size());
+        double cdf = 0.0;
+        jump_cdf_.clear();
+        for (auto it = below.rbegin(); it != below.rend(); ++it) {
+            cdf += *it;
+            jump_cdf_.push_back(cdf);
+        }
+        weight = peak;
+        cdf += weight;
+        jump_cdf_.push_back(cdf);
+        for (int k = mode + 1; cdf < 1.0 - 1e-15 && weight >= cutoff; ++k) {
+            weight *= mean / k;
+            cdf += weight;
+            jump_cdf_.push_back(cdf);
+        }
+    }
+
+    // Rate-factor constants of the hybrid kernel (uniform step)
+    template <typename Real>
+    struct RateConstants {
+        Real decay = 1;       // e^(-a dt)
+        Real stddev = 0;      // Std dev of the exact OU step
+        Real half_dt = 0;     // Trapezoid weight of the integral of x
+        Real carry = 0;       // Dividend yield (and jump compensation) per unit time
+        Real w1 = 0, w2 = 0, w3 = 0;   // dW_r = w1 Z1 + w2 Z2 + w3 Z3 (unit normals)
+    };
+
+    // Model constants of one pricing call
+    struct StepParams {
+        double spot, v0, kappa, theta, xi, rate;
+        double dt, sqrt_dt, c1, c2;
+        RateConstants<double> hw;   // Hybrid only
+    };
+
+    // Per-step constants in the kernel's arithmetic
+    template <typename Real>
+    struct StepConstants {
+        Real kappa, theta, xi, rate, dt, sqrt_dt, c1, c2;
+
+        StepConstants(const StepParams& m, double step)
+            : kappa(static_cast<Real>(m.kappa)), theta(static_cast<Real>(m.theta)),
+              xi(static_cast<Real>(m.xi)), rate(static_cast<Real>(m.rate)),
+              dt(static_cast<Real>(step)), sqrt_dt(static_cast<Real>(std::sqrt(step))),
+              c1(static_cast<Real>(m.c1)), c2(static_cast<Real>(m.c2)) {}
+    };
+
+    // One hybrid step: the Heston step of advanceTile with the short rate in the drift.
+    // x moves by its exact Gaussian transition, the integral of r over the step is the
+    // trapezoid on x plus the deterministic shift (fitted so that E[exp(-I)] is the curve's
+    // discount factor on every grid date), and I accumulates it for the pathwise discount.
+    // The spot and I share the same increment, so S e^(-I) stays an exact martingale.
+    template <typename Math, typename Real>
+    static void advanceHybridTile(Real* S, Real* v, Real* x, Real* I, const Real* z1, const Real* z2, const Real* z3,
+                                  int n, const StepConstants<Real>& c, const RateConstants<Real>& h, Real shift) {
+        const Real half = static_cast<Real>(0.5);
+        SIMD_LOOP
+        for (int p = 0; p < n; ++p) {
+            Real dWs = z1[p] * c.sqrt_dt;
+            Real dWv = (c.c1 * z1[p] + c.c2 * z2[p]) * c.sqrt_dt;
+            Real zr = h.w1 * z1[p] + h.w2 * z2[p] + h.w3 * z3[p];
+
+            Real x_next = h.decay * x[p] + h.stddev * zr;
+            Real dI = h.half_dt * (x[p] + x_next) + shift;
+            x[p] = x_next;
+            I[p] += dI;
+
+            Real v_curr = half * (v[p] + std::abs(v[p]));
+            Real sqrt_v = Math::sqrt(v_curr);
+            v[p] += c.kappa * (c.theta - v_curr) * c.dt + c.xi * sqrt_v * dWv;
+            S[p] *= Math::exp(dI - (h.carry + half * v_curr) * c.dt + sqrt_v * dWs);
+        }
+    }
+
+    // One Euler-Maruyama step with Full Truncation for n paths of a tile.
+    // With a SimdMath policy the loop has no calls and vectorizes across the tile.
+    template <typename Math, typename Real>
+    static void advanceTile(Real* S, Real* v, const Real* z1, const Real* z2, int n, const StepConstants<Real>& c) {
+        const Real half = static_cast<Real>(0.5);
+        SIMD_LOOP
+        for (int p = 0; p < n; ++p) {
+            // Correlate Brownian motions
+            Real dWs = z1[p] * c.sqrt_dt;                       // Asset noise
+            Real dWv = (c.c1 * z1[p] + c.c2 * z2[p]) * c.sqrt_dt; // Volatility noise
+
+            // 1. Update Volatility (CIR Process)
+            // Use "Full Truncation" scheme to prevent negative variance
+            // (max(v, 0) written as (v + |v|) / 2, exact and without a branch)
+            Real v_curr = half * (v[p] + std::abs(v[p]));
+            Real sqrt_v = Math::sqrt(v_curr);
+            v[p] += c.kappa * (c.theta - v_curr) * c.dt + c.xi * sqrt_v * dWv;
+
+            // 2. Update Asset Price
+            // S(t+1) = S(t) * exp( (r - 0.5*v)*dt + sqrt(v)*dWs )
+            Real drift = (c.rate - half * v_curr) * c.dt;
+            Real diffusion = sqrt_v * dWs;
+            S[p] *= Math::exp(drift + diffusion);
+        }
+    }
+
+    // Simulates paths [begin, end) of one worker, tile by tile, and returns their payoff sum.
+    // Real is the type of the normals and of the S/v state (float halves the tile's footprint
+    // and doubles the SIMD width of the step loop); Math supplies exp and sqrt.
+    template <typename Math, typename Real>
+    double simulateRange(const Option& option, const StepParams& m, int begin, int end, int worker) {
+        RandomGenerator rng(42 + worker); // Unique seed per worker
+        const int W = tile_width_;
+        const StepConstants<Real> c(m, m.dt);
+
+        // Tile workspace (worker-local arena): normals stored step-major, so each time
+        // step reads W contiguous values, plus the S and v state of the W paths
+        Arena& arena = workspaces_.arena(worker);
+        Real* Z1 = arena.allocate<Real>(static_cast<std::size_t>(W) * num_steps_);
+        Real* Z2 = arena.allocate<Real>(static_cast<std::size_t>(W) * num_steps_);
+        Real* S = arena.allocate<Real>(W);
+        Real* v = arena.allocate<Real>(W);
+        Real* J = arena.allocate<Real>(W);  // Sum of the log-jumps of each path (Bates)
+        const bool jumps = jumps_.active();
+        double local_sum = 0.0;
+
+        // Hybrid: rate normals from a stream of their own, so the spot and variance draws
+        // are those of plain Heston; x and the integral of r of each path
+        const bool hybrid = rates_.active();
+        RandomGenerator rate_rng(1042 + worker);
+        Real* Z3 = hybrid ? arena.allocate<Real>(static_cast<std::size_t>(W) * num_steps_) : nullptr;
+        Real* X = arena.allocate<Real>(W);
+        Real* I = arena.allocate<Real>(W);
+        const RateConstants<Real> h{static_cast<Real>(m.hw.decay), static_cast<Real>(m.hw.stddev),
+                                    static_cast<Real>(m.hw.half_dt), static_cast<Real>(m.hw.carry),
+                                    static_cast<Real>(m.hw.w1), static_cast<Real>(m.hw.w2), static_cast<Real>(m.hw.w3)};
+
+        for (int b = begin; b < end; b += W) {
+            int n = std::min(W, end - b);
+            {
+                // Each path still consumes its own (Z1, Z2) pairs in step order
+                PERF_SCOPE(HESTON_RNG);
+                for (int p = 0; p < n; ++p) {
+                    for (int t = 0; t < num_steps_; ++t) {
+                        Z1[t * W + p] = static_cast<Real>(rng.getNormal());
+                        Z2[t * W + p] = static_cast<Real>(rng.getNormal());
+                    }
+                    // Jumps are independent of the diffusion and only their sum matters for a
+                    // European payoff: N ~ Poisson(lambda T), then one normal for N lognormal jumps
+                    if (jumps) {
+                        int count = sampleJumpCount(rng.getUniform());
+                        J[p] = count == 0 ? Real(0) : static_cast<Real>(
+                            count * jumps_.mean + std::sqrt(static_cast<double>(count)) * jumps_.stddev * rng.getNormal());
+                    }
+                    if (hybrid) {
+                        for (int t = 0; t < num_steps_; ++t) Z3[t * W + p] = static_cast<Real>(rate_rng.getNormal());
+                    }
+                }
+            }
+
+            PERF_SCOPE(HESTON_PATHS);
+            for (int p = 0; p < n; ++p) {
+                S[p] = static_cast<Real>(m.spot);
+                v[p] = static_cast<Real>(m.v0);
+            }
+
+            // Time-Stepping Simulation, tile at a time
+            if (hybrid) {
+                for (int p = 0; p < n; ++p) {
+                    X[p] = Real(0);
+                    I[p] = Real(0);
+                }
+                for (int t = 0; t < num_steps_; ++t) {
+                    advanceHybridTile<Math>(S, v, X, I, Z1 + t * W, Z2 + t * W, Z3 + t * W, n, c, h,
+                                            static_cast<Real>(rate_shift_[t]));
+                }
+            } else {
+                for (int t = 0; t < num_steps_; ++t) {
+                    advanceTile<Math>(S, v, Z1 + t * W, Z2 + t * W, n, c);
+                }
+            }
+
+            if (jumps) {
+                SIMD_LOOP
+                for (int p = 0; p < n; ++p) S[p] *= Math::exp(J[p]);
+            }
+            if (hybrid) {
+                // Pathwise discount factor, in place of the integral
+                SIMD_LOOP
+                for (int p = 0; p < n; ++p) I[p] = Math::exp(-I[p]);
+                for (int p = 0; p < n; ++p) local_sum += option.payoff(static_cast<double>(S[p])) * static_cast<double>(I[p]);
+            } else {
+                for (int p = 0; p < n; ++p) local_sum += option.payoff(static_cast<double>(S[p]));
+            }
+        }
+        return local_sum;
+    }
+
+    // Chain kernel: the same paths, stepped expiry segment by expiry segment, with the spot of
+    // every path recorded at each expiry in chain_states_[e * num_sims_ + path]
+    template <typename Math>
+    void simulateChainRange(const StepParams& m, const std::vector<int>& segment_steps,
+                            const std::vector<double>& segment_dt, const std::vector<double>& segment_carry,
+                            int total_steps, int begin, int end, int worker) {
+        RandomGenerator rng(42 + worker);
+        const int W = tile_width_;
+
+        Arena& arena = workspaces_.arena(worker);
+        double* Z1 = arena.allocate<double>(static_cast<std::size_t>(W) * total_steps);
+        double* Z2 = arena.allocate<double>(static_cast<std::size_t>(W) * total_steps);
+        double* S = arena.allocate<double>(W);
+        double* v = arena.allocate<double>(W);
+
+        for (int b = begin; b < end; b += W) {
+            int n = std::min(W, end - b);
+            {
+                PERF_SCOPE(HESTON_RNG);
+                for (int p = 0; p < n; ++p) {
+                    for (int t = 0; t < total_steps; ++t) {
+                        Z1[t * W + p] = rng.getNormal();
+                        Z2[t * W + p] = rng.getNormal();
+                    }
+                }
+            }
+
+            PERF_SCOPE(HESTON_PATHS);
+            for (int p = 0; p < n; ++p) {
+                S[p] = m.spot;
+                v[p] = m.v0;
+            }
+
+            int t = 0;
+            for (std::size_t e = 0; e < segment_steps.size(); ++e) {
+                StepParams segment = m;
+                segment.rate = segment_carry[e];
+                const StepConstants<double> c(segment, segment_dt[e]);
+                for (int k = 0; k < segment_steps[e]; ++k, ++t) {
+                    advanceTile<Math>(S, v, Z1 + t * W, Z2 + t * W, n, c);
+                }
+                std::copy(S, S + n, chain_states_.data() + e * num_sims_ + b);
+            }
+        }
+    }
+
+    // Quotes of every strike at expiry e from its recorded spots (sorted in place).
+    // With the spots sorted and prefix sums P, the strikes are walked in increasing order:
+    // for idx = #{S < K}, sum (K - S)+ = K idx - P[idx] and sum (S - K)+ = (P[N] - P[idx]) - K (N - idx),
+    // so each strike costs O(1) after one O(N log N) sort instead of a pass over the paths.
+    // 'scale' maps the simulated spots to this expiry's (escrowed) spot: the Heston log-return
+    // does not depend on the starting spot, so one set of paths serves every expiry.
+    void evaluateExpiry(std::size_t e, double discount, double scale, HestonChain& chain, int worker) {
+        const std::size_t N = static_cast<std::size_t>(num_sims_);
+        const std::size_t K = chain.strikes.size();
+        double* spots = chain_states_.data() + e * N;
+        std::sort(spots, spots + N);
+
+        double* prefix = workspaces_.arena(worker).allocate<double>(N + 1);
+        prefix[0] = 0.0;
+        for (std::size_t i = 0; i < N; ++i) prefix[i + 1] = prefix[i] + spots[i];
+
+        const double weight = discount / static_cast<double>(N);
+        std::size_t idx = 0;
+        for (std::size_t j : strike_order_) {
+            double strike = chain.strikes[j];
+            const double level = strike / scale;   // Strike in simulated-spot units
+            while (idx < N && spots[idx] < level) ++idx;
+            double below = static_cast<double>(idx);
+            double above = static_cast<double>(N - idx);
+            chain.calls[e * K + j] = weight * (scale * (prefix[N] - prefix[idx]) - strike * above);
+            chain.puts[e * K + j] = weight * (strike * below - scale * prefix[idx]);
+        }
+    }
+
+    static void sortExpiries(std::vector<double>& expiries) {
+        std::sort(expiries.begin(), expiries.end());
+        expiries.erase(std::unique(expiries.begin(), expiries.end()), expiries.end());
+    }
+
+    // Hull-White constants of a run on a uniform grid, with the curve flat at r0 and m.rate
+    // the drift r0 - q (jump compensation included). The deterministic shift of each step is
+    // fitted to the discretised scheme: the trapezoid integral of x is Gaussian, and tracking
+    // Var(x), Cov(I, x) and Var(I) step by step gives
+    //   E[exp(-I(t_k))] = exp(-r0 t_k)   when   sum of shifts up to t_k = r0 t_k + Var(I(t_k)) / 2,
+    // so the simulated bond prices match the curve on every grid date, whatever the step.
+    void fitRates(StepParams& m, double r0, double T) {
+        const double a = rates_.meanReversion, sigma = rates_.volatility, dt = T / num_steps_;
+        RateConstants<double>& hw = m.hw;
+        hw.decay = std::exp(-a * dt);
+        double variance = a > 1e-12 ? -std::expm1(-2.0 * a * dt) / (2.0 * a) : dt;
+        hw.stddev = sigma * std::sqrt(variance);
+        hw.half_dt = 0.5 * dt;
+        hw.carry = r0 - m.rate;
 
+        // dW_r on the spot and variance normals (Cholesky row of the 3x3 correlation)
+        hw.w1 = rates_.rhoSpot;
+        hw.w2 = m.c2 > 1e-12 ? (rates_.rhoVariance - m.c1 * rates_.rhoSpot) / m.c2 : 0.0;
+        double w3_squared = 1.0 - hw.w1 * hw.w1 - hw.w2 * hw.w2;
+        if (w3_squared < -1e-12) {
+            throw std::invalid_argument("HestonPricer: spot, variance and rate correlations are not consistent");
+        }
+        hw.w3 = std::sqrt(std::max(0.0, w3_squared));
+
+        rate_shift_.resize(num_steps_);
+        double var_x = 0.0, cov = 0.0, var_i = 0.0;
+        const double e = hw.decay, s2 = hw.stddev * hw.stddev, h = hw.half_dt, g = h * (1.0 + e);
+        for (int t = 0; t < num_steps_; ++t) {
+            // I' = I + g x + h s Z, x' = e x + s Z
+            double var_i_next = var_i + g * g * var_x + 2.0 * g * cov + h * h * s2;
+            cov = e * cov + g * e * var_x + h * s2;
+            var_x = e * e * var_x + s2;
+            rate_shift_[t] = r0 * dt + 0.5 * (var_i_next - var_i);
+            var_i = var_i_next;
+        }
+    }
+
+    // Simulates the paths; 'rate' is the drift rate (r - q) and 'discount_factor' discounts the payoff
+    double simulate(const Option& option,
+                    double spot,
+                    double rate,
+                    double discount_factor,
+                    double v0,     // Initial Variance (volatility^2)
+                    double kappa,  // Mean Reversion Speed
+                    double theta,  // Long-run Variance
+                    double xi,     // Volatility of Volatility (Vol-of-Vol)
+                    double rho) {  // Correlation between Spot and Volatility
+        
+        double T = option.getMaturity();
+        double dt = T / num_steps_;
+        
+        double sum_payoffs = 0.0;
+
+        // Pre-calculate correlation constants
+        // We generate two independent standard normals Z1, Z2
+        // The correlated Brownian motion for Vol is: Wv = rho*Z1 + sqrt(1-rho^2)*Z2
+        StepParams m;
+        m.spot = spot;
+        m.v0 = v0;
+        m.kappa = kappa;
+        m.theta = theta;
+        m.xi = xi;
+        m.rate = rate;
+        if (jumps_.active()) {
+            // Compensated drift, and the jump-count distribution over [0, T]
+            m.rate = rate - jumps_.intensity * jumps_.meanJump();
+            buildJumpTable(jumps_.intensity * T);
+        }
+        m.dt = dt;
+        m.sqrt_dt = std::sqrt(dt);
+        m.c1 = rho;
+        m.c2 = std::sqrt(1.0 - rho * rho);
+        if (rates_.active()) {
+            // The curve is flat at the zero rate implied by the discount factor; the payoff is
+            // discounted along each path instead
+            fitRates(m, -std::log(discount_factor) / T, T);
+            discount_factor = 1.0;
+        }
+
+        // Per-worker partial sums, combined in worker order after the parallel region
+        partial_sums_.assign(executor_->concurrency(), 0.0);
+        std::vector<double>& partial_sums = partial_sums_;
+        workspaces_.prepare(executor_->concurrency());
+
+        // --- PARALLEL REGION (one contiguous range of paths per worker) ---
+        executor_->parallelFor(num_sims_, [&](std::size_t range_begin, std::size_t range_end, int worker) {
+            int begin = static_cast<int>(range_begin);
+            int end = static_cast<int>(range_end);
+            partial_sums[worker] = withMathPolicy(math_, [&](auto math) {
+                using Math = decltype(math);
+                return (precision_ == Precision::FLOAT)
+                    ? simulateRange<Math, float>(option, m, begin, end, worker)
+                    : simulateRange<Math, double>(option, m, begin, end, worker);
+            });
+            PERF_COUNT(PATHS, end - begin);
+            PERF_COUNT(RNG_DRAWS, static_cast<std::uint64_t>(end - begin) * num_steps_ * (rates_.active() ? 3 : 2));
+        });
+
+        {
+            PERF_SCOPE(HESTON_REDUCTION);
+            for (double partial : partial_sums) sum_payoffs += partial;
+        }
+        
+        return (sum_payoffs / num_sims_) * discount_factor;
+    }
 public:
     // Constructor
-    HestonPricer(int num_sims, int num_steps = 100)
-        : num_sims_(num_sims), num_steps_(num_steps) {}
+    HestonPricer(int num_sims, int num_steps = 100, Executor& executor = defaultExecutor())
+        : num_sims_(num_sims), num_steps_(num_steps), executor_(&executor),
+          tile_width_(machineTuning().hestonTileWidth) {}
+
+    void setExecutor(Executor& executor) { executor_ = &executor; }
+    void setTileWidth(int width) { tile_width_ = std::max(1, width); }
+    int getTileWidth() const { return tile_width_; }
+    void setPrecision(Precision precision) { precision_ = precision; }
+    Precision getPrecision() const { return precision_; }
+
+    // exp/sqrt of the path kernels: LIBM (default), PRECISE (a few ulp) or FAST (~1e-10),
+    // the last two vectorized across the tile
+    void setMathPolicy(MathPolicy policy) { math_ = policy; }
+    MathPolicy getMathPolicy() const { return math_; }
+
+    // Bates model: Heston plus lognormal jumps in the spot (intensity 0 = plain Heston)
+    void setJumps(const JumpParams& jumps) { jumps_ = jumps; }
+    const JumpParams& getJumps() const { return jumps_; }
+
+    // Heston-Hull-White hybrid: a Gaussian short rate around the curve, correlated with the
+    // spot and the variance, and a pathwise discount (volatility 0 = deterministic rates).
+    // The curve is flat at the option's zero rate (the 'rate' of price(), r(T) of a context).
+    void setHullWhite(const HullWhiteParams& rates) { rates_ = rates; }
+    const HullWhiteParams& getHullWhite() const { return rates_; }
+    const WorkspacePool& workspaces() const { return workspaces_; }
 
     // Heston Monte Carlo Pricing Method
     double price(const Option& option, 
@@ -27,58 +518,140 @@ public:
                  double theta,  // Long-run Variance
                  double xi,     // Volatility of Volatility (Vol-of-Vol)
                  double rho) {  // Correlation between Spot and Volatility
-        
-        double T = option.getMaturity();
-        double dt = T / num_steps_;
-        double discount_factor = std::exp(-rate * T);
-        
-        double sum_payoffs = 0.0;
-
-        // Pre-calculate correlation constants
-        // We generate two independent standard normals Z1, Z2
-        // The correlated Brownian motion for Vol is: Wv = rho*Z1 + sqrt(1-rho^2)*Z2
-        double sqrt_dt = std::sqrt(dt);
-        double c1 = rho;
-        double c2 = std::sqrt(1.0 - rho * rho);
+        return simulate(option, spot, rate, std::exp(-rate * option.getMaturity()), v0, kappa, theta, xi, rho);
+    }
 
-        // --- PARALLEL REGION (OpenMP) ---
-        #pragma omp parallel reduction(+:sum_payoffs)
-        {
-            int thread_id = omp_get_thread_num();
-            RandomGenerator rng(42 + thread_id); // Unique seed per thread
+    // Same, on rate and dividend curves resolved for the option's expiry. With deterministic
+    // rates only the integrated carry matters, so r(T) - q(T) drives every step.
+    double price(const Option& option, const ExpiryContext& ctx,
+                 double v0, double kappa, double theta, double xi, double rho) {
+        return simulate(option, ctx.spot, ctx.rate - ctx.dividendYield, ctx.discount, v0, kappa, theta, xi, rho);
+    }
 
-            #pragma omp for
-            for (int i = 0; i < num_sims_; ++i) {
-                double S = spot;
-                double v = v0;
+    // Every (expiry, strike) call and put from one set of paths, at a flat rate without dividends
+    // (the expiries are sorted and deduplicated)
+    HestonChain priceChain(double spot, double rate, double v0, double kappa, double theta, double xi, double rho,
+                           std::vector<double> expiries, const std::vector<double>& strikes) {
+        sortExpiries(expiries);
+        std::vector<ExpiryContext> contexts(expiries.size());
+        for (std::size_t e = 0; e < expiries.size(); ++e) {
+            ExpiryContext& ctx = contexts[e];
+            ctx.maturity = expiries[e];
+            ctx.spot = spot;
+            ctx.rate = rate;
+            ctx.discount = std::exp(-rate * expiries[e]);
+            ctx.forward = spot * std::exp(rate * expiries[e]);
+        }
+        return priceChain(contexts, v0, kappa, theta, xi, rho, strikes);
+    }
 
-                // Time-Stepping Simulation (Euler-Maruyama with Full Truncation)
-                for (int t = 0; t < num_steps_; ++t) {
-                    double Z1 = rng.getNormal();
-                    double Z2 = rng.getNormal();
-
-                    // Correlate Brownian motions
-                    double dWs = Z1 * sqrt_dt;                  // Asset noise
-                    double dWv = (c1 * Z1 + c2 * Z2) * sqrt_dt; // Volatility noise
-
-                    // 1. Update Volatility (CIR Process)
-                    // Use "Full Truncation" scheme to prevent negative variance
-                    double v_curr = std::max(v, 0.0);
-                    double dv = kappa * (theta - v_curr) * dt + xi * std::sqrt(v_curr) * dWv;
-                    v += dv;
-
-                    // 2. Update Asset Price
-                    // S(t+1) = S(t) * exp( (r - 0.5*v)*dt + sqrt(v)*dWs )
-                    double drift = (rate - 0.5 * v_curr) * dt;
-                    double diffusion = std::sqrt(v_curr) * dWs;
-                    S *= std::exp(drift + diffusion);
-                }
+    // Same on the rate and dividend curves of the underlying, resolved once per expiry
+    HestonChain priceChain(const MarketCurves& curves, double spot, double v0, double kappa, double theta, double xi,
+                           double rho, std::vector<double> expiries, const std::vector<double>& strikes) {
+        sortExpiries(expiries);
+        std::vector<ExpiryContext> contexts;
+        for (double T : expiries) contexts.push_back(curves.expiry(spot, T));
+        return priceChain(contexts, v0, kappa, theta, xi, rho, strikes);
+    }
 
-                sum_payoffs += option.payoff(S);
+    // Every (expiry, strike) call and put from one set of paths, one context per expiry in
+    // increasing maturity.
+    // The grid is cut at each expiry: the segment up to the next expiry gets its share of
+    // num_steps (at least one step), so the paths pass exactly through every expiry and the
+    // longest one is simulated with about num_steps steps. Each segment drifts at its forward
+    // carry, (r - q)(T_e) T_e - (r - q)(T_e-1) T_e-1 over its length, so every expiry sees the
+    // integrated carry of its own context; quotes are discounted with ctx.discount, and the
+    // spots are rescaled to each ctx.spot (cash dividends paid before that expiry). With a
+    // single expiry the paths are those of price(). Jumps are not supported here (they would
+    // need a count per segment).
+    HestonChain priceChain(const std::vector<ExpiryContext>& contexts, double v0, double kappa, double theta,
+                           double xi, double rho, const std::vector<double>& strikes) {
+        if (jumps_.active()) {
+            throw std::invalid_argument("HestonPricer::priceChain: jumps are not supported");
+        }
+        if (rates_.active()) {
+            throw std::invalid_argument("HestonPricer::priceChain: stochastic rates are not supported");
+        }
+        if (contexts.empty() || contexts.front().maturity <= 0.0) {
+            throw std::invalid_argument("HestonPricer::priceChain: expiries must be positive");
+        }
+        std::vector<double> expiries;
+        for (const ExpiryContext& ctx : contexts) {
+            if (!expiries.empty() && ctx.maturity <= expiries.back()) {
+                throw std::invalid_argument("HestonPricer::priceChain: contexts must be in increasing maturity");
             }
+            if (!(ctx.spot > 0.0)) {
+                throw std::invalid_argument("HestonPricer::priceChain: ex-dividend spot must be positive");
+            }
+            expiries.push_back(ctx.maturity);
         }
-        
-        return (sum_payoffs / num_sims_) * discount_factor;
+
+        HestonChain chain;
+        chain.expiries = expiries;
+        chain.strikes = strikes;
+        const std::size_t E = expiries.size();
+        const std::size_t K = strikes.size();
+        chain.calls.assign(E * K, 0.0);
+        chain.puts.assign(E * K, 0.0);
+
+        // Step grid and forward carry, one segment per expiry
+        const double horizon = expiries.back();
+        std::vector<int> segment_steps(E);
+        std::vector<double> segment_dt(E), segment_carry(E);
+        int total_steps = 0;
+        double previous = 0.0;
+        for (std::size_t e = 0; e < E; ++e) {
+            double length = expiries[e] - previous;
+            segment_steps[e] = std::max(1, static_cast<int>(std::ceil(num_steps_ * length / horizon - 1e-9)));
+            segment_dt[e] = length / segment_steps[e];
+            total_steps += segment_steps[e];
+            double carry = contexts[e].rate - contexts[e].dividendYield;
+            double carry_before = e == 0 ? carry : contexts[e - 1].rate - contexts[e - 1].dividendYield;
+            segment_carry[e] = (carry == carry_before) ? carry
+                                                       : (carry * expiries[e] - carry_before * previous) / length;
+            previous = expiries[e];
+        }
+
+        StepParams m;
+        m.spot = contexts.front().spot;
+        m.v0 = v0;
+        m.kappa = kappa;
+        m.theta = theta;
+        m.xi = xi;
+        m.rate = segment_carry.front();
+        m.dt = segment_dt.front();
+        m.sqrt_dt = std::sqrt(m.dt);
+        m.c1 = rho;
+        m.c2 = std::sqrt(1.0 - rho * rho);
+
+        strike_order_.resize(K);
+        for (std::size_t j = 0; j < K; ++j) strike_order_[j] = j;
+        std::sort(strike_order_.begin(), strike_order_.end(),
+                  [&](std::size_t a, std::size_t b) { return strikes[a] < strikes[b]; });
+
+        chain_states_.resize(E * static_cast<std::size_t>(num_sims_));
+        workspaces_.prepare(executor_->concurrency());
+
+        // --- PARALLEL REGION 1: the paths, recorded at every expiry ---
+        executor_->parallelFor(num_sims_, [&](std::size_t range_begin, std::size_t range_end, int worker) {
+            int begin = static_cast<int>(range_begin);
+            int end = static_cast<int>(range_end);
+            withMathPolicy(math_, [&](auto math) {
+                simulateChainRange<decltype(math)>(m, segment_steps, segment_dt, segment_carry, total_steps,
+                                                   begin, end, worker);
+            });
+            PERF_COUNT(PATHS, end - begin);
+            PERF_COUNT(RNG_DRAWS, static_cast<std::uint64_t>(end - begin) * total_steps * 2);
+        });
+
+        // --- PARALLEL REGION 2: all strikes of one expiry per iteration ---
+        PERF_SCOPE(HESTON_REDUCTION);
+        executor_->parallelFor(E, [&](std::size_t range_begin, std::size_t range_end, int worker) {
+            for (std::size_t e = range_begin; e < range_end; ++e) {
+                evaluateExpiry(e, contexts[e].discount, contexts[e].spot / m.spot, chain, worker);
+            }
+        });
+        return chain;
     }
 };
 
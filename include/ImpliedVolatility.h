@@ -2,6 +2,7 @@
 #define IMPLIED_VOLATILITY_H
 
 #include "BlackScholes.h"
+#include "Instrumentation.h"
 #include <cmath>
 #include <iostream>
 
@@ -18,9 +19,11 @@ public:
                             double epsilon = 1e-6,
                             int maxIterations = 100) {
         
+        PERF_SCOPE(IV_SOLVE);
         double sigma = initialGuess; // Start with a guess (e.g., 50%)
 
         for (int i = 0; i < maxIterations; ++i) {
+            PERF_COUNT(SOLVER_ITERATIONS, 1);
             // 1. Calculate Price and Vega with current sigma
             BlackScholes bs(spot, strike, rate, sigma, maturity, type);
             double price = bs.price();
@@ -45,6 +48,7 @@ public:
             sigma = sigma - (diff / vega);
         }
 
+        PERF_COUNT(SOLVER_FAILURES, 1);
         return -1.0; // Return -1 if failed to converge
     }
 };
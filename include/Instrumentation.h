@@ -0,0 +1,372 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+// Hot-path instrumentation for the pricing kernels.
+//
+// Build with -DPRICING_INSTRUMENTATION=1 (CMake: -DENABLE_INSTRUMENTATION=ON) to enable it.
+// When disabled, PERF_SCOPE / PERF_COUNT expand to nothing and the kernels carry no cost.
+// Counters and phase timers are kept in per-thread, cache-line-sized slots, so the
+// kernels never share a written cache line; snapshot() sums them on demand.
+
+#ifndef PRICING_INSTRUMENTATION
+#define PRICING_INSTRUMENTATION 0
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Instrumentation {
+
+// Timed phases of the kernels
+enum class Phase : int {
+    MC_RNG,
+    MC_PATHS,
+    MC_REDUCTION,
+    HESTON_RNG,
+    HESTON_PATHS,
+    HESTON_REDUCTION,
+    IV_SOLVE,
+    COUNT
+};
+
+// Event counters
+enum class Counter : int {
+    PATHS,
+    RNG_DRAWS,
+    SOLVER_ITERATIONS,
+    SOLVER_FAILURES,
+    CACHE_HITS,
+    CACHE_MISSES,
+    COUNT
+};
+
+const int NUM_PHASES = static_cast<int>(Phase::COUNT);
+const int NUM_COUNTERS = static_cast<int>(Counter::COUNT);
+const int MAX_THREADS = 256;
+
+inline const char* phaseName(Phase p) {
+    static const char* names[] = {"mc.rng", "mc.paths", "mc.reduction",
+                                  "heston.rng", "heston.paths", "heston.reduction", "iv.solve"};
+    return names[static_cast<int>(p)];
+}
+
+inline const char* counterName(Counter c) {
+    static const char* names[] = {"paths", "rng_draws", "solver_iterations", "solver_failures",
+                                  "cache_hits", "cache_misses"};
+    return names[static_cast<int>(c)];
+}
+
+// One slot per live thread, padded so two threads never write the same cache line.
+// A slot is released when its thread exits and reused by the next new thread, so its totals
+// keep accumulating across owners. The last slot is the overflow slot, shared by every thread
+// that finds all others owned (more than MAX_THREADS - 1 live threads).
+struct alignas(64) ThreadSlot {
+    std::atomic<std::uint64_t> counters[NUM_COUNTERS];
+    std::atomic<std::uint64_t> phaseNs[NUM_PHASES];
+    std::atomic<std::uint64_t> phaseCalls[NUM_PHASES];
+    std::atomic<bool> used;
+    std::atomic<bool> owned;    // Held by a live thread
+    bool shared = false;        // Overflow slot: several writers, updated with fetch_add
+};
+
+const int OVERFLOW_SLOT = MAX_THREADS - 1;
+
+struct Registry {
+    ThreadSlot slots[MAX_THREADS];
+
+    Registry() {
+        for (ThreadSlot& s : slots) {
+            s.used.store(false);
+            s.owned.store(false);
+        }
+        slots[OVERFLOW_SLOT].shared = true;
+        reset();
+    }
+
+    void reset() {
+        for (ThreadSlot& s : slots) {
+            for (auto& c : s.counters) c.store(0, std::memory_order_relaxed);
+            for (auto& t : s.phaseNs) t.store(0, std::memory_order_relaxed);
+            for (auto& t : s.phaseCalls) t.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+inline Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+// Owns a slot for the lifetime of its thread. The release on exit orders the thread's last
+// updates before those of the slot's next owner (which acquires it).
+class SlotLease {
+private:
+    ThreadSlot* slot_ = nullptr;
+
+public:
+    SlotLease() {
+        Registry& r = registry();
+        for (int i = 0; i < OVERFLOW_SLOT && !slot_; ++i) {
+            bool expected = false;
+            if (!r.slots[i].owned.load(std::memory_order_relaxed) &&
+                r.slots[i].owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                slot_ = &r.slots[i];
+            }
+        }
+        if (!slot_) slot_ = &r.slots[OVERFLOW_SLOT];
+        slot_->used.store(true);
+    }
+
+    ~SlotLease() {
+        if (!slot_->shared) slot_->owned.store(false, std::memory_order_release);
+    }
+
+    SlotLease(const SlotLease&) = delete;
+    SlotLease& operator=(const SlotLease&) = delete;
+
+    ThreadSlot& slot() const { return *slot_; }
+};
+
+// The calling thread's slot (assigned on first use, released when the thread exits)
+inline ThreadSlot& localSlot() {
+    thread_local SlotLease lease;
+    return lease.slot();
+}
+
+// An owned slot has a single writer: a relaxed load + store is enough and avoids a locked
+// instruction. The overflow slot has several and needs the atomic add.
+inline void bump(ThreadSlot& s, std::atomic<std::uint64_t>& a, std::uint64_t n) {
+    if (s.shared) a.fetch_add(n, std::memory_order_relaxed);
+    else a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+inline void add(Counter c, std::uint64_t n = 1) {
+    ThreadSlot& s = localSlot();
+    bump(s, s.counters[static_cast<int>(c)], n);
+}
+
+class ScopedTimer {
+private:
+    Phase phase_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    explicit ScopedTimer(Phase phase) : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+        ThreadSlot& s = localSlot();
+        bump(s, s.phaseNs[static_cast<int>(phase_)], static_cast<std::uint64_t>(ns));
+        bump(s, s.phaseCalls[static_cast<int>(phase_)], 1);
+    }
+};
+
+// ============================================================================
+// HARDWARE COUNTERS (Linux perf_event, optional)
+// ============================================================================
+
+struct HardwareSample {
+    bool valid = false;
+    std::uint64_t cycles = 0, instructions = 0, cacheMisses = 0, branchMisses = 0;
+};
+
+// Counts for the calling thread and every thread it creates afterwards.
+// Silently unavailable without permission (perf_event_paranoid) or off Linux.
+class HardwareCounters {
+private:
+    int fds_[4] = {-1, -1, -1, -1};
+
+public:
+    HardwareCounters() {
+#if defined(__linux__)
+        const std::uint64_t configs[4] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                          PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < 4; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds_[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~HardwareCounters() {
+#if defined(__linux__)
+        for (int fd : fds_) if (fd >= 0) close(fd);
+#endif
+    }
+
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+    bool available() const { return fds_[0] >= 0; }
+
+    void start() {
+#if defined(__linux__)
+        for (int fd : fds_) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    HardwareSample stop() {
+        HardwareSample s;
+#if defined(__linux__)
+        std::uint64_t v[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; ++i) {
+            if (fds_[i] < 0) continue;
+            ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fds_[i], &v[i], sizeof(v[i])) != static_cast<ssize_t>(sizeof(v[i]))) v[i] = 0;
+        }
+        s.valid = available();
+        s.cycles = v[0];
+        s.instructions = v[1];
+        s.cacheMisses = v[2];
+        s.branchMisses = v[3];
+#endif
+        return s;
+    }
+};
+
+// ============================================================================
+// SNAPSHOT
+// ============================================================================
+
+struct ThreadStats {
+    int slot;
+    std::array<std::uint64_t, NUM_COUNTERS> counters;
+    std::array<std::uint64_t, NUM_PHASES> phaseNs;
+};
+
+struct Snapshot {
+    std::array<std::uint64_t, NUM_COUNTERS> counters{};
+    std::array<std::uint64_t, NUM_PHASES> phaseNs{};
+    std::array<std::uint64_t, NUM_PHASES> phaseCalls{};
+    std::vector<ThreadStats> threads;  // Only slots that recorded something (a reused slot sums its owners)
+    HardwareSample hardware;           // Filled by the caller if it used HardwareCounters
+
+    std::uint64_t counter(Counter c) const { return counters[static_cast<int>(c)]; }
+    double phaseMs(Phase p) const { return phaseNs[static_cast<int>(p)] / 1e6; }
+
+    // max / mean of per-thread time spent in a phase (1.0 = perfectly balanced)
+    double imbalance(Phase p) const {
+        std::uint64_t max_ns = 0, sum_ns = 0;
+        int n = 0;
+        for (const ThreadStats& t : threads) {
+            std::uint64_t ns = t.phaseNs[static_cast<int>(p)];
+            if (ns == 0) continue;
+            max_ns = std::max(max_ns, ns);
+            sum_ns += ns;
+            ++n;
+        }
+        return (n == 0 || sum_ns == 0) ? 1.0 : static_cast<double>(max_ns) * n / sum_ns;
+    }
+
+    void print(std::ostream& os) const {
+        os << "Phase                 total ms     calls   imbalance\n";
+        for (int p = 0; p < NUM_PHASES; ++p) {
+            if (phaseCalls[p] == 0) continue;
+            os << "  " << std::left << std::setw(18) << phaseName(static_cast<Phase>(p)) << std::right
+               << std::fixed << std::setprecision(3) << std::setw(11) << phaseNs[p] / 1e6
+               << std::setw(10) << phaseCalls[p]
+               << std::setprecision(2) << std::setw(12) << imbalance(static_cast<Phase>(p)) << "\n";
+        }
+        os << "Counter               value\n";
+        for (int c = 0; c < NUM_COUNTERS; ++c) {
+            if (counters[c] == 0) continue;
+            os << "  " << std::left << std::setw(18) << counterName(static_cast<Counter>(c)) << std::right
+               << std::setw(14) << counters[c] << "\n";
+        }
+        if (hardware.valid) {
+            os << "Hardware: cycles " << hardware.cycles << ", instructions " << hardware.instructions
+               << " (IPC " << std::setprecision(2)
+               << (hardware.cycles ? static_cast<double>(hardware.instructions) / hardware.cycles : 0.0)
+               << "), cache misses " << hardware.cacheMisses << ", branch misses " << hardware.branchMisses << "\n";
+        }
+    }
+
+    std::string toJson() const {
+        std::ostringstream os;
+        os << "{\"phases_ms\": {";
+        for (int p = 0; p < NUM_PHASES; ++p) {
+            os << (p ? ", " : "") << "\"" << phaseName(static_cast<Phase>(p)) << "\": " << phaseNs[p] / 1e6;
+        }
+        os << "}, \"counters\": {";
+        for (int c = 0; c < NUM_COUNTERS; ++c) {
+            os << (c ? ", " : "") << "\"" << counterName(static_cast<Counter>(c)) << "\": " << counters[c];
+        }
+        os << "}, \"threads\": " << threads.size() << "}";
+        return os.str();
+    }
+};
+
+inline Snapshot snapshot() {
+    Snapshot snap;
+    Registry& r = registry();
+    for (int i = 0; i < MAX_THREADS; ++i) {
+        ThreadSlot& s = r.slots[i];
+        if (!s.used.load()) continue;
+        ThreadStats t;
+        t.slot = i;
+        bool any = false;
+        for (int c = 0; c < NUM_COUNTERS; ++c) {
+            t.counters[c] = s.counters[c].load(std::memory_order_relaxed);
+            snap.counters[c] += t.counters[c];
+            any = any || t.counters[c] != 0;
+        }
+        for (int p = 0; p < NUM_PHASES; ++p) {
+            t.phaseNs[p] = s.phaseNs[p].load(std::memory_order_relaxed);
+            snap.phaseNs[p] += t.phaseNs[p];
+            snap.phaseCalls[p] += s.phaseCalls[p].load(std::memory_order_relaxed);
+            any = any || t.phaseNs[p] != 0;
+        }
+        if (any) snap.threads.push_back(t);
+    }
+    return snap;
+}
+
+// Zeroes every slot (call while no kernel is running)
+inline void reset() {
+    registry().reset();
+}
+
+inline constexpr bool enabled() { return PRICING_INSTRUMENTATION != 0; }
+
+} // namespace Instrumentation
+
+#define PERF_CONCAT_INNER(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_INNER(a, b)
+
+#if PRICING_INSTRUMENTATION
+#define PERF_SCOPE(phase) Instrumentation::ScopedTimer PERF_CONCAT(perf_scope_, __LINE__)(Instrumentation::Phase::phase)
+#define PERF_COUNT(counter, n) Instrumentation::add(Instrumentation::Counter::counter, (n))
+#else
+#define PERF_SCOPE(phase) ((void)0)
+#define PERF_COUNT(counter, n) ((void)0)
+#endif
+
+#endif // INSTRUMENTATION_H
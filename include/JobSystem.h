@@ -0,0 +1,180 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Handed to a running job: tells it which generation it computes and whether a newer
+// submission has made it stale. Jobs poll cancelled() between stages (rows, refinement
+// levels) and return early; nothing is interrupted from the outside.
+class JobToken {
+private:
+    const std::atomic<std::uint64_t>* latest_;
+    std::uint64_t generation_;
+
+public:
+    JobToken(const std::atomic<std::uint64_t>& latest, std::uint64_t generation)
+        : latest_(&latest), generation_(generation) {}
+
+    std::uint64_t generation() const { return generation_; }
+    bool cancelled() const { return latest_->load(std::memory_order_acquire) != generation_; }
+};
+
+// Two copies of a result: the job fills the back one without any lock, publish() swaps
+// them under a short lock, and the reader looks at the front one under the same lock.
+// The render loop therefore never waits for a computation, only for a pointer swap.
+// One writer at a time (the JobRunner thread), any number of readers.
+template <typename T>
+class DoubleBuffer {
+private:
+    mutable std::mutex mutex_;
+    T buffers_[2];
+    int front_ = 0;
+    std::uint64_t generation_ = 0;  // Generation of the front result (0 = nothing published yet)
+    int level_ = -1;                // Refinement level of the front result
+    std::uint64_t version_ = 0;     // Bumped by every publish
+
+public:
+    // Writer side: the buffer to fill (never read until published)
+    T& back() { return buffers_[1 - front_]; }
+
+    // Makes the back buffer visible; the previous front becomes the next back buffer
+    void publish(std::uint64_t generation, int level) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        front_ = 1 - front_;
+        generation_ = generation;
+        level_ = level;
+        ++version_;
+    }
+
+    // Reader side: visit(front, generation, level) under the lock; keep it to a copy or a draw
+    template <typename Visit>
+    void read(Visit&& visit) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        visit(buffers_[front_], generation_, level_);
+    }
+
+    std::uint64_t version() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return version_;
+    }
+};
+
+// Runs jobs on one background thread, latest submission wins.
+// submit() bumps the generation, which marks the running job stale, and replaces any job
+// still waiting: a slider dragged across 60 frames queues one job, not 60. Heavy jobs
+// are expected to fan out on an Executor themselves; this thread only sequences them.
+class JobRunner {
+public:
+    using Job = std::function<void(const JobToken&)>;
+
+private:
+    std::atomic<std::uint64_t> generation_{0};
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    Job pending_;
+    std::uint64_t pending_generation_ = 0;
+    bool running_ = false;
+    bool stop_ = false;
+
+    std::uint64_t completed_ = 0;   // Jobs that ran to the end without being superseded
+    std::uint64_t superseded_ = 0;  // Jobs that started but were stale when they returned
+    std::uint64_t dropped_ = 0;     // Jobs replaced before they started
+
+    std::thread thread_;
+
+    void loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [&] { return stop_ || pending_; });
+            if (stop_) return;
+            Job job = std::move(pending_);
+            pending_ = nullptr;
+            JobToken token(generation_, pending_generation_);
+            running_ = true;
+            lock.unlock();
+
+            job(token);
+
+            lock.lock();
+            running_ = false;
+            if (token.cancelled()) ++superseded_;
+            else ++completed_;
+            if (!pending_) idle_.notify_all();
+        }
+    }
+
+public:
+    JobRunner() : thread_([this] { loop(); }) {}
+
+    ~JobRunner() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            generation_.fetch_add(1, std::memory_order_acq_rel);   // Lets a running job bail out
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+
+    JobRunner(const JobRunner&) = delete;
+    JobRunner& operator=(const JobRunner&) = delete;
+
+    // Schedules 'job' as the newest generation and returns that generation
+    std::uint64_t submit(Job job) {
+        std::uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            generation = generation_.fetch_add(1, std::memory_order_acq_rel) + 1;
+            if (pending_) ++dropped_;
+            pending_ = std::move(job);
+            pending_generation_ = generation;
+        }
+        wake_.notify_one();
+        return generation;
+    }
+
+    // Latest generation submitted
+    std::uint64_t generation() const { return generation_.load(std::memory_order_acquire); }
+
+    // Blocks until nothing is running or waiting (tests, shutdown); false on timeout
+    bool waitIdle(std::chrono::milliseconds timeout = std::chrono::milliseconds(60000)) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return idle_.wait_for(lock, timeout, [&] { return !running_ && !pending_; });
+    }
+
+    bool busy() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return running_ || pending_;
+    }
+
+    std::uint64_t completed() { std::lock_guard<std::mutex> lock(mutex_); return completed_; }
+    std::uint64_t superseded() { std::lock_guard<std::mutex> lock(mutex_); return superseded_; }
+    std::uint64_t dropped() { std::lock_guard<std::mutex> lock(mutex_); return dropped_; }
+};
+
+// Progressive publication: compute(level, out, token) fills the back buffer for levels
+// 0 .. levels-1 (coarse to fine) and each finished level is published at once, so the
+// reader shows a rough answer quickly and a refined one later. Stops as soon as the job
+// is stale; returns the number of levels published.
+template <typename T, typename Compute>
+int refineProgressively(DoubleBuffer<T>& buffer, const JobToken& token, int levels, Compute&& compute) {
+    int published = 0;
+    for (int level = 0; level < levels; ++level) {
+        if (token.cancelled()) break;
+        compute(level, buffer.back(), token);
+        if (token.cancelled()) break;   // Half-computed or outdated: never shown
+        buffer.publish(token.generation(), level);
+        ++published;
+    }
+    return published;
+}
+
+#endif // JOB_SYSTEM_H
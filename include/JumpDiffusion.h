@@ -0,0 +1,103 @@
+#ifndef JUMP_DIFFUSION_H
+#define JUMP_DIFFUSION_H
+
+#include "BlackScholes.h"
+#include "EuropeanOption.h"
+#include <algorithm>
+#include <cmath>
+
+// Lognormal jumps arriving as a Poisson process: at each jump log(S) moves by N(mean, stddev^2)
+struct JumpParams {
+    double intensity = 0.0;  // Jumps per year (lambda)
+    double mean = 0.0;       // Mean of the log-jump (mu_J)
+    double stddev = 0.0;     // Std dev of the log-jump (sigma_J)
+
+    bool active() const { return intensity > 0.0; }
+
+    // Mean relative jump size k = E[e^J] - 1 (the drift is compensated by -lambda * k)
+    double meanJump() const { return std::exp(mean + 0.5 * stddev * stddev) - 1.0; }
+
+    bool operator==(const JumpParams& o) const {
+        return intensity == o.intensity && mean == o.mean && stddev == o.stddev;
+    }
+    bool operator!=(const JumpParams& o) const { return !(*this == o); }
+};
+
+// Merton (1976) jump-diffusion, closed form.
+// The price is a Poisson-weighted series of Black-Scholes prices: conditional on n jumps
+// the terminal spot is lognormal with variance sigma^2 + n sigma_J^2 / T and an adjusted rate.
+// The series is cut adaptively, as soon as the Poisson tail mass left times the largest
+// possible term (the spot, for a call) falls below the tolerance.
+class MertonJumpDiffusion {
+private:
+    double spot_;          // Current stock price (S)
+    double strike_;        // Strike price (K)
+    double rate_;          // Risk-free interest rate (r)
+    double volatility_;    // Diffusive volatility (sigma)
+    double maturity_;      // Time to maturity (T)
+    OptionType type_;      // Call or Put
+    JumpParams jumps_;
+    double dividend_ = 0.0; // Continuous dividend yield (q)
+    double tolerance_;
+    int max_terms_;
+    mutable int terms_used_ = 0;
+
+public:
+    MertonJumpDiffusion(double spot, double strike, double rate, double volatility, double maturity,
+                        OptionType type, const JumpParams& jumps,
+                        double tolerance = 1e-10, int max_terms = 500)
+        : spot_(spot), strike_(strike), rate_(rate), volatility_(volatility), maturity_(maturity),
+          type_(type), jumps_(jumps), tolerance_(tolerance), max_terms_(max_terms) {}
+
+    // Constructor from an expiry's market context (curves and dividends already resolved)
+    MertonJumpDiffusion(const ExpiryContext& ctx, double strike, double volatility, OptionType type,
+                        const JumpParams& jumps, double tolerance = 1e-10, int max_terms = 500)
+        : MertonJumpDiffusion(ctx.spot, strike, ctx.rate, volatility, ctx.maturity, type, jumps, tolerance, max_terms) {
+        dividend_ = ctx.dividendYield;
+    }
+
+    // Call price by the series; the put follows from parity (E[S_T] = S e^((r-q)T) holds with jumps)
+    double price() const {
+        double call = callPrice();
+        if (type_ == OptionType::CALL) return call;
+        return call - spot_ * std::exp(-dividend_ * maturity_) + strike_ * std::exp(-rate_ * maturity_);
+    }
+
+    // Number of series terms used by the last price()
+    int termsUsed() const { return terms_used_; }
+
+private:
+    double callPrice() const {
+        if (!jumps_.active()) {
+            terms_used_ = 1;
+            return BlackScholes(spot_, strike_, rate_, volatility_, maturity_, OptionType::CALL, dividend_).price();
+        }
+
+        double T = maturity_;
+        double k = jumps_.meanJump();
+        double lambda_T = jumps_.intensity * (1.0 + k) * T;   // Poisson mean under the jump-adjusted measure
+        double log_jump = std::log(1.0 + k);
+        double var = volatility_ * volatility_;
+        double jump_var = jumps_.stddev * jumps_.stddev;
+
+        // Poisson weight of n jumps, updated recursively
+        double weight = std::exp(-lambda_T);
+        double mass = 0.0;
+        double total = 0.0;
+        int n = 0;
+        for (; n < max_terms_; ++n) {
+            double sigma_n = std::sqrt(var + n * jump_var / T);
+            double rate_n = rate_ - jumps_.intensity * k + n * log_jump / T;
+            total += weight * BlackScholes(spot_, strike_, rate_n, sigma_n, T, OptionType::CALL, dividend_).price();
+            mass += weight;
+
+            // Stop once past the mode and the remaining mass cannot move the price
+            if (n >= lambda_T && (1.0 - mass) * spot_ < tolerance_) break;
+            weight *= lambda_T / (n + 1);
+        }
+        terms_used_ = std::min(n + 1, max_terms_);
+        return total;
+    }
+};
+
+#endif // JUMP_DIFFUSION_H
@@ -0,0 +1,256 @@
+#ifndef MC_ACCUMULATOR_H
+#define MC_ACCUMULATOR_H
+
+#include "Utils.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// Exact sum of doubles.
+// Every double is an integer multiple of 2^-1074, so the running sum is kept as a
+// fixed-point integer in 32-bit digits (held in int64 limbs so carries can be deferred).
+// Addition is exact, hence associative and commutative: the same set of values gives the
+// same bits in any order or grouping. value() rounds once, to nearest even, from the
+// canonical digits.
+class ExactSum {
+public:
+    static constexpr int LIMBS = 68;          // 2176 bits: every double, plus 64 bits of headroom
+    static constexpr int LSB_EXPONENT = -1088;
+
+private:
+    std::int64_t limbs_[LIMBS];
+    double special_ = 0.0;      // Sum of the non-finite inputs (inf / NaN propagate)
+    std::uint32_t pending_ = 0; // Additions since the last carry propagation
+
+    static constexpr std::int64_t MASK = 0xFFFFFFFFll;
+
+    // Propagates carries: limbs 0 .. LIMBS-2 end in [0, 2^32), the top limb carries the sign
+    void normalize() {
+        for (int i = 0; i < LIMBS - 1; ++i) {
+            std::int64_t carry = limbs_[i] >= 0 ? limbs_[i] / (MASK + 1) : -((-limbs_[i] + MASK) / (MASK + 1));
+            limbs_[i] -= carry * (MASK + 1);
+            limbs_[i + 1] += carry;
+        }
+        pending_ = 0;
+    }
+
+public:
+    ExactSum() { std::memset(limbs_, 0, sizeof(limbs_)); }
+
+    void add(double x) {
+        if (!std::isfinite(x)) {
+            special_ += x;
+            return;
+        }
+        if (x == 0.0) return;
+        int exponent = 0;
+        double fraction = std::frexp(x, &exponent);
+        std::int64_t m = static_cast<std::int64_t>(std::ldexp(fraction, 53));   // x = m 2^(exponent - 53)
+        int position = exponent - 53 - LSB_EXPONENT;
+        if (position < 0) {
+            m /= (std::int64_t(1) << -position);   // Subnormal: the dropped bits are zero
+            position = 0;
+        }
+        const std::int64_t sign = m < 0 ? -1 : 1;
+        const std::uint64_t u = static_cast<std::uint64_t>(m < 0 ? -m : m);
+        const int limb = position / 32, shift = position % 32;
+        const std::uint64_t t0 = (u & MASK) << shift;
+        const std::uint64_t t1 = (u >> 32) << shift;
+        limbs_[limb] += sign * static_cast<std::int64_t>(t0 & MASK);
+        limbs_[limb + 1] += sign * static_cast<std::int64_t>((t0 >> 32) + (t1 & MASK));
+        limbs_[limb + 2] += sign * static_cast<std::int64_t>(t1 >> 32);
+        if (++pending_ == (1u << 28)) normalize();
+    }
+
+    void merge(const ExactSum& other) {
+        ExactSum o = other;
+        o.normalize();
+        normalize();
+        for (int i = 0; i < LIMBS; ++i) limbs_[i] += o.limbs_[i];
+        special_ += other.special_;
+        normalize();
+    }
+
+    // The exact sum rounded to a double (a function of the exact value only, not of the
+    // order in which it was accumulated)
+    double value() const {
+        if (special_ != 0.0 || std::isnan(special_)) return special_;
+        ExactSum s = *this;
+        s.normalize();
+        double sign = 1.0;
+        if (s.limbs_[LIMBS - 1] < 0) {
+            for (int i = 0; i < LIMBS; ++i) s.limbs_[i] = -s.limbs_[i];
+            s.normalize();
+            sign = -1.0;
+        }
+        int top = LIMBS - 1;
+        while (top >= 0 && s.limbs_[top] == 0) --top;
+        if (top < 0) return 0.0;
+
+        // Leading 64 bits of the magnitude as an integer; the bits below only set a sticky bit
+        int lead = 31;
+        while (!(s.limbs_[top] >> lead)) --lead;
+        const int low = 32 * top + lead - 63;   // Position of the head's lowest bit
+        std::uint64_t head = 0;
+        bool sticky = false;
+        for (int i = top; i >= 0; --i) {
+            const std::uint64_t digit = static_cast<std::uint64_t>(s.limbs_[i]);
+            const int base = 32 * i;
+            if (base >= low) {
+                head |= digit << (base - low);
+            } else if (base + 32 > low) {
+                head |= digit >> (low - base);
+                sticky = sticky || (digit & ((std::uint64_t(1) << (low - base)) - 1)) != 0;
+            } else {
+                sticky = sticky || digit != 0;
+            }
+        }
+
+        // Round to 53 bits, to nearest even. A result below 2^-1022 has at most 52 significant
+        // bits (every input is a multiple of 2^-1074), so the subnormal range never rounds twice.
+        std::uint64_t mantissa = head >> 11;
+        const std::uint64_t rest = head & 0x7FF;
+        if (rest > 0x400 || (rest == 0x400 && (sticky || (mantissa & 1)))) ++mantissa;
+        return sign * std::ldexp(static_cast<double>(mantissa), low + 11 + LSB_EXPONENT);
+    }
+
+    bool operator==(const ExactSum& o) const {
+        ExactSum a = *this, b = o;
+        a.normalize();
+        b.normalize();
+        return std::memcmp(a.limbs_, b.limbs_, sizeof(limbs_)) == 0 &&
+               std::memcmp(&special_, &o.special_, sizeof(double)) == 0;
+    }
+
+    // Canonical digits, for serialisation
+    void write(std::string& out) const {
+        ExactSum s = *this;
+        s.normalize();
+        out.append(reinterpret_cast<const char*>(s.limbs_), sizeof(limbs_));
+        out.append(reinterpret_cast<const char*>(&special_), sizeof(double));
+    }
+
+    static constexpr std::size_t SERIALIZED_SIZE = sizeof(std::int64_t) * LIMBS + sizeof(double);
+
+    void read(const char* in) {
+        std::memcpy(limbs_, in, sizeof(limbs_));
+        std::memcpy(&special_, in + sizeof(limbs_), sizeof(double));
+        pending_ = 0;
+    }
+};
+
+// Quantities accumulated per Monte Carlo sample
+enum class MCQuantity : int {
+    PRICE = 0,   // Discounted payoff
+    DELTA = 1,   // Pathwise delta
+    VEGA = 2     // Pathwise vega
+};
+
+// Mergeable, serialisable moments of a Monte Carlo run: sample count and, per quantity,
+// exact sums of x and x^2 (so count, mean and M2). Chunk results are added once, exactly,
+// so merging accumulators of any split of the chunks, in any order, gives the same bits as
+// accumulating all of them in one process.
+class MCAccumulator {
+public:
+    static constexpr int QUANTITIES = 3;
+
+private:
+    std::uint64_t count_ = 0;    // Samples (an antithetic pair counts as two)
+    std::uint64_t chunks_ = 0;   // Chunks accumulated
+    ExactSum sums_[QUANTITIES];
+    ExactSum squares_[QUANTITIES];
+
+    static constexpr char MAGIC[8] = {'M', 'C', 'A', 'C', 'C', 'U', 'M', '1'};
+
+public:
+    // Adds one chunk's compensated sums (QUANTITIES of each)
+    void addChunk(std::uint64_t samples, const NeumaierSum* sums, const NeumaierSum* squares) {
+        count_ += samples;
+        ++chunks_;
+        for (int q = 0; q < QUANTITIES; ++q) {
+            sums_[q].add(sums[q].value());
+            squares_[q].add(squares[q].value());
+        }
+    }
+
+    void merge(const MCAccumulator& other) {
+        count_ += other.count_;
+        chunks_ += other.chunks_;
+        for (int q = 0; q < QUANTITIES; ++q) {
+            sums_[q].merge(other.sums_[q]);
+            squares_[q].merge(other.squares_[q]);
+        }
+    }
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t chunks() const { return chunks_; }
+
+    double sum(MCQuantity q) const { return sums_[static_cast<int>(q)].value(); }
+
+    double mean(MCQuantity q) const {
+        return count_ ? sum(q) / static_cast<double>(count_) : 0.0;
+    }
+
+    // Sum of squared deviations from the mean
+    double m2(MCQuantity q) const {
+        if (count_ == 0) return 0.0;
+        double s = sum(q);
+        double m2 = squares_[static_cast<int>(q)].value() - s * s / static_cast<double>(count_);
+        return m2 > 0.0 ? m2 : 0.0;
+    }
+
+    double variance(MCQuantity q) const { return count_ ? m2(q) / static_cast<double>(count_) : 0.0; }
+    double stdError(MCQuantity q) const { return count_ ? std::sqrt(variance(q) / static_cast<double>(count_)) : 0.0; }
+
+    // Same pair as MonteCarloPricer::price(): {price, standard error}
+    std::pair<double, double> price() const { return {mean(MCQuantity::PRICE), stdError(MCQuantity::PRICE)}; }
+
+    bool operator==(const MCAccumulator& o) const {
+        if (count_ != o.count_ || chunks_ != o.chunks_) return false;
+        for (int q = 0; q < QUANTITIES; ++q) {
+            if (!(sums_[q] == o.sums_[q]) || !(squares_[q] == o.squares_[q])) return false;
+        }
+        return true;
+    }
+    bool operator!=(const MCAccumulator& o) const { return !(*this == o); }
+
+    // --- SERIALISATION ---
+    // Layout: magic | count | chunks | (sum, sum of squares) per quantity, canonical digits
+    static constexpr std::size_t SERIALIZED_SIZE =
+        sizeof(MAGIC) + 2 * sizeof(std::uint64_t) + 2 * QUANTITIES * ExactSum::SERIALIZED_SIZE;
+
+    std::string serialize() const {
+        std::string out;
+        out.reserve(SERIALIZED_SIZE);
+        out.append(MAGIC, sizeof(MAGIC));
+        out.append(reinterpret_cast<const char*>(&count_), sizeof(count_));
+        out.append(reinterpret_cast<const char*>(&chunks_), sizeof(chunks_));
+        for (int q = 0; q < QUANTITIES; ++q) {
+            sums_[q].write(out);
+            squares_[q].write(out);
+        }
+        return out;
+    }
+
+    static MCAccumulator deserialize(const std::string& bytes) {
+        if (bytes.size() != SERIALIZED_SIZE || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error("MCAccumulator: bad or truncated serialised accumulator");
+        }
+        MCAccumulator acc;
+        const char* p = bytes.data() + sizeof(MAGIC);
+        std::memcpy(&acc.count_, p, sizeof(acc.count_));
+        std::memcpy(&acc.chunks_, p + sizeof(acc.count_), sizeof(acc.chunks_));
+        p += 2 * sizeof(std::uint64_t);
+        for (int q = 0; q < QUANTITIES; ++q) {
+            acc.sums_[q].read(p);
+            acc.squares_[q].read(p + ExactSum::SERIALIZED_SIZE);
+            p += 2 * ExactSum::SERIALIZED_SIZE;
+        }
+        return acc;
+    }
+};
+
+#endif // MC_ACCUMULATOR_H
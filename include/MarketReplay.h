@@ -0,0 +1,413 @@
+#ifndef MARKET_REPLAY_H
+#define MARKET_REPLAY_H
+
+#include "BlackScholes.h"
+#include "Executor.h"
+#include "ImpliedVolatility.h"
+#include "SPSCQueue.h"
+#include "Utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+// One quote of the replayed day: underlying spot and the mid of one listed option
+struct MarketTick {
+    std::uint64_t seq = 0;
+    double timestamp = 0.0;   // Seconds since the open
+    double spot = 0.0;
+    double strike = 0.0;
+    double expiry = 0.0;      // Expiry in years from the open
+    double mid = 0.0;
+    OptionType type = OptionType::CALL;
+    std::int64_t arrival_ns = 0; // Stamped by the parser stage, used for latency
+
+    // Remaining life of the option at this tick (trading seconds -> years)
+    double maturity() const { return expiry - timestamp / (252.0 * 6.5 * 3600.0); }
+};
+
+// Output of the pricing stage for one tick
+struct TickResult {
+    MarketTick tick;
+    double impliedVol = -1.0; // -1 when the solver did not converge
+    double delta = 0.0;
+    double gamma = 0.0;
+    double vega = 0.0;
+};
+
+// ============================================================================
+// TICK SOURCES
+// ============================================================================
+
+class TickReader {
+public:
+    virtual ~TickReader() = default;
+    virtual bool next(MarketTick& tick) = 0;
+};
+
+// CSV quotes: timestamp,spot,strike,expiry,type,mid  (type is C or P, optional header line).
+// The header may only be the first line that is not blank or a comment; any other line that
+// does not hold the six fields is skipped and counted.
+class CsvTickReader : public TickReader {
+private:
+    std::ifstream in_;
+    std::string line_;
+    std::uint64_t seq_ = 0;
+    std::uint64_t malformed_ = 0;
+    bool firstLine_ = true;
+
+    // Reads one number ending at 'sep' and moves p past the separator
+    static bool field(const char*& p, char sep, double& value) {
+        char* end = nullptr;
+        value = std::strtod(p, &end);
+        if (end == p) return false;
+        if (sep == '\0') {
+            while (*end == ' ' || *end == '\r' || *end == '\t') ++end;
+        }
+        if (*end != sep) return false;
+        p = end + 1;
+        return true;
+    }
+
+    static bool parse(const char* p, MarketTick& tick) {
+        if (!field(p, ',', tick.timestamp) || !field(p, ',', tick.spot) ||
+            !field(p, ',', tick.strike) || !field(p, ',', tick.expiry)) {
+            return false;
+        }
+        if (*p == 'C' || *p == 'c') tick.type = OptionType::CALL;
+        else if (*p == 'P' || *p == 'p') tick.type = OptionType::PUT;
+        else return false;
+        if (*++p != ',') return false;
+        ++p;
+        return field(p, '\0', tick.mid);
+    }
+
+public:
+    explicit CsvTickReader(const std::string& path) : in_(path) {}
+
+    bool isOpen() const { return in_.is_open(); }
+    std::uint64_t malformed() const { return malformed_; }   // Lines skipped so far
+
+    bool next(MarketTick& tick) override {
+        while (std::getline(in_, line_)) {
+            if (line_.empty() || line_[0] == '#') continue; // blank or comment
+            bool first = firstLine_;
+            firstLine_ = false;
+            if (parse(line_.c_str(), tick)) {
+                tick.seq = seq_++;
+                return true;
+            }
+            // Header: a first line whose leading field is not a number
+            char* end = nullptr;
+            std::strtod(line_.c_str(), &end);
+            if (first && end == line_.c_str()) continue;
+            ++malformed_;
+        }
+        return false;
+    }
+};
+
+// Fixed-size binary records preceded by an 8-byte magic
+class BinaryTickReader : public TickReader {
+public:
+    static constexpr char MAGIC[8] = {'T', 'I', 'C', 'K', 'S', '0', '0', '1'};
+
+    struct Record {
+        double timestamp, spot, strike, expiry, mid;
+        std::int32_t type; // 0 = Call, 1 = Put
+        std::int32_t reserved;
+    };
+
+private:
+    std::ifstream in_;
+    std::uint64_t seq_ = 0;
+    bool valid_ = false;
+
+public:
+    explicit BinaryTickReader(const std::string& path) : in_(path, std::ios::binary) {
+        char magic[8] = {};
+        in_.read(magic, sizeof(magic));
+        valid_ = in_.good() && std::memcmp(magic, MAGIC, sizeof(magic)) == 0;
+    }
+
+    bool isOpen() const { return valid_; }
+
+    bool next(MarketTick& tick) override {
+        Record r;
+        if (!valid_ || !in_.read(reinterpret_cast<char*>(&r), sizeof(r))) return false;
+        tick.timestamp = r.timestamp;
+        tick.spot = r.spot;
+        tick.strike = r.strike;
+        tick.expiry = r.expiry;
+        tick.mid = r.mid;
+        tick.type = (r.type == 0) ? OptionType::CALL : OptionType::PUT;
+        tick.seq = seq_++;
+        return true;
+    }
+};
+
+// Replays ticks already held in memory
+class VectorTickReader : public TickReader {
+private:
+    const std::vector<MarketTick>& ticks_;
+    std::size_t pos_ = 0;
+
+public:
+    explicit VectorTickReader(const std::vector<MarketTick>& ticks) : ticks_(ticks) {}
+
+    bool next(MarketTick& tick) override {
+        if (pos_ >= ticks_.size()) return false;
+        tick = ticks_[pos_];
+        tick.seq = pos_++;
+        return true;
+    }
+};
+
+// ============================================================================
+// TICK FILES
+// ============================================================================
+
+class TickFiles {
+public:
+    // Synthetic day: GBM spot quoted on a small strike x expiry chain with a linear skew
+    static std::vector<MarketTick> generateDay(std::size_t num_ticks, double rate = 0.05, unsigned int seed = 42) {
+        std::vector<MarketTick> ticks(num_ticks);
+        RandomGenerator rng(seed);
+
+        const double day_seconds = 6.5 * 3600.0;
+        const double dt_years = 1.0 / (252.0 * num_ticks);
+        const double expiries[4] = {1.0 / 12.0, 0.25, 0.5, 1.0};
+        double spot = 100.0;
+
+        for (std::size_t i = 0; i < num_ticks; ++i) {
+            spot *= std::exp(-0.5 * 0.04 * dt_years + 0.2 * std::sqrt(dt_years) * rng.getNormal());
+
+            MarketTick& t = ticks[i];
+            t.seq = i;
+            t.timestamp = day_seconds * static_cast<double>(i) / num_ticks;
+            t.spot = spot;
+            t.strike = 90.0 + 2.5 * static_cast<double>(i % 9);
+            t.expiry = expiries[(i / 9) % 4];
+            t.type = ((i / 36) % 2 == 0) ? OptionType::CALL : OptionType::PUT;
+
+            double vol = 0.20 - 0.10 * std::log(t.strike / spot);
+            t.mid = BlackScholes(spot, t.strike, rate, vol, t.maturity(), t.type).price();
+        }
+        return ticks;
+    }
+
+    static bool writeCsv(const std::string& path, const std::vector<MarketTick>& ticks) {
+        std::ofstream out(path);
+        if (!out) return false;
+        out << "timestamp,spot,strike,expiry,type,mid\n";
+        out.precision(10);
+        for (const MarketTick& t : ticks) {
+            out << t.timestamp << ',' << t.spot << ',' << t.strike << ',' << t.expiry << ','
+                << (t.type == OptionType::CALL ? 'C' : 'P') << ',' << t.mid << '\n';
+        }
+        return true;
+    }
+
+    static bool writeBinary(const std::string& path, const std::vector<MarketTick>& ticks) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) return false;
+        out.write(BinaryTickReader::MAGIC, sizeof(BinaryTickReader::MAGIC));
+        for (const MarketTick& t : ticks) {
+            BinaryTickReader::Record r{t.timestamp, t.spot, t.strike, t.expiry, t.mid,
+                                       t.type == OptionType::CALL ? 0 : 1, 0};
+            out.write(reinterpret_cast<const char*>(&r), sizeof(r));
+        }
+        return true;
+    }
+};
+
+// ============================================================================
+// PIPELINE
+// ============================================================================
+
+struct ReplayConfig {
+    std::size_t batchSize = 256;        // Max ticks priced together
+    std::size_t queueCapacity = 1 << 16;
+    int pricingThreads = 0;             // 0 = default executor, otherwise a dedicated pool
+    double rate = 0.05;
+    double paceTicksPerSecond = 0.0;    // Offered load; 0 = replay as fast as possible
+};
+
+struct ReplayStats {
+    std::uint64_t ticks = 0;
+    std::uint64_t failedIV = 0;
+    double seconds = 0.0;
+    double ticksPerSecond = 0.0;
+    double p50Us = 0.0, p99Us = 0.0, p999Us = 0.0, maxUs = 0.0; // Per-tick latency (parsed -> written)
+    double hedgedPnl = 0.0;             // Sum of delta-hedged P&L over all contracts
+};
+
+// Parser -> [SPSC] -> batched pricing -> [SPSC] -> writer, each stage on its own thread.
+// The pricing stage fans each batch out to an executor.
+class ReplayPipeline {
+private:
+    ReplayConfig config_;
+    std::unique_ptr<Executor> ownedExecutor_;
+    Executor* executor_;
+
+    static std::int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static double percentile(const std::vector<std::int64_t>& sorted, double q) {
+        if (sorted.empty()) return 0.0;
+        std::size_t idx = static_cast<std::size_t>(q * (sorted.size() - 1));
+        return sorted[idx] / 1000.0;
+    }
+
+    void priceBatch(TickResult* batch, std::size_t n) const {
+        const double rate = config_.rate;
+        auto priceRange = [&](std::size_t begin, std::size_t end, int) {
+            for (std::size_t i = begin; i < end; ++i) {
+                TickResult& r = batch[i];
+                const MarketTick& t = r.tick;
+                double T = t.maturity();
+
+                r.impliedVol = ImpliedVolatility::calculate(t.mid, t.spot, t.strike, rate, T, t.type);
+                if (r.impliedVol > 0.0) {
+                    BlackScholes bs(t.spot, t.strike, rate, r.impliedVol, T, t.type);
+                    r.delta = bs.delta();
+                    r.gamma = bs.gamma();
+                    r.vega = bs.vega();
+                } else {
+                    // Slots are reused across batches: never leave the previous tick's Greeks
+                    r.delta = 0.0;
+                    r.gamma = 0.0;
+                    r.vega = 0.0;
+                }
+            }
+        };
+        // Small batches are not worth a fork/join
+        if (n > 16) executor_->parallelFor(n, priceRange);
+        else priceRange(0, n, 0);
+    }
+
+public:
+    explicit ReplayPipeline(const ReplayConfig& config = ReplayConfig())
+        : config_(config),
+          ownedExecutor_(config.pricingThreads > 0 ? new ThreadPoolExecutor(config.pricingThreads) : nullptr),
+          executor_(ownedExecutor_ ? ownedExecutor_.get() : &defaultExecutor()) {}
+
+    // Replays every tick of the reader; one CSV line per tick is written to out (if not null)
+    ReplayStats run(TickReader& reader, std::ostream* out = nullptr) {
+        SPSCQueue<MarketTick> tickQueue(config_.queueCapacity);
+        SPSCQueue<TickResult> resultQueue(config_.queueCapacity);
+        std::atomic<bool> parserDone{false};
+        std::atomic<bool> pricerDone{false};
+
+        ReplayStats stats;
+        std::vector<std::int64_t> latencies;
+        std::int64_t start = nowNs();
+
+        // --- STAGE 1: PARSER ---
+        std::thread parser([&]() {
+            MarketTick tick;
+            const double pace_ns = config_.paceTicksPerSecond > 0.0 ? 1e9 / config_.paceTicksPerSecond : 0.0;
+            std::uint64_t count = 0;
+            while (reader.next(tick)) {
+                if (pace_ns > 0.0) {
+                    // Release tick k at start + k / rate, so latency is measured under a fixed load
+                    std::int64_t due = start + static_cast<std::int64_t>(pace_ns * count++);
+                    while (nowNs() < due) std::this_thread::yield();
+                }
+                tick.arrival_ns = nowNs();
+                while (!tickQueue.tryPush(tick)) std::this_thread::yield();
+            }
+            parserDone.store(true, std::memory_order_release);
+        });
+
+        // --- STAGE 2: BATCHED PRICING ---
+        std::thread pricer([&]() {
+            std::vector<MarketTick> ticks(config_.batchSize);
+            std::vector<TickResult> results(config_.batchSize);
+            while (true) {
+                bool finished = parserDone.load(std::memory_order_acquire);
+                std::size_t n = tickQueue.popBatch(ticks.data(), ticks.size());
+                if (n == 0) {
+                    if (finished) break; // Parser done and queue drained
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (std::size_t i = 0; i < n; ++i) results[i].tick = ticks[i];
+                priceBatch(results.data(), n);
+                for (std::size_t i = 0; i < n; ++i) {
+                    while (!resultQueue.tryPush(results[i])) std::this_thread::yield();
+                }
+            }
+            pricerDone.store(true, std::memory_order_release);
+        });
+
+        // --- STAGE 3: WRITER (P&L needs per-contract history, so it stays sequential) ---
+        std::thread writer([&]() {
+            struct Position { double mid, spot, delta; };
+            std::map<std::tuple<double, double, int>, Position> book;
+            TickResult r;
+            if (out) *out << "seq,timestamp,spot,strike,expiry,type,mid,iv,delta,gamma,vega,pnl\n";
+
+            while (true) {
+                bool finished = pricerDone.load(std::memory_order_acquire);
+                if (!resultQueue.tryPop(r)) {
+                    if (finished) break;
+                    std::this_thread::yield();
+                    continue;
+                }
+                const MarketTick& t = r.tick;
+                double pnl = 0.0;
+                if (r.impliedVol > 0.0) {
+                    auto key = std::make_tuple(t.strike, t.expiry, static_cast<int>(t.type));
+                    auto it = book.find(key);
+                    if (it != book.end()) {
+                        // Long option, short delta: P&L over the last inter-tick interval
+                        pnl = (t.mid - it->second.mid) - it->second.delta * (t.spot - it->second.spot);
+                        it->second = {t.mid, t.spot, r.delta};
+                    } else {
+                        book.emplace(key, Position{t.mid, t.spot, r.delta});
+                    }
+                    stats.hedgedPnl += pnl;
+                } else {
+                    ++stats.failedIV;
+                }
+
+                if (out) {
+                    *out << t.seq << ',' << t.timestamp << ',' << t.spot << ',' << t.strike << ','
+                         << t.expiry << ',' << (t.type == OptionType::CALL ? 'C' : 'P') << ',' << t.mid << ','
+                         << r.impliedVol << ',' << r.delta << ',' << r.gamma << ',' << r.vega << ',' << pnl << '\n';
+                }
+                latencies.push_back(nowNs() - t.arrival_ns);
+            }
+        });
+
+        parser.join();
+        pricer.join();
+        writer.join();
+
+        stats.seconds = (nowNs() - start) * 1e-9;
+        stats.ticks = latencies.size();
+        stats.ticksPerSecond = stats.seconds > 0.0 ? stats.ticks / stats.seconds : 0.0;
+
+        std::sort(latencies.begin(), latencies.end());
+        stats.p50Us = percentile(latencies, 0.50);
+        stats.p99Us = percentile(latencies, 0.99);
+        stats.p999Us = percentile(latencies, 0.999);
+        stats.maxUs = latencies.empty() ? 0.0 : latencies.back() / 1000.0;
+        return stats;
+    }
+};
+
+#endif // MARKET_REPLAY_H
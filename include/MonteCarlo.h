@@ -1,37 +1,286 @@
 #ifndef MONTE_CARLO_H
 #define MONTE_CARLO_H
 
+#include "Arena.h"
 #include "EuropeanOption.h"
+#include "Executor.h"
+#include "Instrumentation.h"
+#include "MCAccumulator.h"
+#include "SimdMath.h"
+#include "TermStructure.h"
 #include "Utils.h"
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <vector>
 #include <iostream>
-#include <omp.h> // Header pour OpenMP
+
+// Résultats d'une échelle de spots (et éventuellement de strikes) évaluée sur les mêmes tirages.
+// Indexation : [k * spots.size() + i] pour le strike k et le spot i.
+struct SpotLadder {
+    std::vector<double> spots;
+    std::vector<double> strikes;
+    std::vector<double> prices;
+    std::vector<double> std_errors;
+    std::vector<double> deltas;   // Delta trajectoriel : dérivée exacte de l'estimateur en spot
+    std::vector<double> gammas;   // Gamma mixte vraisemblance / trajectoriel (Glasserman)
+
+    std::size_t index(std::size_t i, std::size_t k = 0) const { return k * spots.size() + i; }
+    double price(std::size_t i, std::size_t k = 0) const { return prices[index(i, k)]; }
+    double delta(std::size_t i, std::size_t k = 0) const { return deltas[index(i, k)]; }
+    double gamma(std::size_t i, std::size_t k = 0) const { return gammas[index(i, k)]; }
+};
 
 class MonteCarloPricer {
 private:
     int num_sims_;
     unsigned int seed_; // On stocke la graine de base pour la reproduction
+    Executor* executor_; // Où tournent les boucles parallèles (non possédé)
 
-public:
-    // Constructeur
-    MonteCarloPricer(int num_sims, unsigned int seed = 42)
-        : num_sims_(num_sims), seed_(seed) {}
+    // Mémoire de travail réutilisée d'un appel à l'autre (aucune allocation en régime établi)
+    WorkspacePool workspaces_;
+    std::vector<double> partial_sums_, partial_sq_sums_;
+    std::vector<NeumaierSum> chunk_sums_, chunk_sq_sums_;
 
-    // Permet de changer la seed (utile pour les calculs de Greeks)
-    void setSeed(unsigned int seed) { seed_ = seed; }
+    // Mode reproductible : résultat identique quel que soit le nombre de threads
+    bool deterministic_ = false;
+    int chunk_size_ = 4096;
 
-    // Méthode principale de pricing (Multithreadée)
-    std::pair<double, double> price(const Option& option, 
-                                    double spot, 
-                                    double rate, 
-                                    double volatility, 
-                                    bool use_antithetic = true) {
+    // Tirages générés d'un coup par price() (mode standard) : ne change que le découpage,
+    // pas les tirages ni l'ordre de sommation, donc pas le prix. Réglé par l'autotuner.
+    int block_size_;
+
+    // Accumulateurs par worker de accumulate() (fusion exacte, l'ordre est indifférent)
+    std::vector<MCAccumulator> worker_accumulators_;
+
+    // Précision de l'évolution des chemins (les payoffs sont toujours cumulés en double)
+    Precision precision_ = Precision::DOUBLE;
+
+    // Fonctions exp des noyaux : libm (référence) ou versions vectorisables (SimdMath.h)
+    MathPolicy math_ = MathPolicy::LIBM;
+
+    // Échelle de spots : tirages Z stockés une fois (une seule valeur par paire antithétique,
+    // les deux jambes exp(drift ± diffusion Z) sont recalculées), puis réévalués pour chaque spot
+    std::vector<double> ladder_draws_;
+    bool ladder_antithetic_ = false;
+    double ladder_drift_ = 0.0;
+    double ladder_diffusion_ = 0.0;
+    double ladder_discount_ = 1.0;
+    std::vector<double> ladder_partials_;
+
+    // Valeurs terminales S_T = spot * exp(drift + diffusion * Z) d'un bloc, calculées en Real.
+    // Boucle sans appel virtuel : avec un exp de SimdMath.h, le compilateur la vectorise
+    // (2x plus large en float) ; avec libm, exp reste un appel par chemin.
+    template <typename Math, typename Real>
+    static void terminalValues(const double* Z, int n, double spot, double drift, double diffusion, Real* out) {
+        const Real s = static_cast<Real>(spot);
+        const Real m = static_cast<Real>(drift);
+        const Real d = static_cast<Real>(diffusion);
+        SIMD_LOOP
+        for (int k = 0; k < n; ++k) out[k] = s * Math::exp(m + d * static_cast<Real>(Z[k]));
+    }
+
+    // Facteurs de croissance S_T / S_0 = exp(drift + diffusion * Z) d'un bloc, exp calculé en Real
+    template <typename Math, typename Real>
+    static void growthFactors(const double* Z, int n, double drift, double diffusion, double* out) {
+        const Real m = static_cast<Real>(drift);
+        const Real d = static_cast<Real>(diffusion);
+        SIMD_LOOP
+        for (int k = 0; k < n; ++k) out[k] = static_cast<double>(Math::exp(m + d * static_cast<Real>(Z[k])));
+    }
+
+    // Tampons de S_T d'un worker, dans la précision courante
+    struct TerminalBuffers {
+        double* d1 = nullptr;
+        double* d2 = nullptr;
+        float* f1 = nullptr;
+        float* f2 = nullptr;
+    };
+
+    TerminalBuffers allocateTerminals(Arena& arena, int size) const {
+        TerminalBuffers b;
+        if (precision_ == Precision::FLOAT) {
+            b.f1 = arena.allocate<float>(size);
+            b.f2 = arena.allocate<float>(size);
+        } else {
+            b.d1 = arena.allocate<double>(size);
+            b.d2 = arena.allocate<double>(size);
+        }
+        return b;
+    }
+
+    // Calcule S_T (et S_T antithétique) du bloc puis appelle visit(payoff1, payoff2) pour chaque itération
+    template <typename Visit>
+    void evaluateBlock(const Option& option, const double* Z, int n, double spot, double drift,
+                       double diffusion, bool use_antithetic, const TerminalBuffers& b, Visit&& visit) const {
+        auto run = [&](auto* ST1, auto* ST2) {
+            withMathPolicy(math_, [&](auto math) {
+                using Math = decltype(math);
+                terminalValues<Math>(Z, n, spot, drift, diffusion, ST1);
+                if (use_antithetic) terminalValues<Math>(Z, n, spot, drift, -diffusion, ST2);
+            });
+            for (int k = 0; k < n; ++k) {
+                double payoff1 = option.payoff(static_cast<double>(ST1[k]));
+                double payoff2 = use_antithetic ? option.payoff(static_cast<double>(ST2[k])) : 0.0;
+                visit(payoff1, payoff2);
+            }
+        };
+        if (precision_ == Precision::FLOAT) run(b.f1, b.f2);
+        else run(b.d1, b.d2);
+    }
+
+    // Prix actualisé et erreur standard à partir des sommes de payoffs
+    static std::pair<double, double> summarize(double sum_payoffs, double sum_sq_payoffs,
+                                               int actual_sims, double discount_factor) {
+        // Moyenne et actualisation
+        double mean_payoff = sum_payoffs / actual_sims;
+        double estimated_price = mean_payoff * discount_factor;
+
+        // Variance et erreur standard
+        double variance = (sum_sq_payoffs / actual_sims) - (mean_payoff * mean_payoff);
+        // Sécurité numérique : la variance ne peut pas être négative
+        if (variance < 0) variance = 0.0;
         
-        double T = option.getMaturity();
-        double drift = (rate - 0.5 * volatility * volatility) * T;
-        double diffusion = volatility * std::sqrt(T);
-        double discount_factor = std::exp(-rate * T);
+        double std_error = (std::sqrt(variance) / std::sqrt(actual_sims)) * discount_factor;
+
+        return {estimated_price, std_error};
+    }
+
+    // Version reproductible de price() :
+    //  - les itérations sont découpées en blocs de taille fixe (chunk_size_), indépendants du nombre de threads ;
+    //  - chaque bloc a son propre flux aléatoire CounterRNG(seed, numéro de bloc) ;
+    //  - chaque bloc accumule en sommation compensée (Neumaier) ;
+    //  - les blocs sont combinés par un arbre binaire dont l'ordre ne dépend que de leur numéro.
+    std::pair<double, double> priceDeterministic(const Option& option, double spot, double drift,
+                                                 double diffusion, double discount_factor,
+                                                 bool use_antithetic) {
+        int loops = use_antithetic ? (num_sims_ / 2) : num_sims_;
+        int actual_sims = use_antithetic ? (loops * 2) : num_sims_;
+        int num_chunks = (loops + chunk_size_ - 1) / chunk_size_;
+
+        chunk_sums_.assign(num_chunks, NeumaierSum());
+        chunk_sq_sums_.assign(num_chunks, NeumaierSum());
+        std::vector<NeumaierSum>& chunk_sums = chunk_sums_;
+        std::vector<NeumaierSum>& chunk_sq_sums = chunk_sq_sums_;
+        workspaces_.prepare(executor_->concurrency());
+
+        // L'ordonnancement n'influe pas sur le résultat : chaque bloc est calculé de façon autonome
+        executor_->parallelFor(num_chunks, [&](std::size_t first, std::size_t last, int worker) {
+            Arena& arena = workspaces_.arena(worker);
+            double* Z = arena.allocate<double>(chunk_size_);
+            TerminalBuffers terminals = allocateTerminals(arena, chunk_size_);
+
+            for (std::size_t c = first; c < last; ++c) {
+                int begin = static_cast<int>(c) * chunk_size_;
+                int n = std::min(chunk_size_, loops - begin);
+                CounterRNG rng(seed_, static_cast<std::uint64_t>(c));
+                {
+                    PERF_SCOPE(MC_RNG);
+                    for (int k = 0; k < n; ++k) Z[k] = rng.getNormal();
+                }
+
+                PERF_SCOPE(MC_PATHS);
+                NeumaierSum sum, sq_sum;
+                evaluateBlock(option, Z, n, spot, drift, diffusion, use_antithetic, terminals,
+                              [&](double payoff1, double payoff2) {
+                    sum.add(payoff1);
+                    sq_sum.add(payoff1 * payoff1);
+                    if (use_antithetic) {
+                        sum.add(payoff2);
+                        sq_sum.add(payoff2 * payoff2);
+                    }
+                });
+                chunk_sums[c] = sum;
+                chunk_sq_sums[c] = sq_sum;
+                PERF_COUNT(RNG_DRAWS, n);
+                PERF_COUNT(PATHS, use_antithetic ? 2 * n : n);
+            }
+        });
+
+        // Réduction en arbre : (0+1), (2+3), ... puis (01+23), ... — ordre fixé par les numéros de bloc
+        {
+            PERF_SCOPE(MC_REDUCTION);
+            for (int width = 1; width < num_chunks; width *= 2) {
+                for (int c = 0; c + width < num_chunks; c += 2 * width) {
+                    chunk_sums[c].merge(chunk_sums[c + width]);
+                    chunk_sq_sums[c].merge(chunk_sq_sums[c + width]);
+                }
+            }
+        }
+
+        if (num_chunks == 0) return {0.0, 0.0};
+        return summarize(chunk_sums[0].value(), chunk_sq_sums[0].value(), actual_sims, discount_factor);
+    }
+
+    // Accumulation des blocs [first, last) : mêmes blocs et mêmes flux CounterRNG(seed, bloc) que
+    // priceDeterministic(). Chaque bloc est sommé en Neumaier puis ajouté exactement à
+    // l'accumulateur de son worker : le résultat ne dépend que de l'ensemble des blocs.
+    MCAccumulator accumulateChunks(const Option& option, double spot, double drift, double volatility,
+                                   double T, double discount_factor, bool use_antithetic,
+                                   std::uint64_t first, std::uint64_t last) {
+        const std::uint64_t loops = use_antithetic ? (num_sims_ / 2) : num_sims_;
+        last = std::min(last, numChunks(use_antithetic));
+        MCAccumulator total;
+        if (first >= last) return total;
+
+        const double diffusion = volatility * std::sqrt(T);
+        const double sqrt_T = std::sqrt(T);
+        const double sign = (option.getType() == OptionType::CALL) ? 1.0 : -1.0;
+        const int workers = executor_->concurrency();
+        worker_accumulators_.assign(workers, MCAccumulator());
+        workspaces_.prepare(workers);
+
+        executor_->parallelFor(last - first, [&](std::size_t range_begin, std::size_t range_end, int worker) {
+            Arena& arena = workspaces_.arena(worker);
+            double* Z = arena.allocate<double>(chunk_size_);
+            MCAccumulator& acc = worker_accumulators_[worker];
+
+            for (std::size_t i = range_begin; i < range_end; ++i) {
+                const std::uint64_t c = first + i;
+                const int n = static_cast<int>(std::min<std::uint64_t>(chunk_size_, loops - c * chunk_size_));
+                CounterRNG rng(seed_, c);
+                {
+                    PERF_SCOPE(MC_RNG);
+                    for (int k = 0; k < n; ++k) Z[k] = rng.getNormal();
+                }
+
+                PERF_SCOPE(MC_PATHS);
+                // Par échantillon : prix actualisé, delta trajectoriel DF 1{ITM} ±S_T/S_0,
+                // vega trajectoriel DF 1{ITM} ±S_T (sqrt(T) Z - sigma T)
+                NeumaierSum sums[MCAccumulator::QUANTITIES], squares[MCAccumulator::QUANTITIES];
+                auto sample = [&](double z) {
+                    double ST = spot * std::exp(drift + diffusion * z);
+                    double payoff = option.payoff(ST);
+                    double itm = payoff > 0.0 ? sign * discount_factor * ST : 0.0;
+                    double values[MCAccumulator::QUANTITIES] = {
+                        discount_factor * payoff, itm / spot, itm * (sqrt_T * z - volatility * T)};
+                    for (int q = 0; q < MCAccumulator::QUANTITIES; ++q) {
+                        sums[q].add(values[q]);
+                        squares[q].add(values[q] * values[q]);
+                    }
+                };
+                for (int k = 0; k < n; ++k) {
+                    sample(Z[k]);
+                    if (use_antithetic) sample(-Z[k]);
+                }
+                acc.addChunk(use_antithetic ? 2 * n : n, sums, squares);
+                PERF_COUNT(RNG_DRAWS, n);
+                PERF_COUNT(PATHS, use_antithetic ? 2 * n : n);
+            }
+        });
+
+        PERF_SCOPE(MC_REDUCTION);
+        for (const MCAccumulator& acc : worker_accumulators_) total.merge(acc);
+        return total;
+    }
+
+    // Simulation de S_T = spot * exp(drift + diffusion * Z), drift et diffusion déjà intégrés sur [0, T]
+    std::pair<double, double> simulate(const Option& option, double spot, double drift, double diffusion,
+                                       double discount_factor, bool use_antithetic) {
+        if (deterministic_) {
+            return priceDeterministic(option, spot, drift, diffusion, discount_factor, use_antithetic);
+        }
         
         double sum_payoffs = 0.0;
         double sum_sq_payoffs = 0.0;
@@ -40,54 +289,320 @@ public:
         int loops = use_antithetic ? (num_sims_ / 2) : num_sims_;
         int actual_sims = use_antithetic ? (loops * 2) : num_sims_;
 
+        // Sommes partielles par worker, combinées dans l'ordre des workers après la zone parallèle
+        partial_sums_.assign(executor_->concurrency(), 0.0);
+        partial_sq_sums_.assign(executor_->concurrency(), 0.0);
+        std::vector<double>& partial_sums = partial_sums_;
+        std::vector<double>& partial_sq_sums = partial_sq_sums_;
+        workspaces_.prepare(executor_->concurrency());
+
         // --- DÉBUT DE la ZONE PARALLÈLE ---
-        // reduction(+:...) permet d'additionner les résultats de chaque thread à la fin sans conflit
-        #pragma omp parallel reduction(+:sum_payoffs, sum_sq_payoffs)
-        {
-            // CRITIQUE : Chaque thread doit avoir son propre générateur aléatoire
+        // Chaque worker reçoit une plage contiguë d'itérations (même découpage que schedule(static))
+        executor_->parallelFor(loops, [&](std::size_t range_begin, std::size_t range_end, int worker) {
+            // CRITIQUE : Chaque worker doit avoir son propre générateur aléatoire
             // Sinon, ils accèdent tous au même rng_ et créent des conflits (Data Race)
-            int thread_id = omp_get_thread_num();
-            RandomGenerator local_rng(seed_ + thread_id + 1); 
-
-            // Distribue les itérations de la boucle 'i' entre les différents threads disponibles
-            #pragma omp for
-            for (int i = 0; i < loops; ++i) {
-                double Z = local_rng.getNormal();
-                
-                // Chemin 1
-                double S_T1 = spot * std::exp(drift + diffusion * Z);
-                double payoff1 = option.payoff(S_T1);
-
-                if (use_antithetic) {
-                    // Chemin 2 (Antithétique)
-                    double S_T2 = spot * std::exp(drift + diffusion * (-Z));
-                    double payoff2 = option.payoff(S_T2);
-                    
-                    sum_payoffs += payoff1 + payoff2;
-                    sum_sq_payoffs += payoff1 * payoff1 + payoff2 * payoff2;
-                } else {
-                    sum_payoffs += payoff1;
-                    sum_sq_payoffs += payoff1 * payoff1;
+            RandomGenerator local_rng(seed_ + worker + 1); 
+
+            int begin = static_cast<int>(range_begin);
+            int end = static_cast<int>(range_end);
+
+            double local_sum = 0.0;
+            double local_sq_sum = 0.0;
+
+            // Les tirages sont générés par blocs, puis les chemins du bloc sont évalués
+            const int BLOCK = block_size_;
+            Arena& arena = workspaces_.arena(worker);
+            double* Z = arena.allocate<double>(BLOCK);
+            TerminalBuffers terminals = allocateTerminals(arena, BLOCK);
+            for (int b = begin; b < end; b += BLOCK) {
+                int n = std::min(BLOCK, end - b);
+                {
+                    PERF_SCOPE(MC_RNG);
+                    for (int k = 0; k < n; ++k) Z[k] = local_rng.getNormal();
                 }
+
+                PERF_SCOPE(MC_PATHS);
+                // Chemin 1 et chemin 2 (antithétique, -Z)
+                evaluateBlock(option, Z, n, spot, drift, diffusion, use_antithetic, terminals,
+                              [&](double payoff1, double payoff2) {
+                    if (use_antithetic) {
+                        local_sum += payoff1 + payoff2;
+                        local_sq_sum += payoff1 * payoff1 + payoff2 * payoff2;
+                    } else {
+                        local_sum += payoff1;
+                        local_sq_sum += payoff1 * payoff1;
+                    }
+                });
             }
-        } 
+
+            partial_sums[worker] = local_sum;
+            partial_sq_sums[worker] = local_sq_sum;
+            PERF_COUNT(RNG_DRAWS, end - begin);
+            PERF_COUNT(PATHS, use_antithetic ? 2 * (end - begin) : (end - begin));
+        });
         // --- FIN DE LA ZONE PARALLÈLE ---
 
-        // Moyenne et actualisation
-        double mean_payoff = sum_payoffs / actual_sims;
-        double estimated_price = mean_payoff * discount_factor;
+        {
+            PERF_SCOPE(MC_REDUCTION);
+            for (std::size_t t = 0; t < partial_sums.size(); ++t) {
+                sum_payoffs += partial_sums[t];
+                sum_sq_payoffs += partial_sq_sums[t];
+            }
+        }
 
-        // Variance et erreur standard
-        double variance = (sum_sq_payoffs / actual_sims) - (mean_payoff * mean_payoff);
-        // Sécurité numérique : la variance ne peut pas être négative
-        if (variance < 0) variance = 0.0;
+        return summarize(sum_payoffs, sum_sq_payoffs, actual_sims, discount_factor);
+    }
+
+    // Tirages de l'échelle : mêmes flux (seed_ + worker + 1, plages contiguës) que simulate(),
+    // donc le prix au spot s est celui de price() au même spot, à l'ordre de sommation près
+    void simulateLadder(double drift, double diffusion, double discount_factor, bool use_antithetic) {
+        int loops = use_antithetic ? (num_sims_ / 2) : num_sims_;
+        ladder_draws_.resize(loops);
+        ladder_antithetic_ = use_antithetic;
+        ladder_drift_ = drift;
+        ladder_diffusion_ = diffusion;
+        ladder_discount_ = discount_factor;
+        double* draws = ladder_draws_.data();
+
+        executor_->parallelFor(loops, [&](std::size_t range_begin, std::size_t range_end, int worker) {
+            RandomGenerator local_rng(seed_ + worker + 1);
+            PERF_SCOPE(MC_RNG);
+            for (std::size_t i = range_begin; i < range_end; ++i) draws[i] = local_rng.getNormal();
+            PERF_COUNT(RNG_DRAWS, range_end - range_begin);
+        });
+    }
+
+public:
+    // Constructeur
+    MonteCarloPricer(int num_sims, unsigned int seed = 42, Executor& executor = defaultExecutor())
+        : num_sims_(num_sims), seed_(seed), executor_(&executor), block_size_(machineTuning().mcBlockSize) {}
+
+    // Permet de changer la seed (utile pour les calculs de Greeks)
+    void setSeed(unsigned int seed) { seed_ = seed; }
+    unsigned int getSeed() const { return seed_; }
+
+    // Active le mode reproductible (blocs de 'chunk_size' itérations, réduction compensée en arbre).
+    // Le résultat est alors identique au bit près pour 1, 4 ou 32 threads.
+    void setDeterministic(bool enabled, int chunk_size = 4096) {
+        deterministic_ = enabled;
+        chunk_size_ = std::max(1, chunk_size);
+    }
+    bool isDeterministic() const { return deterministic_; }
+
+    // Précision des chemins : FLOAT pour l'indicatif (GUI, pré-trade), DOUBLE pour la référence
+    void setPrecision(Precision precision) { precision_ = precision; }
+    Precision getPrecision() const { return precision_; }
+
+    // Précision des fonctions exp des noyaux (price(), priceLadder()) : LIBM par défaut,
+    // PRECISE (quelques ulp, vectorisé), FAST (~1e-10 relatif, vectorisé)
+    void setMathPolicy(MathPolicy policy) { math_ = policy; }
+    MathPolicy getMathPolicy() const { return math_; }
+
+    // Taille des blocs de tirages de price() en mode standard (défaut : fichier de réglage de la machine)
+    void setBlockSize(int size) { block_size_ = std::max(1, size); }
+    int getBlockSize() const { return block_size_; }
+
+    // Choix de l'exécuteur (OpenMP, pool de threads, std::execution, série)
+    void setExecutor(Executor& executor) { executor_ = &executor; }
+    Executor& getExecutor() const { return *executor_; }
+
+    // Arènes de travail par worker (statistiques d'allocation)
+    const WorkspacePool& workspaces() const { return workspaces_; }
+
+    // Méthode principale de pricing (Multithreadée)
+    std::pair<double, double> price(const Option& option, 
+                                    double spot, 
+                                    double rate, 
+                                    double volatility, 
+                                    bool use_antithetic = true) {
         
-        double std_error = (std::sqrt(variance) / std::sqrt(actual_sims)) * discount_factor;
+        double T = option.getMaturity();
+        double drift = (rate - 0.5 * volatility * volatility) * T;
+        double diffusion = volatility * std::sqrt(T);
+        double discount_factor = std::exp(-rate * T);
+        return simulate(option, spot, drift, diffusion, discount_factor, use_antithetic);
+    }
 
-        return {estimated_price, std_error};
+    // Pricing avec courbes de taux et dividendes : le contexte de l'échéance (spot net des
+    // dividendes cash, taux zéro r(T), rendement q(T), actualisation) est calculé une fois par échéance
+    std::pair<double, double> price(const Option& option,
+                                    const ExpiryContext& ctx,
+                                    double volatility,
+                                    bool use_antithetic = true) {
+        double T = ctx.maturity;
+        double drift = (ctx.rate - ctx.dividendYield - 0.5 * volatility * volatility) * T;
+        double diffusion = volatility * std::sqrt(T);
+        return simulate(option, ctx.spot, drift, diffusion, ctx.discount, use_antithetic);
     }
     
     void setNumSimulations(int n) { num_sims_ = n; }
+    int getNumSimulations() const { return num_sims_; }
+
+    // --- ACCUMULATEURS FUSIONNABLES ---
+    static constexpr std::uint64_t ALL_CHUNKS = std::numeric_limits<std::uint64_t>::max();
+
+    // Nombre de blocs de chunk_size itérations : l'unité de découpage entre threads, processus
+    // ou machines pour accumulate()
+    std::uint64_t numChunks(bool use_antithetic = true) const {
+        std::uint64_t loops = use_antithetic ? (num_sims_ / 2) : num_sims_;
+        return (loops + chunk_size_ - 1) / chunk_size_;
+    }
+    int getChunkSize() const { return chunk_size_; }
+
+    // Moments (prix actualisé, delta et vega trajectoriels d'un payoff call/put) des blocs
+    // [first_chunk, last_chunk). Le bloc c tire toujours le flux CounterRNG(seed, c) : des
+    // accumulateurs calculés sur des plages disjointes (autres threads, processus, conteneurs)
+    // puis fusionnés sont identiques au bit près à celui du calcul complet.
+    MCAccumulator accumulate(const Option& option, double spot, double rate, double volatility,
+                             bool use_antithetic = true, std::uint64_t first_chunk = 0,
+                             std::uint64_t last_chunk = ALL_CHUNKS) {
+        double T = option.getMaturity();
+        return accumulateChunks(option, spot, (rate - 0.5 * volatility * volatility) * T, volatility, T,
+                                std::exp(-rate * T), use_antithetic, first_chunk, last_chunk);
+    }
+
+    MCAccumulator accumulate(const Option& option, const ExpiryContext& ctx, double volatility,
+                             bool use_antithetic = true, std::uint64_t first_chunk = 0,
+                             std::uint64_t last_chunk = ALL_CHUNKS) {
+        double T = ctx.maturity;
+        return accumulateChunks(option, ctx.spot, (ctx.rate - ctx.dividendYield - 0.5 * volatility * volatility) * T,
+                                volatility, T, ctx.discount, use_antithetic, first_chunk, last_chunk);
+    }
+
+    // --- ÉCHELLE DE SPOTS ---
+    // S_T est linéaire en S_0 pour un GBM : les tirages sont faits une fois, puis chaque spot
+    // (et chaque strike) ne coûte qu'une passe de payoff sur les rendements stockés. Tous les
+    // points partagent les mêmes tirages : la courbe est lisse et les différences finies sont
+    // en nombres aléatoires communs. Payoff vanille (call/put) de l'option, strikes par défaut
+    // réduits à celui de l'option. En Precision::FLOAT, les exp des facteurs de croissance sont
+    // calculés en float (comme les chemins de price()) ; les payoffs restent cumulés en double.
+    SpotLadder priceLadder(const Option& option,
+                           const std::vector<double>& spots,
+                           double rate,
+                           double volatility,
+                           bool use_antithetic = true,
+                           const std::vector<double>& strikes = {}) {
+        double T = option.getMaturity();
+        simulateLadder((rate - 0.5 * volatility * volatility) * T, volatility * std::sqrt(T),
+                       std::exp(-rate * T), use_antithetic);
+        return evaluateLadder(option.getType(), spots, strikes.empty() ? std::vector<double>{option.getStrike()} : strikes);
+    }
+
+    // Échelle avec courbes de taux et dividendes : dérive r(T) - q(T) et actualisation du contexte.
+    // Les spots sont des spots nets des dividendes cash (ctx.spot + choc) : la valeur actuelle des
+    // dividendes ne dépend pas du spot, donc les chocs et les grecques sont ceux du spot coté.
+    SpotLadder priceLadder(const Option& option,
+                           const std::vector<double>& spots,
+                           const ExpiryContext& ctx,
+                           double volatility,
+                           bool use_antithetic = true,
+                           const std::vector<double>& strikes = {}) {
+        double T = ctx.maturity;
+        simulateLadder((ctx.rate - ctx.dividendYield - 0.5 * volatility * volatility) * T, volatility * std::sqrt(T),
+                       ctx.discount, use_antithetic);
+        return evaluateLadder(option.getType(), spots, strikes.empty() ? std::vector<double>{option.getStrike()} : strikes);
+    }
+
+    // Réévalue les rendements du dernier priceLadder() pour d'autres spots/strikes, sans nouveau tirage
+    SpotLadder evaluateLadder(OptionType type, const std::vector<double>& spots, const std::vector<double>& strikes) {
+        SpotLadder ladder;
+        ladder.spots = spots;
+        ladder.strikes = strikes;
+        const std::size_t points = spots.size() * strikes.size();
+        const std::size_t loops = ladder_draws_.size();
+        const bool antithetic = ladder_antithetic_;
+        const std::size_t samples = antithetic ? 2 * loops : loops;
+        ladder.prices.assign(points, 0.0);
+        ladder.std_errors.assign(points, 0.0);
+        ladder.deltas.assign(points, 0.0);
+        ladder.gammas.assign(points, 0.0);
+        if (points == 0 || samples == 0) return ladder;
+
+        // Par worker et par point : somme des payoffs, des carrés, de g 1{ITM} et de Z 1{ITM}
+        const std::size_t stride = 4 * points;
+        const int workers = executor_->concurrency();
+        ladder_partials_.assign(static_cast<std::size_t>(workers) * stride, 0.0);
+        double* partials = ladder_partials_.data();
+        const double sign = (type == OptionType::CALL) ? 1.0 : -1.0;
+        const double* draws = ladder_draws_.data();
+        const double drift = ladder_drift_;
+        const double diffusion = ladder_diffusion_;
+        workspaces_.prepare(workers);
+
+        executor_->parallelFor(loops, [&](std::size_t range_begin, std::size_t range_end, int worker) {
+            const int BLOCK = 1024;
+            Arena& arena = workspaces_.arena(worker);
+            double* g1 = arena.allocate<double>(BLOCK);   // Facteurs de croissance S_T / S_0
+            double* g2 = arena.allocate<double>(BLOCK);   // Jambe antithétique (tirage -Z)
+            double* acc = partials + static_cast<std::size_t>(worker) * stride;
+
+            PERF_SCOPE(MC_PATHS);
+            for (std::size_t b = range_begin; b < range_end; b += BLOCK) {
+                int n = static_cast<int>(std::min<std::size_t>(BLOCK, range_end - b));
+                const double* Z = draws + b;
+                withMathPolicy(math_, [&](auto math) {
+                    using Math = decltype(math);
+                    if (precision_ == Precision::FLOAT) {
+                        growthFactors<Math, float>(Z, n, drift, diffusion, g1);
+                        if (antithetic) growthFactors<Math, float>(Z, n, drift, -diffusion, g2);
+                    } else {
+                        growthFactors<Math, double>(Z, n, drift, diffusion, g1);
+                        if (antithetic) growthFactors<Math, double>(Z, n, drift, -diffusion, g2);
+                    }
+                });
+                for (std::size_t p = 0; p < points; ++p) {
+                    const double s = spots[p % spots.size()];
+                    const double K = strikes[p / spots.size()];
+                    double sum = 0.0, sq_sum = 0.0, g_sum = 0.0, z_sum = 0.0;
+                    for (int k = 0; k < n; ++k) {
+                        double payoff = std::max(sign * (s * g1[k] - K), 0.0);
+                        double itm = payoff > 0.0 ? 1.0 : 0.0;
+                        sum += payoff;
+                        sq_sum += payoff * payoff;
+                        g_sum += itm * g1[k];
+                        z_sum += itm * Z[k];
+                    }
+                    if (antithetic) {
+                        for (int k = 0; k < n; ++k) {
+                            double payoff = std::max(sign * (s * g2[k] - K), 0.0);
+                            double itm = payoff > 0.0 ? 1.0 : 0.0;
+                            sum += payoff;
+                            sq_sum += payoff * payoff;
+                            g_sum += itm * g2[k];
+                            z_sum -= itm * Z[k];
+                        }
+                    }
+                    acc[4 * p] += sum;
+                    acc[4 * p + 1] += sq_sum;
+                    acc[4 * p + 2] += g_sum;
+                    acc[4 * p + 3] += z_sum;
+                }
+            }
+            PERF_COUNT(PATHS, (range_end - range_begin) * points * (antithetic ? 2 : 1));
+        });
+
+        PERF_SCOPE(MC_REDUCTION);
+        const double N = static_cast<double>(samples);
+        for (std::size_t p = 0; p < points; ++p) {
+            double sum = 0.0, sq_sum = 0.0, g_sum = 0.0, z_sum = 0.0;
+            for (int w = 0; w < workers; ++w) {
+                const double* acc = partials + static_cast<std::size_t>(w) * stride + 4 * p;
+                sum += acc[0];
+                sq_sum += acc[1];
+                g_sum += acc[2];
+                z_sum += acc[3];
+            }
+            const double s = spots[p % spots.size()];
+            const double K = strikes[p / spots.size()];
+            auto result = summarize(sum, sq_sum, static_cast<int>(samples), ladder_discount_);
+            ladder.prices[p] = result.first;
+            ladder.std_errors[p] = result.second;
+            // d/ds max(±(s g - K), 0) = ±g 1{ITM} ; gamma = DF E[±1{ITM} K Z] / (s^2 sigma sqrt(T))
+            ladder.deltas[p] = ladder_discount_ * sign * g_sum / N;
+            ladder.gammas[p] = diffusion > 0.0 ? ladder_discount_ * sign * K * z_sum / (N * s * s * diffusion) : 0.0;
+        }
+        return ladder;
+    }
 };
 
 #endif // MONTE_CARLO_H
\ No newline at end of file
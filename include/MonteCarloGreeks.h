@@ -11,34 +11,23 @@ private:
 
 public:
     // Constructor
-    MonteCarloGreeks(int num_sims, unsigned int seed = 42)
-        : pricer_(num_sims, seed), seed_(seed) {}
+    MonteCarloGreeks(int num_sims, unsigned int seed = 42, Executor& executor = defaultExecutor())
+        : pricer_(num_sims, seed, executor), seed_(seed) {}
 
-    // Calculate Delta using Central Difference + Common Random Numbers
+    // Calculate Delta using Central Difference + Common Random Numbers.
+    // Both bumped spots are evaluated on one simulation (spot ladder): the draws are
+    // those of the former up/down runs, so the estimate is unchanged at half the cost.
     double delta(const Option& option, double spot, double rate, double vol, double epsilon = 0.01) {
-        // 1. Reset Seed -> Calc UP
         pricer_.setSeed(seed_);
-        double p_up = pricer_.price(option, spot + epsilon, rate, vol, true).first;
-        
-        // 2. Reset Seed -> Calc DOWN (Critical!)
-        pricer_.setSeed(seed_);
-        double p_down = pricer_.price(option, spot - epsilon, rate, vol, true).first;
-        
-        return (p_up - p_down) / (2.0 * epsilon);
+        SpotLadder ladder = pricer_.priceLadder(option, {spot + epsilon, spot - epsilon}, rate, vol, true);
+        return (ladder.price(0) - ladder.price(1)) / (2.0 * epsilon);
     }
 
-    // Calculate Gamma
+    // Calculate Gamma (up, base and down spots from one simulation)
     double gamma(const Option& option, double spot, double rate, double vol, double epsilon = 0.01) {
         pricer_.setSeed(seed_);
-        double p_up = pricer_.price(option, spot + epsilon, rate, vol, true).first;
-        
-        pricer_.setSeed(seed_);
-        double p_base = pricer_.price(option, spot, rate, vol, true).first;
-        
-        pricer_.setSeed(seed_);
-        double p_down = pricer_.price(option, spot - epsilon, rate, vol, true).first;
-        
-        return (p_up - 2.0 * p_base + p_down) / (epsilon * epsilon);
+        SpotLadder ladder = pricer_.priceLadder(option, {spot + epsilon, spot, spot - epsilon}, rate, vol, true);
+        return (ladder.price(0) - 2.0 * ladder.price(1) + ladder.price(2)) / (epsilon * epsilon);
     }
 
     // Calculate Vega
@@ -0,0 +1,338 @@
+#ifndef MULTI_ASSET_MC_H
+#define MULTI_ASSET_MC_H
+
+#include "Arena.h"
+#include "Executor.h"
+#include "Instrumentation.h"
+#include "MultiAssetOption.h"
+#include "TermStructure.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// --- CORRELATION ---
+
+// Lower-triangular Cholesky factor of a symmetric n x n matrix (row-major).
+// Returns false if the matrix is not positive definite.
+inline bool choleskyFactor(const std::vector<double>& matrix, int n, std::vector<double>& lower) {
+    lower.assign(static_cast<std::size_t>(n) * n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            double sum = matrix[i * n + j];
+            for (int k = 0; k < j; ++k) sum -= lower[i * n + k] * lower[j * n + k];
+            if (i == j) {
+                if (sum <= 0.0) return false;
+                lower[i * n + i] = std::sqrt(sum);
+            } else {
+                lower[i * n + j] = sum / lower[j * n + j];
+            }
+        }
+    }
+    return true;
+}
+
+// Nearest valid correlation matrix by eigenvalue clipping: eigenvalues below 'floor' are
+// raised to it and the result is rescaled to a unit diagonal. Eigenvectors come from
+// cyclic Jacobi rotations (n is at most a few hundred, and this runs once per matrix).
+inline std::vector<double> repairCorrelation(const std::vector<double>& matrix, int n, double floor = 1e-8) {
+    std::vector<double> a(matrix);
+    std::vector<double> v(static_cast<std::size_t>(n) * n, 0.0);
+    for (int i = 0; i < n; ++i) v[i * n + i] = 1.0;
+
+    for (int sweep = 0; sweep < 100; ++sweep) {
+        double off = 0.0;
+        for (int p = 0; p < n; ++p)
+            for (int q = p + 1; q < n; ++q) off += a[p * n + q] * a[p * n + q];
+        if (off < 1e-22) break;
+
+        for (int p = 0; p < n; ++p) {
+            for (int q = p + 1; q < n; ++q) {
+                double apq = a[p * n + q];
+                if (std::abs(apq) < 1e-300) continue;
+                // Rotation zeroing a[p][q]
+                double tau = (a[q * n + q] - a[p * n + p]) / (2.0 * apq);
+                double t = (tau >= 0.0 ? 1.0 : -1.0) / (std::abs(tau) + std::sqrt(1.0 + tau * tau));
+                double c = 1.0 / std::sqrt(1.0 + t * t);
+                double s = t * c;
+                for (int k = 0; k < n; ++k) {
+                    double akp = a[k * n + p], akq = a[k * n + q];
+                    a[k * n + p] = c * akp - s * akq;
+                    a[k * n + q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < n; ++k) {
+                    double apk = a[p * n + k], aqk = a[q * n + k];
+                    a[p * n + k] = c * apk - s * aqk;
+                    a[q * n + k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < n; ++k) {
+                    double vkp = v[k * n + p], vkq = v[k * n + q];
+                    v[k * n + p] = c * vkp - s * vkq;
+                    v[k * n + q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    // C = V diag(max(lambda, floor)) V^T, then D^-1/2 C D^-1/2
+    std::vector<double> repaired(static_cast<std::size_t>(n) * n, 0.0);
+    for (int k = 0; k < n; ++k) {
+        double lambda = std::max(a[k * n + k], floor);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j) repaired[i * n + j] += v[i * n + k] * lambda * v[j * n + k];
+    }
+    std::vector<double> scale(n);
+    for (int i = 0; i < n; ++i) scale[i] = 1.0 / std::sqrt(repaired[i * n + i]);
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) repaired[i * n + j] *= scale[i] * scale[j];
+    return repaired;
+}
+
+// --- PRICER ---
+
+// Correlated GBM Monte Carlo on several underlyings.
+//
+// setCorrelation() factorises the correlation matrix once (repairing it first if it is not
+// positive definite). price() then runs paths in tiles: the independent normals of a tile
+// are drawn into the worker's arena, each path's correlated shocks are one lower-triangular
+// mat-vec against the factor (which stays in cache across the tile), and the payoff reads
+// the terminal spots of the path. Paths are split across the executor's workers.
+class MultiAssetPricer {
+private:
+    int num_sims_;
+    unsigned int seed_;
+    Executor* executor_;      // Runs the path loop (not owned)
+    int tile_paths_ = 64;     // Paths drawn and correlated together
+
+    // Correlation factor
+    int num_assets_ = 0;
+    std::vector<double> lower_;
+    std::vector<double> correlation_;
+    bool repaired_ = false;
+    double repair_distance_ = 0.0; // Frobenius distance between the input and the repaired matrix
+
+    // Scratch reused across calls (no heap allocation once warmed up)
+    WorkspacePool workspaces_;
+    std::vector<double> partial_sums_, partial_sq_sums_;
+    std::vector<double> drift_, diffusion_;
+    std::vector<double> carry_, start_;
+
+    void checkSizes(const MultiAssetOption& option, std::size_t spots, std::size_t volatilities) const {
+        const int n = num_assets_;
+        if (n == 0) throw std::logic_error("MultiAssetPricer: setCorrelation() was not called");
+        if (option.numAssets() != n || static_cast<int>(spots) != n || static_cast<int>(volatilities) != n) {
+            throw std::invalid_argument("MultiAssetPricer: option, spots and volatilities must match the correlation size");
+        }
+    }
+
+    // Paths of the assets from 'spots', each drifting at its own carry r - q_i
+    std::pair<double, double> simulate(const MultiAssetOption& option, const std::vector<double>& spots,
+                                       const std::vector<double>& volatilities, const std::vector<double>& carries,
+                                       double discount_factor, bool use_antithetic) {
+        const int n = num_assets_;
+        double T = option.getMaturity();
+        drift_.resize(n);
+        diffusion_.resize(n);
+        for (int i = 0; i < n; ++i) {
+            drift_[i] = (carries[i] - 0.5 * volatilities[i] * volatilities[i]) * T;
+            diffusion_[i] = volatilities[i] * std::sqrt(T);
+        }
+
+        int loops = use_antithetic ? (num_sims_ / 2) : num_sims_;
+        int actual_sims = use_antithetic ? (loops * 2) : num_sims_;
+
+        partial_sums_.assign(executor_->concurrency(), 0.0);
+        partial_sq_sums_.assign(executor_->concurrency(), 0.0);
+        workspaces_.prepare(executor_->concurrency());
+        const int P = tile_paths_;
+        const double* L = lower_.data();
+
+        // --- PARALLEL REGION (one contiguous range of paths per worker) ---
+        executor_->parallelFor(loops, [&](std::size_t range_begin, std::size_t range_end, int worker) {
+            RandomGenerator rng(seed_ + worker + 1);
+            int begin = static_cast<int>(range_begin);
+            int end = static_cast<int>(range_end);
+
+            // Tile workspace, path-major: Z[p * n + i] independent, W[p * n + i] correlated
+            Arena& arena = workspaces_.arena(worker);
+            double* Z = arena.allocate<double>(static_cast<std::size_t>(P) * n);
+            double* W = arena.allocate<double>(static_cast<std::size_t>(P) * n);
+            double* ST = arena.allocate<double>(n);
+            double local_sum = 0.0;
+            double local_sq_sum = 0.0;
+
+            for (int b = begin; b < end; b += P) {
+                int m = std::min(P, end - b);
+                {
+                    PERF_SCOPE(MC_RNG);
+                    for (int k = 0; k < m * n; ++k) Z[k] = rng.getNormal();
+                }
+
+                PERF_SCOPE(MC_PATHS);
+                // Correlated shocks: W_p = L Z_p
+                for (int p = 0; p < m; ++p) {
+                    const double* z = Z + p * n;
+                    double* w = W + p * n;
+                    for (int i = 0; i < n; ++i) {
+                        const double* Li = L + i * n;
+                        double acc = 0.0;
+                        for (int j = 0; j <= i; ++j) acc += Li[j] * z[j];
+                        w[i] = acc;
+                    }
+                }
+
+                for (int p = 0; p < m; ++p) {
+                    const double* w = W + p * n;
+                    for (int i = 0; i < n; ++i) ST[i] = spots[i] * std::exp(drift_[i] + diffusion_[i] * w[i]);
+                    double payoff1 = option.payoff(ST);
+                    local_sum += payoff1;
+                    local_sq_sum += payoff1 * payoff1;
+
+                    if (use_antithetic) {
+                        for (int i = 0; i < n; ++i) ST[i] = spots[i] * std::exp(drift_[i] - diffusion_[i] * w[i]);
+                        double payoff2 = option.payoff(ST);
+                        local_sum += payoff2;
+                        local_sq_sum += payoff2 * payoff2;
+                    }
+                }
+            }
+
+            partial_sums_[worker] = local_sum;
+            partial_sq_sums_[worker] = local_sq_sum;
+            PERF_COUNT(RNG_DRAWS, static_cast<std::uint64_t>(end - begin) * n);
+            PERF_COUNT(PATHS, use_antithetic ? 2 * (end - begin) : (end - begin));
+        });
+
+        double sum_payoffs = 0.0, sum_sq_payoffs = 0.0;
+        {
+            PERF_SCOPE(MC_REDUCTION);
+            for (std::size_t t = 0; t < partial_sums_.size(); ++t) {
+                sum_payoffs += partial_sums_[t];
+                sum_sq_payoffs += partial_sq_sums_[t];
+            }
+        }
+        if (actual_sims == 0) return {0.0, 0.0};
+
+        double mean_payoff = sum_payoffs / actual_sims;
+        double variance = std::max(sum_sq_payoffs / actual_sims - mean_payoff * mean_payoff, 0.0);
+        return {mean_payoff * discount_factor, std::sqrt(variance / actual_sims) * discount_factor};
+    }
+
+public:
+    MultiAssetPricer(int num_sims, unsigned int seed = 42, Executor& executor = defaultExecutor())
+        : num_sims_(num_sims), seed_(seed), executor_(&executor) {}
+
+    // Row-major num_assets x num_assets correlation matrix. It is symmetrised; if it is not
+    // positive definite, the nearest valid correlation matrix is used instead.
+    void setCorrelation(const std::vector<double>& matrix, int num_assets) {
+        if (num_assets <= 0 || matrix.size() != static_cast<std::size_t>(num_assets) * num_assets) {
+            throw std::invalid_argument("MultiAssetPricer: correlation matrix must be num_assets x num_assets");
+        }
+        int n = num_assets;
+        std::vector<double> c(matrix.size());
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) c[i * n + j] = (i == j) ? 1.0 : 0.5 * (matrix[i * n + j] + matrix[j * n + i]);
+        }
+
+        repaired_ = !choleskyFactor(c, n, lower_);
+        repair_distance_ = 0.0;
+        if (repaired_) {
+            std::vector<double> fixed = repairCorrelation(c, n);
+            for (std::size_t k = 0; k < c.size(); ++k) repair_distance_ += (fixed[k] - c[k]) * (fixed[k] - c[k]);
+            repair_distance_ = std::sqrt(repair_distance_);
+            c.swap(fixed);
+            if (!choleskyFactor(c, n, lower_)) {
+                throw std::runtime_error("MultiAssetPricer: correlation repair failed");
+            }
+        }
+        correlation_.swap(c);
+        num_assets_ = n;
+    }
+
+    // Single correlation for every pair
+    void setUniformCorrelation(int num_assets, double rho) {
+        std::vector<double> c(static_cast<std::size_t>(num_assets) * num_assets, rho);
+        setCorrelation(c, num_assets);
+    }
+
+    int numAssets() const { return num_assets_; }
+    bool correlationRepaired() const { return repaired_; }
+    double repairDistance() const { return repair_distance_; }
+    const std::vector<double>& correlation() const { return correlation_; }
+    const std::vector<double>& choleskyLower() const { return lower_; }
+
+    void setSeed(unsigned int seed) { seed_ = seed; }
+    void setNumSimulations(int n) { num_sims_ = n; }
+    void setExecutor(Executor& executor) { executor_ = &executor; }
+    void setTilePaths(int paths) { tile_paths_ = std::max(1, paths); }
+    int getTilePaths() const { return tile_paths_; }
+    const WorkspacePool& workspaces() const { return workspaces_; }
+
+    // Discounted price and standard error. spots/volatilities have one entry per asset.
+    std::pair<double, double> price(const MultiAssetOption& option,
+                                    const std::vector<double>& spots,
+                                    const std::vector<double>& volatilities,
+                                    double rate,
+                                    bool use_antithetic = true) {
+        checkSizes(option, spots.size(), volatilities.size());
+        carry_.assign(spots.size(), rate);
+        return simulate(option, spots, volatilities, carry_, std::exp(-rate * option.getMaturity()), use_antithetic);
+    }
+
+    // Same with a continuous dividend yield per asset
+    std::pair<double, double> price(const MultiAssetOption& option,
+                                    const std::vector<double>& spots,
+                                    const std::vector<double>& volatilities,
+                                    double rate,
+                                    const std::vector<double>& dividendYields,
+                                    bool use_antithetic = true) {
+        checkSizes(option, spots.size(), volatilities.size());
+        if (dividendYields.size() != spots.size()) {
+            throw std::invalid_argument("MultiAssetPricer: one dividend yield per asset");
+        }
+        carry_.resize(spots.size());
+        for (std::size_t i = 0; i < spots.size(); ++i) carry_[i] = rate - dividendYields[i];
+        return simulate(option, spots, volatilities, carry_, std::exp(-rate * option.getMaturity()), use_antithetic);
+    }
+
+    // On curves: one context per asset at the option's expiry (escrowed spot, r(T), q_i(T)).
+    // The assets share the discount curve, so the contexts must agree on the discount factor.
+    std::pair<double, double> price(const MultiAssetOption& option,
+                                    const std::vector<ExpiryContext>& contexts,
+                                    const std::vector<double>& volatilities,
+                                    bool use_antithetic = true) {
+        checkSizes(option, contexts.size(), volatilities.size());
+        start_.resize(contexts.size());
+        carry_.resize(contexts.size());
+        for (std::size_t i = 0; i < contexts.size(); ++i) {
+            if (contexts[i].maturity != option.getMaturity() || contexts[i].discount != contexts[0].discount) {
+                throw std::invalid_argument("MultiAssetPricer: contexts must share the option's expiry and discount");
+            }
+            start_[i] = contexts[i].spot;
+            carry_[i] = contexts[i].rate - contexts[i].dividendYield;
+        }
+        return simulate(option, start_, volatilities, carry_, contexts[0].discount, use_antithetic);
+    }
+
+    // Same from the shared yield curve and each asset's dividends, quoted at 'spots'
+    std::pair<double, double> price(const MultiAssetOption& option,
+                                    const std::vector<double>& spots,
+                                    const std::vector<double>& volatilities,
+                                    const YieldCurve& rates,
+                                    const std::vector<DividendCurve>& dividends,
+                                    bool use_antithetic = true) {
+        checkSizes(option, spots.size(), volatilities.size());
+        if (dividends.size() != spots.size()) {
+            throw std::invalid_argument("MultiAssetPricer: one dividend curve per asset");
+        }
+        std::vector<ExpiryContext> contexts;
+        for (std::size_t i = 0; i < spots.size(); ++i) {
+            contexts.push_back(makeExpiryContext(spots[i], option.getMaturity(), rates, dividends[i]));
+        }
+        return price(option, contexts, volatilities, use_antithetic);
+    }
+};
+
+#endif // MULTI_ASSET_MC_H
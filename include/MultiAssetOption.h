@@ -0,0 +1,88 @@
+#ifndef MULTI_ASSET_OPTION_H
+#define MULTI_ASSET_OPTION_H
+
+#include "Option.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+// Abstract base class for options written on several underlyings.
+// Mirrors Option, with the payoff taking the terminal spots of all assets.
+class MultiAssetOption {
+protected:
+    double strike_;           // Strike (K)
+    double maturity_;         // Time to maturity in years (T)
+    OptionType type_;         // Type: Call or Put
+    int num_assets_;          // Number of underlyings the payoff reads
+
+    double vanilla(double underlying) const {
+        return (type_ == OptionType::CALL) ? std::max(underlying - strike_, 0.0)
+                                           : std::max(strike_ - underlying, 0.0);
+    }
+
+public:
+    MultiAssetOption(double strike, double maturity, OptionType type, int num_assets)
+        : strike_(strike), maturity_(maturity), type_(type), num_assets_(num_assets) {}
+
+    virtual ~MultiAssetOption() = default;
+
+    // Payoff given the terminal spots spots[0 .. numAssets()-1]
+    virtual double payoff(const double* spots) const = 0;
+
+    // Getters
+    double getStrike() const { return strike_; }
+    double getMaturity() const { return maturity_; }
+    OptionType getType() const { return type_; }
+    int numAssets() const { return num_assets_; }
+};
+
+// Basket option: call/put on sum_i w_i * S_i
+class BasketOption : public MultiAssetOption {
+private:
+    std::vector<double> weights_;
+
+public:
+    BasketOption(double strike, double maturity, OptionType type, const std::vector<double>& weights)
+        : MultiAssetOption(strike, maturity, type, static_cast<int>(weights.size())), weights_(weights) {}
+
+    double payoff(const double* spots) const override {
+        double basket = 0.0;
+        for (int i = 0; i < num_assets_; ++i) basket += weights_[i] * spots[i];
+        return vanilla(basket);
+    }
+
+    const std::vector<double>& getWeights() const { return weights_; }
+};
+
+// Spread option: call/put on S_0 - S_1 (strike 0 is the Margrabe exchange option)
+class SpreadOption : public MultiAssetOption {
+public:
+    SpreadOption(double strike, double maturity, OptionType type)
+        : MultiAssetOption(strike, maturity, type, 2) {}
+
+    double payoff(const double* spots) const override {
+        return vanilla(spots[0] - spots[1]);
+    }
+};
+
+// Worst-of option: call/put on min_i S_i / R_i, the worst performance against reference
+// levels R_i (usually the spots at inception); the strike is a performance (e.g. 1.0)
+class WorstOfOption : public MultiAssetOption {
+private:
+    std::vector<double> inverse_references_;
+
+public:
+    WorstOfOption(double strike, double maturity, OptionType type, const std::vector<double>& references)
+        : MultiAssetOption(strike, maturity, type, static_cast<int>(references.size())) {
+        if (references.empty()) throw std::invalid_argument("WorstOfOption: no underlyings");
+        for (double r : references) inverse_references_.push_back(1.0 / r);
+    }
+
+    double payoff(const double* spots) const override {
+        double worst = spots[0] * inverse_references_[0];
+        for (int i = 1; i < num_assets_; ++i) worst = std::min(worst, spots[i] * inverse_references_[i]);
+        return vanilla(worst);
+    }
+};
+
+#endif // MULTI_ASSET_OPTION_H
@@ -0,0 +1,453 @@
+#ifndef OPTION_BOOK_H
+#define OPTION_BOOK_H
+
+#include "BatchPricer.h"
+#include "EuropeanOption.h"
+#include "Executor.h"
+#include "HestonMC.h"
+#include "Instrumentation.h"
+#include "JumpDiffusion.h"
+#include "TermStructure.h"
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Model used to revalue a trade
+enum class PricingModel {
+    BLACK_SCHOLES,
+    HESTON,
+    MERTON,     // Black-Scholes volatility + jumps (closed-form series)
+    BATES       // Heston + jumps (Monte Carlo)
+};
+
+// Market quantities a trade can depend on
+enum class MarketField {
+    SPOT,
+    VOLATILITY,
+    HESTON_PARAMS,
+    JUMP_PARAMS,
+    DIVIDENDS,
+    RATE
+};
+
+// Heston dynamics of one underlying
+struct HestonParams {
+    double v0 = 0.04;     // Initial Variance
+    double kappa = 2.0;   // Mean Reversion Speed
+    double theta = 0.04;  // Long-run Variance
+    double xi = 0.1;      // Vol-of-Vol
+    double rho = -0.7;    // Spot/Vol Correlation
+
+    bool operator==(const HestonParams& o) const {
+        return v0 == o.v0 && kappa == o.kappa && theta == o.theta && xi == o.xi && rho == o.rho;
+    }
+    bool operator!=(const HestonParams& o) const { return !(*this == o); }
+};
+
+// A position on a European option
+struct Trade {
+    std::string underlying;
+    double strike;
+    double maturity;
+    OptionType type;
+    PricingModel model = PricingModel::BLACK_SCHOLES;
+    double quantity = 1.0;
+};
+
+// Last computed valuation of a trade (Greeks are only filled for Black-Scholes trades)
+struct TradeResult {
+    double price = 0.0;
+    double delta = 0.0;
+    double gamma = 0.0;
+    double vega = 0.0;
+};
+
+// Dependency-tracked option book.
+// Each trade registers the market quantities it reads; a market update only marks
+// the dependent trades dirty, and reprice() revalues the dirty set in one batch.
+class OptionBook {
+private:
+    struct Underlying {
+        std::string name;
+        double spot;
+        double volatility;
+        HestonParams heston;
+        JumpParams jumps;
+        DividendCurve dividends;
+    };
+
+    std::vector<Underlying> underlyings_;
+    std::unordered_map<std::string, std::size_t> underlyingIndex_;
+    YieldCurve rates_;
+
+    std::vector<Trade> trades_;
+    std::vector<std::size_t> tradeUnderlying_;
+    std::vector<TradeResult> results_;
+
+    // dependents_[field][underlying] -> trades reading that quantity (RATE uses slot 0)
+    std::vector<std::vector<std::size_t>> dependents_[6];
+
+    std::vector<char> dirty_;
+    std::vector<std::size_t> dirtyList_;
+    std::vector<std::size_t> lastRepriced_;
+
+    int hestonSims_ = 5000;
+    int hestonSteps_ = 50;
+
+    Executor* executor_ = &defaultExecutor();
+
+    std::size_t indexOf(const std::string& name) const {
+        auto it = underlyingIndex_.find(name);
+        if (it == underlyingIndex_.end()) {
+            throw std::invalid_argument("OptionBook: unknown underlying '" + name + "'");
+        }
+        return it->second;
+    }
+
+    void markDirty(std::size_t trade) {
+        if (!dirty_[trade]) {
+            dirty_[trade] = 1;
+            dirtyList_.push_back(trade);
+        }
+    }
+
+    // Models revalued by Monte Carlo on the Heston parameters
+    static bool isSimulated(PricingModel model) {
+        return model == PricingModel::HESTON || model == PricingModel::BATES;
+    }
+
+    void markDependents(MarketField field, std::size_t underlying) {
+        for (std::size_t trade : dependents_[static_cast<int>(field)][underlying]) {
+            markDirty(trade);
+        }
+    }
+
+    // Market context per (underlying, expiry), rebuilt by each reprice() and shared by the
+    // trades of that expiry
+    std::map<std::pair<std::size_t, double>, ExpiryContext> expiryCache_;
+
+    const ExpiryContext& expiryContext(std::size_t underlying, double maturity) {
+        auto key = std::make_pair(underlying, maturity);
+        auto it = expiryCache_.find(key);
+        if (it == expiryCache_.end()) {
+            const Underlying& u = underlyings_[underlying];
+            it = expiryCache_.emplace(key, makeExpiryContext(u.spot, maturity, rates_, u.dividends)).first;
+        }
+        return it->second;
+    }
+
+public:
+    explicit OptionBook(double rate = 0.05) : rates_(rate) {
+        dependents_[static_cast<int>(MarketField::RATE)].resize(1);
+    }
+
+    // --- MARKET DATA ---
+
+    void addUnderlying(const std::string& name, double spot, double volatility,
+                       const HestonParams& heston = HestonParams(), const JumpParams& jumps = JumpParams()) {
+        if (underlyingIndex_.count(name)) {
+            throw std::invalid_argument("OptionBook: duplicate underlying '" + name + "'");
+        }
+        underlyingIndex_[name] = underlyings_.size();
+        underlyings_.push_back({name, spot, volatility, heston, jumps, DividendCurve()});
+        for (int f = 0; f < static_cast<int>(MarketField::RATE); ++f) dependents_[f].emplace_back();
+    }
+
+    // Setters return true when the value actually changed (and dependents were marked dirty)
+    bool setSpot(const std::string& name, double spot) {
+        std::size_t u = indexOf(name);
+        if (underlyings_[u].spot == spot) return false;
+        underlyings_[u].spot = spot;
+        markDependents(MarketField::SPOT, u);
+        return true;
+    }
+
+    bool setVolatility(const std::string& name, double volatility) {
+        std::size_t u = indexOf(name);
+        if (underlyings_[u].volatility == volatility) return false;
+        underlyings_[u].volatility = volatility;
+        markDependents(MarketField::VOLATILITY, u);
+        return true;
+    }
+
+    bool setHestonParams(const std::string& name, const HestonParams& heston) {
+        std::size_t u = indexOf(name);
+        if (underlyings_[u].heston == heston) return false;
+        underlyings_[u].heston = heston;
+        markDependents(MarketField::HESTON_PARAMS, u);
+        return true;
+    }
+
+    bool setJumpParams(const std::string& name, const JumpParams& jumps) {
+        std::size_t u = indexOf(name);
+        if (underlyings_[u].jumps == jumps) return false;
+        underlyings_[u].jumps = jumps;
+        markDependents(MarketField::JUMP_PARAMS, u);
+        return true;
+    }
+
+    bool setDividends(const std::string& name, const DividendCurve& dividends) {
+        std::size_t u = indexOf(name);
+        if (underlyings_[u].dividends == dividends) return false;
+        underlyings_[u].dividends = dividends;
+        markDependents(MarketField::DIVIDENDS, u);
+        return true;
+    }
+
+    // Flat rate (shorthand for a one-pillar yield curve)
+    bool setRate(double rate) {
+        return setYieldCurve(YieldCurve::flat(rate));
+    }
+
+    bool setYieldCurve(const YieldCurve& rates) {
+        if (rates_ == rates) return false;
+        rates_ = rates;
+        markDependents(MarketField::RATE, 0);
+        return true;
+    }
+
+    // Simulation budget used for Heston and Bates trades
+    void setHestonSimulation(int num_sims, int num_steps) {
+        hestonSims_ = num_sims;
+        hestonSteps_ = num_steps;
+        for (std::size_t i = 0; i < trades_.size(); ++i) {
+            if (isSimulated(trades_[i].model)) markDirty(i);
+        }
+    }
+
+    // Executor for the batch kernel and the Heston trades. Each Heston simulation is given
+    // the same executor, so nested path loops run inline instead of oversubscribing.
+    void setExecutor(Executor& executor) { executor_ = &executor; }
+
+    // --- TRADES ---
+
+    // Registers the trade's dependencies and returns its index. New trades start dirty.
+    std::size_t addTrade(const Trade& trade) {
+        std::size_t u = indexOf(trade.underlying);
+        std::size_t id = trades_.size();
+
+        trades_.push_back(trade);
+        tradeUnderlying_.push_back(u);
+        results_.emplace_back();
+        dirty_.push_back(0);
+
+        dependents_[static_cast<int>(MarketField::SPOT)][u].push_back(id);
+        dependents_[static_cast<int>(MarketField::DIVIDENDS)][u].push_back(id);
+        dependents_[static_cast<int>(MarketField::RATE)][0].push_back(id);
+        if (isSimulated(trade.model)) {
+            dependents_[static_cast<int>(MarketField::HESTON_PARAMS)][u].push_back(id);
+        } else {
+            dependents_[static_cast<int>(MarketField::VOLATILITY)][u].push_back(id);
+        }
+        if (trade.model == PricingModel::MERTON || trade.model == PricingModel::BATES) {
+            dependents_[static_cast<int>(MarketField::JUMP_PARAMS)][u].push_back(id);
+        }
+
+        markDirty(id);
+        return id;
+    }
+
+    // --- REPRICING ---
+
+    // Revalues every dirty trade and returns how many were repriced
+    std::size_t reprice() {
+        PERF_COUNT(CACHE_HITS, trades_.size() - dirtyList_.size());
+        PERF_COUNT(CACHE_MISSES, dirtyList_.size());
+
+        expiryCache_.clear();
+        std::vector<std::size_t> bsTrades;
+        std::vector<std::size_t> mertonTrades;
+        std::vector<std::size_t> hestonTrades;
+        for (std::size_t id : dirtyList_) {
+            if (isSimulated(trades_[id].model)) hestonTrades.push_back(id);
+            else if (trades_[id].model == PricingModel::MERTON) mertonTrades.push_back(id);
+            else bsTrades.push_back(id);
+        }
+
+        // 1. Black-Scholes trades: gather into columns and run the batch kernel
+        std::size_t n = bsTrades.size();
+        if (n > 0) {
+            std::vector<double> spot(n), strike(n), rate(n), dividend(n), vol(n), maturity(n);
+            std::vector<OptionType> type(n);
+            std::vector<double> price(n), delta(n), gamma(n), vega(n);
+
+            for (std::size_t k = 0; k < n; ++k) {
+                const Trade& t = trades_[bsTrades[k]];
+                const Underlying& u = underlyings_[tradeUnderlying_[bsTrades[k]]];
+                const ExpiryContext& ctx = expiryContext(tradeUnderlying_[bsTrades[k]], t.maturity);
+                spot[k] = ctx.spot;
+                rate[k] = ctx.rate;
+                dividend[k] = ctx.dividendYield;
+                vol[k] = u.volatility;
+                strike[k] = t.strike;
+                maturity[k] = t.maturity;
+                type[k] = t.type;
+            }
+
+            OptionBatch batch;
+            batch.size = n;
+            batch.spot = spot.data();
+            batch.strike = strike.data();
+            batch.rate = rate.data();
+            batch.volatility = vol.data();
+            batch.maturity = maturity.data();
+            batch.type = type.data();
+            batch.dividend = dividend.data();
+            BatchPricer::priceBlackScholes(batch, {price.data(), delta.data(), gamma.data(), vega.data()}, *executor_);
+
+            for (std::size_t k = 0; k < n; ++k) {
+                results_[bsTrades[k]] = {price[k], delta[k], gamma[k], vega[k]};
+            }
+        }
+
+        // 2. Merton trades: grouped by underlying, each group is one batch sharing its jump parameters
+        std::size_t m = mertonTrades.size();
+        if (m > 0) {
+            std::sort(mertonTrades.begin(), mertonTrades.end(), [&](std::size_t a, std::size_t b) {
+                return tradeUnderlying_[a] < tradeUnderlying_[b];
+            });
+            std::vector<double> spot(m), strike(m), rate(m), dividend(m), vol(m), maturity(m), price(m);
+            std::vector<OptionType> type(m);
+            for (std::size_t k = 0; k < m; ++k) {
+                const Trade& t = trades_[mertonTrades[k]];
+                const Underlying& u = underlyings_[tradeUnderlying_[mertonTrades[k]]];
+                const ExpiryContext& ctx = expiryContext(tradeUnderlying_[mertonTrades[k]], t.maturity);
+                spot[k] = ctx.spot;
+                rate[k] = ctx.rate;
+                dividend[k] = ctx.dividendYield;
+                vol[k] = u.volatility;
+                strike[k] = t.strike;
+                maturity[k] = t.maturity;
+                type[k] = t.type;
+            }
+
+            for (std::size_t begin = 0; begin < m;) {
+                std::size_t u = tradeUnderlying_[mertonTrades[begin]];
+                std::size_t end = begin;
+                while (end < m && tradeUnderlying_[mertonTrades[end]] == u) ++end;
+
+                OptionBatch batch;
+                batch.size = end - begin;
+                batch.spot = spot.data() + begin;
+                batch.strike = strike.data() + begin;
+                batch.rate = rate.data() + begin;
+                batch.volatility = vol.data() + begin;
+                batch.maturity = maturity.data() + begin;
+                batch.type = type.data() + begin;
+                batch.dividend = dividend.data() + begin;
+                GreeksBatch out;
+                out.price = price.data() + begin;
+                BatchPricer::priceMerton(batch, underlyings_[u].jumps, out, *executor_);
+                begin = end;
+            }
+
+            for (std::size_t k = 0; k < m; ++k) {
+                TradeResult res;
+                res.price = price[k];
+                results_[mertonTrades[k]] = res;
+            }
+        }
+
+        // 3. Heston trades: grouped by underlying (which carries the Heston parameters), each group
+        // is one chain: a single set of paths through all of its expiries, every strike read off
+        // the sorted terminal spots
+        std::vector<std::size_t> batesTrades;
+        std::vector<std::size_t> chainTrades;
+        for (std::size_t id : hestonTrades) {
+            if (trades_[id].model == PricingModel::BATES) batesTrades.push_back(id);
+            else chainTrades.push_back(id);
+        }
+        std::sort(chainTrades.begin(), chainTrades.end(), [&](std::size_t a, std::size_t b) {
+            return tradeUnderlying_[a] < tradeUnderlying_[b];
+        });
+        for (std::size_t begin = 0; begin < chainTrades.size();) {
+            std::size_t u = tradeUnderlying_[chainTrades[begin]];
+            std::size_t end = begin;
+            while (end < chainTrades.size() && tradeUnderlying_[chainTrades[end]] == u) ++end;
+
+            std::vector<double> expiries, strikes;
+            for (std::size_t k = begin; k < end; ++k) {
+                expiries.push_back(trades_[chainTrades[k]].maturity);
+                strikes.push_back(trades_[chainTrades[k]].strike);
+            }
+            std::sort(expiries.begin(), expiries.end());
+            expiries.erase(std::unique(expiries.begin(), expiries.end()), expiries.end());
+            std::sort(strikes.begin(), strikes.end());
+            strikes.erase(std::unique(strikes.begin(), strikes.end()), strikes.end());
+
+            std::vector<ExpiryContext> contexts;
+            for (double T : expiries) contexts.push_back(expiryContext(u, T));
+            const HestonParams& h = underlyings_[u].heston;
+            HestonPricer pricer(hestonSims_, hestonSteps_, *executor_);
+            HestonChain chain = pricer.priceChain(contexts, h.v0, h.kappa, h.theta, h.xi, h.rho, strikes);
+
+            for (std::size_t k = begin; k < end; ++k) {
+                const Trade& t = trades_[chainTrades[k]];
+                std::size_t e = std::lower_bound(expiries.begin(), expiries.end(), t.maturity) - expiries.begin();
+                std::size_t j = std::lower_bound(strikes.begin(), strikes.end(), t.strike) - strikes.begin();
+                TradeResult res;
+                res.price = (t.type == OptionType::CALL) ? chain.call(e, j) : chain.put(e, j);
+                results_[chainTrades[k]] = res;
+            }
+            begin = end;
+        }
+
+        // 4. Bates trades: one simulation per trade (the chain has no per-segment jump counts),
+        // trades spread across threads
+        std::vector<ExpiryContext> batesContexts;
+        for (std::size_t id : batesTrades) batesContexts.push_back(expiryContext(tradeUnderlying_[id], trades_[id].maturity));
+        executor_->parallelFor(batesTrades.size(), [&](std::size_t begin, std::size_t end, int) {
+            for (std::size_t k = begin; k < end; ++k) {
+                std::size_t id = batesTrades[k];
+                const Trade& t = trades_[id];
+                const Underlying& u = underlyings_[tradeUnderlying_[id]];
+                const HestonParams& h = u.heston;
+
+                EuropeanOption option(t.strike, t.maturity, t.type);
+                HestonPricer pricer(hestonSims_, hestonSteps_, *executor_);
+                pricer.setJumps(u.jumps);
+                TradeResult res;
+                res.price = pricer.price(option, batesContexts[k], h.v0, h.kappa, h.theta, h.xi, h.rho);
+                results_[id] = res;
+            }
+        });
+
+        for (std::size_t id : dirtyList_) dirty_[id] = 0;
+        std::size_t repriced = dirtyList_.size();
+        lastRepriced_.swap(dirtyList_);
+        dirtyList_.clear();
+        return repriced;
+    }
+
+    // --- ACCESSORS ---
+
+    std::size_t size() const { return trades_.size(); }
+    std::size_t dirtyCount() const { return dirtyList_.size(); }
+    const std::vector<std::size_t>& lastRepriced() const { return lastRepriced_; }   // Trades of the last reprice()
+    bool isDirty(std::size_t trade) const { return dirty_[trade] != 0; }
+    const Trade& trade(std::size_t id) const { return trades_[id]; }
+    const TradeResult& result(std::size_t id) const { return results_[id]; }
+    double getRate() const { return rates_.zeroRate(0.0); }   // Level of a flat curve
+    const YieldCurve& getYieldCurve() const { return rates_; }
+    const DividendCurve& getDividends(const std::string& name) const { return underlyings_[indexOf(name)].dividends; }
+    double getSpot(const std::string& name) const { return underlyings_[indexOf(name)].spot; }
+    double getVolatility(const std::string& name) const { return underlyings_[indexOf(name)].volatility; }
+    const HestonParams& getHestonParams(const std::string& name) const { return underlyings_[indexOf(name)].heston; }
+    const JumpParams& getJumpParams(const std::string& name) const { return underlyings_[indexOf(name)].jumps; }
+
+    // Quantity-weighted value of the book (from the last reprice)
+    double bookValue() const {
+        double total = 0.0;
+        for (std::size_t i = 0; i < trades_.size(); ++i) {
+            total += trades_[i].quantity * results_[i].price;
+        }
+        return total;
+    }
+};
+
+#endif // OPTION_BOOK_H
@@ -0,0 +1,231 @@
+#ifndef PRICING_PROTOCOL_H
+#define PRICING_PROTOCOL_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Binary protocol of the pricing server.
+// Both directions carry fixed-size 48-byte little-endian frames, so a reader never has to
+// parse lengths. Requests may be pipelined; responses come back when their batch is done
+// (possibly out of order) and are matched on the client-chosen id.
+namespace PricingProtocol {
+
+enum class RequestKind : std::uint8_t {
+    PRICE = 1,        // Black-Scholes price
+    GREEKS = 2,       // Black-Scholes price, delta, gamma, vega
+    IMPLIED_VOL = 3,  // 'volatility' field carries the market price
+    MC_PRICE = 4      // Monte Carlo price and standard error
+};
+
+enum class Status : std::uint8_t {
+    OK = 0,
+    BAD_REQUEST = 1,
+    NO_CONVERGENCE = 2,
+    BUSY = 3             // Server queue full: not priced, retry later
+};
+
+struct RequestFrame {
+    std::uint32_t id;
+    RequestKind kind;
+    std::uint8_t optionType; // 0 = Call, 1 = Put
+    std::uint16_t reserved;
+    double spot;
+    double strike;
+    double rate;
+    double volatility;       // Market price for IMPLIED_VOL
+    double maturity;
+};
+
+struct ResponseFrame {
+    std::uint32_t id;
+    RequestKind kind;
+    Status status;
+    std::uint16_t reserved;
+    double values[5];        // PRICE: [price] | GREEKS: [price, delta, gamma, vega]
+                             // IMPLIED_VOL: [vol] | MC_PRICE: [price, std_error]
+};
+
+static_assert(sizeof(RequestFrame) == 48, "RequestFrame must stay 48 bytes");
+static_assert(sizeof(ResponseFrame) == 48, "ResponseFrame must stay 48 bytes");
+
+// ============================================================================
+// SOCKET HELPERS
+// ============================================================================
+
+// Address syntax: "unix:/path/to/socket" or "tcp:PORT" (localhost only)
+struct Endpoint {
+    bool isUnix = true;
+    std::string path;
+    std::uint16_t port = 0;
+
+    static Endpoint parse(const std::string& address) {
+        Endpoint e;
+        if (address.compare(0, 5, "unix:") == 0) {
+            e.isUnix = true;
+            e.path = address.substr(5);
+            if (e.path.empty() || e.path.size() >= sizeof(sockaddr_un::sun_path)) {
+                throw std::invalid_argument("PricingProtocol: bad unix socket path");
+            }
+        } else if (address.compare(0, 4, "tcp:") == 0) {
+            e.isUnix = false;
+            e.port = static_cast<std::uint16_t>(std::stoi(address.substr(4)));
+        } else {
+            throw std::invalid_argument("PricingProtocol: address must be unix:PATH or tcp:PORT");
+        }
+        return e;
+    }
+};
+
+inline sockaddr_un unixAddress(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    return addr;
+}
+
+// Removes a socket file left behind by a server that is gone. Anything else at 'path' is
+// left alone: a regular file or directory, or the socket of a server that still answers.
+inline void removeStaleSocket(const std::string& path) {
+    struct stat st;
+    if (::lstat(path.c_str(), &st) != 0) {
+        if (errno == ENOENT) return;
+        throw std::runtime_error("PricingProtocol: cannot stat " + path);
+    }
+    if (!S_ISSOCK(st.st_mode)) {
+        throw std::runtime_error("PricingProtocol: " + path + " exists and is not a socket");
+    }
+    int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) throw std::runtime_error("PricingProtocol: socket() failed");
+    sockaddr_un addr = unixAddress(path);
+    int rc = ::connect(probe, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    int err = errno;
+    ::close(probe);
+    if (rc == 0) throw std::runtime_error("PricingProtocol: a server is already listening on " + path);
+    if (err != ECONNREFUSED) throw std::runtime_error("PricingProtocol: cannot probe " + path);
+    ::unlink(path.c_str());
+}
+
+// Identity of the socket file bound by listenOn(), so its owner removes that file only
+struct SocketFile {
+    dev_t device = 0;
+    ino_t inode = 0;
+    bool valid = false;
+};
+
+// Unlinks 'path' if it is still the socket file 'bound' (not a later server's)
+inline void unlinkSocket(const std::string& path, const SocketFile& bound) {
+    struct stat st;
+    if (!bound.valid || ::lstat(path.c_str(), &st) != 0) return;
+    if (S_ISSOCK(st.st_mode) && st.st_dev == bound.device && st.st_ino == bound.inode) ::unlink(path.c_str());
+}
+
+// Unix endpoints: a stale socket file is replaced, a live server or a non-socket file is an
+// error; 'bound' (optional) receives the identity of the new socket file
+inline int listenOn(const Endpoint& e, int backlog = 64, SocketFile* bound = nullptr) {
+    int fd;
+    if (e.isUnix) {
+        removeStaleSocket(e.path);
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) throw std::runtime_error("PricingProtocol: socket() failed");
+        sockaddr_un addr = unixAddress(e.path);
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd);
+            throw std::runtime_error("PricingProtocol: cannot bind " + e.path);
+        }
+        struct stat st;
+        if (bound && ::lstat(e.path.c_str(), &st) == 0) {
+            bound->device = st.st_dev;
+            bound->inode = st.st_ino;
+            bound->valid = true;
+        }
+    } else {
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) throw std::runtime_error("PricingProtocol: socket() failed");
+        int one = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(e.port);
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd);
+            throw std::runtime_error("PricingProtocol: cannot bind port " + std::to_string(e.port));
+        }
+    }
+    if (::listen(fd, backlog) != 0) {
+        ::close(fd);
+        throw std::runtime_error("PricingProtocol: listen() failed");
+    }
+    return fd;
+}
+
+inline int connectTo(const Endpoint& e) {
+    int fd;
+    int rc;
+    if (e.isUnix) {
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr = unixAddress(e.path);
+        rc = (fd < 0) ? -1 : ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    } else {
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(e.port);
+        rc = (fd < 0) ? -1 : ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    }
+    if (rc != 0) {
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error("PricingProtocol: cannot connect");
+    }
+    if (!e.isUnix) {
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+}
+
+// Blocking full-buffer I/O; false on EOF or error
+inline bool readAll(int fd, void* buf, std::size_t n) {
+    char* p = static_cast<char*>(buf);
+    while (n > 0) {
+        ssize_t r = ::recv(fd, p, n, 0);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        p += r;
+        n -= static_cast<std::size_t>(r);
+    }
+    return true;
+}
+
+inline bool writeAll(int fd, const void* buf, std::size_t n) {
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+    const char* p = static_cast<const char*>(buf);
+    while (n > 0) {
+        ssize_t w = ::send(fd, p, n, flags);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        p += w;
+        n -= static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+} // namespace PricingProtocol
+
+#endif // PRICING_PROTOCOL_H
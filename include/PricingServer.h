@@ -0,0 +1,417 @@
+#ifndef PRICING_SERVER_H
+#define PRICING_SERVER_H
+
+#include "BatchPricer.h"
+#include "EuropeanOption.h"
+#include "Executor.h"
+#include "ImpliedVolatility.h"
+#include "MonteCarlo.h"
+#include "PricingProtocol.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ServerConfig {
+    std::size_t maxBatch = 4096;   // Upper bound on requests priced together
+    int maxDelayUs = 100;          // Coalescing window opened by the first queued request
+    int mcPaths = 100000;          // Paths per MC_PRICE request
+    unsigned int mcSeed = 42;
+    int pricingThreads = 0;        // 0 = default executor, otherwise a dedicated pool
+    std::size_t maxQueue = 65536;  // Requests waiting for a batch; beyond it requests are answered BUSY
+    std::size_t maxOutboundBytes = 8u << 20; // Unsent responses per client; beyond it the client is dropped
+};
+
+// Pricing daemon: one reader thread per connection feeds a shared, bounded queue, and a
+// single batcher thread drains it, grouping requests by kind so each group goes through the
+// batch Black-Scholes kernel, the IV solver or the MC pricer in one pass. Analytic responses
+// are sent before the batch's MC requests are priced, and each MC response as soon as it is.
+//
+// The batcher never touches a socket: it appends responses to the connection's outbox and
+// the connection's writer thread sends them, so a client that stops reading only fills its
+// own outbox (and is dropped once it exceeds maxOutboundBytes) instead of stalling the
+// batcher, the other clients or stop().
+class PricingServer {
+private:
+    using RequestFrame = PricingProtocol::RequestFrame;
+    using ResponseFrame = PricingProtocol::ResponseFrame;
+    using RequestKind = PricingProtocol::RequestKind;
+    using Status = PricingProtocol::Status;
+
+    // The fd stays open until both the reader and the writer have exited and been joined, so
+    // shutdown() from any thread never hits a reused descriptor. outMutex only guards memory:
+    // no thread blocks on the socket while holding it.
+    struct Connection {
+        const int fd;
+        std::mutex outMutex;
+        std::condition_variable outCv;
+        std::vector<char> outbox;          // Guarded by outMutex: responses not yet handed to send()
+        bool closing = false;              // Guarded by outMutex: no more responses, the writer exits
+        std::atomic<int> threadsAlive{2};  // Reader and writer
+        explicit Connection(int f) : fd(f) {}
+    };
+
+    struct Client {
+        std::shared_ptr<Connection> conn;
+        std::thread reader;
+        std::thread writer;
+    };
+
+    struct Pending {
+        std::shared_ptr<Connection> conn;
+        RequestFrame request;
+    };
+
+    ServerConfig config_;
+    std::unique_ptr<Executor> ownedExecutor_;
+    Executor* executor_;
+    MonteCarloPricer mc_;            // Used by the batcher thread only; keeps its workspaces warm
+    std::string unixPath_;
+    PricingProtocol::SocketFile socketFile_;   // The socket file this instance bound
+    int listenFd_ = -1;
+    std::atomic<bool> running_{false};
+
+    std::thread acceptor_;
+    std::thread batcher_;
+    std::mutex clientMutex_;
+    std::vector<Client> clients_;
+
+    std::mutex queueMutex_;
+    std::condition_variable queueCv_;
+    std::vector<Pending> queue_;
+
+    std::atomic<std::uint64_t> requests_{0};
+    std::atomic<std::uint64_t> batches_{0};
+    std::atomic<std::uint64_t> rejected_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    // --- CONNECTION THREADS ---
+
+    void acceptLoop() {
+        while (running_.load()) {
+            int fd = ::accept(listenFd_, nullptr, nullptr);
+            if (fd < 0) {
+                if (errno == EINTR) continue;
+                break; // Listening socket shut down
+            }
+            if (unixPath_.empty()) {
+                int one = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            }
+            auto conn = std::make_shared<Connection>(fd);
+            std::lock_guard<std::mutex> lock(clientMutex_);
+            reapFinishedClients();
+            clients_.push_back({conn, std::thread(&PricingServer::readLoop, this, conn),
+                                std::thread(&PricingServer::writeLoop, this, conn)});
+        }
+    }
+
+    // Joins the threads of connections that went away and closes their socket
+    // (caller holds clientMutex_)
+    void reapFinishedClients() {
+        for (std::size_t i = 0; i < clients_.size();) {
+            if (clients_[i].conn->threadsAlive.load() == 0) {
+                clients_[i].reader.join();
+                clients_[i].writer.join();
+                ::close(clients_[i].conn->fd);
+                clients_[i] = std::move(clients_.back());
+                clients_.pop_back();
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    void readLoop(std::shared_ptr<Connection> conn) {
+        const std::size_t FRAME = sizeof(RequestFrame);
+        std::vector<char> buffer(256 * FRAME);
+        std::vector<ResponseFrame> busy;
+        std::size_t filled = 0;
+
+        while (running_.load()) {
+            ssize_t r = ::recv(conn->fd, buffer.data() + filled, buffer.size() - filled, 0);
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) break;
+            filled += static_cast<std::size_t>(r);
+
+            std::size_t complete = filled / FRAME;
+            if (complete > 0) {
+                busy.clear();
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex_);
+                    bool was_empty = queue_.empty();
+                    for (std::size_t i = 0; i < complete; ++i) {
+                        Pending p{conn, {}};
+                        std::memcpy(&p.request, buffer.data() + i * FRAME, FRAME);
+                        if (queue_.size() < config_.maxQueue) {
+                            queue_.push_back(std::move(p));
+                        } else {
+                            busy.push_back(emptyResponse(p.request));
+                            busy.back().status = Status::BUSY;
+                        }
+                    }
+                    if (was_empty || queue_.size() >= config_.maxBatch) queueCv_.notify_one();
+                }
+                if (!busy.empty()) {
+                    rejected_.fetch_add(busy.size());
+                    deliver(*conn, busy.data(), busy.size());
+                }
+            }
+            std::size_t consumed = complete * FRAME;
+            std::memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+            filled -= consumed;
+        }
+        // Late responses for this connection are dropped
+        disconnect(*conn);
+        conn->threadsAlive.fetch_sub(1);
+    }
+
+    // Sends the outbox; the lock is only held to swap the pending bytes out
+    void writeLoop(std::shared_ptr<Connection> conn) {
+        std::vector<char> sending;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(conn->outMutex);
+                conn->outCv.wait(lock, [&]() { return !conn->outbox.empty() || conn->closing; });
+                if (conn->closing) break;
+                sending.swap(conn->outbox);
+            }
+            bool sent = PricingProtocol::writeAll(conn->fd, sending.data(), sending.size());
+            sending.clear();
+            if (!sent) {
+                disconnect(*conn);
+                break;
+            }
+        }
+        conn->threadsAlive.fetch_sub(1);
+    }
+
+    // Stops both threads of a connection: shutdown() wakes a blocked recv() or send()
+    // and never blocks itself. The fd is closed later, by the thread that joins them.
+    static void closeLocked(Connection& conn) {
+        if (conn.closing) return;
+        conn.closing = true;
+        ::shutdown(conn.fd, SHUT_RDWR);
+        conn.outCv.notify_one();
+    }
+
+    static void disconnect(Connection& conn) {
+        std::lock_guard<std::mutex> lock(conn.outMutex);
+        closeLocked(conn);
+    }
+
+    // Queues responses for the connection's writer; never blocks on the socket
+    void deliver(Connection& conn, const ResponseFrame* frames, std::size_t count) {
+        const std::size_t bytes = count * sizeof(ResponseFrame);
+        std::lock_guard<std::mutex> lock(conn.outMutex);
+        if (conn.closing) return;
+        if (conn.outbox.size() + bytes > config_.maxOutboundBytes) {
+            // The client is not reading its responses: drop it rather than buffer forever
+            dropped_.fetch_add(1);
+            closeLocked(conn);
+            return;
+        }
+        const char* p = reinterpret_cast<const char*>(frames);
+        conn.outbox.insert(conn.outbox.end(), p, p + bytes);
+        conn.outCv.notify_one();
+    }
+
+    // Delivers responses[i] for every i of 'which', one outbox append per connection
+    void deliverGroup(const std::vector<Pending>& batch, const std::vector<ResponseFrame>& responses,
+                      std::vector<std::size_t> which) {
+        std::stable_sort(which.begin(), which.end(), [&](std::size_t a, std::size_t b) {
+            return batch[a].conn.get() < batch[b].conn.get();
+        });
+        std::vector<ResponseFrame> out;
+        for (std::size_t s = 0; s < which.size();) {
+            Connection* conn = batch[which[s]].conn.get();
+            out.clear();
+            std::size_t e = s;
+            while (e < which.size() && batch[which[e]].conn.get() == conn) out.push_back(responses[which[e++]]);
+            deliver(*conn, out.data(), out.size());
+            s = e;
+        }
+    }
+
+    static ResponseFrame emptyResponse(const RequestFrame& r) {
+        ResponseFrame out;
+        std::memset(&out, 0, sizeof(out));
+        out.id = r.id;
+        out.kind = r.kind;
+        return out;
+    }
+
+    // --- BATCHER ---
+
+    void batchLoop() {
+        std::vector<Pending> batch;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(queueMutex_);
+                queueCv_.wait(lock, [this]() { return !queue_.empty() || !running_.load(); });
+                if (!running_.load()) break;   // Requests still queued are dropped with their clients
+
+                // Coalescing window: give concurrent clients a chance to join this batch
+                auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(config_.maxDelayUs);
+                while (queue_.size() < config_.maxBatch && running_.load()) {
+                    if (queueCv_.wait_until(lock, deadline) == std::cv_status::timeout) break;
+                }
+
+                std::size_t take = std::min(queue_.size(), config_.maxBatch);
+                batch.assign(std::make_move_iterator(queue_.begin()), std::make_move_iterator(queue_.begin() + take));
+                queue_.erase(queue_.begin(), queue_.begin() + take);
+            }
+            if (!batch.empty()) {
+                processBatch(batch);
+                batches_.fetch_add(1);
+                requests_.fetch_add(batch.size());
+            }
+        }
+    }
+
+    static bool isValid(const RequestFrame& r) {
+        return r.spot > 0.0 && r.strike > 0.0 && r.maturity > 0.0 && r.volatility > 0.0 && r.optionType <= 1;
+    }
+
+    void processBatch(const std::vector<Pending>& batch) {
+        const std::size_t n = batch.size();
+        std::vector<ResponseFrame> responses(n);
+        std::vector<std::size_t> bsIdx, ivIdx, mcIdx, analytic;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            const RequestFrame& r = batch[i].request;
+            ResponseFrame& out = responses[i];
+            out = emptyResponse(r);
+            if (!isValid(r)) {
+                out.status = Status::BAD_REQUEST;
+                analytic.push_back(i);
+                continue;
+            }
+            switch (r.kind) {
+                case RequestKind::PRICE:
+                case RequestKind::GREEKS: bsIdx.push_back(i); break;
+                case RequestKind::IMPLIED_VOL: ivIdx.push_back(i); break;
+                case RequestKind::MC_PRICE: mcIdx.push_back(i); break;
+                default: out.status = Status::BAD_REQUEST; break;
+            }
+            if (r.kind != RequestKind::MC_PRICE) analytic.push_back(i);
+        }
+
+        // 1. Black-Scholes group through the batch kernel
+        if (!bsIdx.empty()) {
+            std::size_t m = bsIdx.size();
+            std::vector<double> spot(m), strike(m), rate(m), vol(m), maturity(m);
+            std::vector<OptionType> type(m);
+            std::vector<double> price(m), delta(m), gamma(m), vega(m);
+            for (std::size_t k = 0; k < m; ++k) {
+                const RequestFrame& r = batch[bsIdx[k]].request;
+                spot[k] = r.spot; strike[k] = r.strike; rate[k] = r.rate;
+                vol[k] = r.volatility; maturity[k] = r.maturity;
+                type[k] = r.optionType == 0 ? OptionType::CALL : OptionType::PUT;
+            }
+            OptionBatch ob;
+            ob.size = m;
+            ob.spot = spot.data(); ob.strike = strike.data(); ob.rate = rate.data();
+            ob.volatility = vol.data(); ob.maturity = maturity.data(); ob.type = type.data();
+            BatchPricer::priceBlackScholes(ob, {price.data(), delta.data(), gamma.data(), vega.data()}, *executor_);
+            for (std::size_t k = 0; k < m; ++k) {
+                double* v = responses[bsIdx[k]].values;
+                v[0] = price[k]; v[1] = delta[k]; v[2] = gamma[k]; v[3] = vega[k];
+            }
+        }
+
+        // 2. Implied vols, solved in parallel
+        auto solveRange = [&](std::size_t begin, std::size_t end, int) {
+            for (std::size_t k = begin; k < end; ++k) {
+                const RequestFrame& r = batch[ivIdx[k]].request;
+                double iv = ImpliedVolatility::calculate(r.volatility, r.spot, r.strike, r.rate, r.maturity,
+                                                         r.optionType == 0 ? OptionType::CALL : OptionType::PUT);
+                ResponseFrame& out = responses[ivIdx[k]];
+                out.values[0] = iv;
+                if (iv < 0.0) out.status = Status::NO_CONVERGENCE;
+            }
+        };
+        if (ivIdx.size() > 32) executor_->parallelFor(ivIdx.size(), solveRange);
+        else solveRange(0, ivIdx.size(), 0);
+
+        // 3. Analytic (and rejected) responses leave before any MC work starts
+        deliverGroup(batch, responses, analytic);
+
+        // 4. Monte Carlo requests (each pricing call is itself multi-threaded), each sent
+        //    as soon as it is priced
+        for (std::size_t i : mcIdx) {
+            if (!running_.load()) break;
+            const RequestFrame& r = batch[i].request;
+            EuropeanOption option(r.strike, r.maturity, r.optionType == 0 ? OptionType::CALL : OptionType::PUT);
+            auto res = mc_.price(option, r.spot, r.rate, r.volatility);
+            responses[i].values[0] = res.first;
+            responses[i].values[1] = res.second;
+            deliver(*batch[i].conn, &responses[i], 1);
+        }
+    }
+
+public:
+    explicit PricingServer(const ServerConfig& config = ServerConfig())
+        : config_(config),
+          ownedExecutor_(config.pricingThreads > 0 ? new ThreadPoolExecutor(config.pricingThreads) : nullptr),
+          executor_(ownedExecutor_ ? ownedExecutor_.get() : &defaultExecutor()),
+          mc_(config.mcPaths, config.mcSeed, *executor_) {}
+
+    ~PricingServer() { stop(); }
+
+    PricingServer(const PricingServer&) = delete;
+    PricingServer& operator=(const PricingServer&) = delete;
+
+    void start(const std::string& address) {
+        PricingProtocol::Endpoint e = PricingProtocol::Endpoint::parse(address);
+        listenFd_ = PricingProtocol::listenOn(e, 64, &socketFile_);
+        unixPath_ = e.isUnix ? e.path : std::string();
+        running_.store(true);
+        batcher_ = std::thread(&PricingServer::batchLoop, this);
+        acceptor_ = std::thread(&PricingServer::acceptLoop, this);
+    }
+
+    // Never waits on a client: the batcher stops after its current request, and every
+    // connection is shut down before its threads are joined
+    void stop() {
+        if (!running_.exchange(false)) return;
+
+        // shutdown() wakes accept(); the fd is closed only once the acceptor is gone, so
+        // it never calls accept() on a number another thread has reused
+        ::shutdown(listenFd_, SHUT_RDWR);
+        if (acceptor_.joinable()) acceptor_.join();
+        ::close(listenFd_);
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            queue_.clear();
+        }
+        queueCv_.notify_all();
+        if (batcher_.joinable()) batcher_.join();
+
+        for (Client& c : clients_) disconnect(*c.conn);
+        for (Client& c : clients_) {
+            c.reader.join();
+            c.writer.join();
+            ::close(c.conn->fd);
+        }
+        clients_.clear();
+        if (!unixPath_.empty()) PricingProtocol::unlinkSocket(unixPath_, socketFile_);
+    }
+
+    std::uint64_t requestsServed() const { return requests_.load(); }
+    std::uint64_t batchesRun() const { return batches_.load(); }
+    std::uint64_t requestsRejected() const { return rejected_.load(); }   // Answered BUSY (queue full)
+    std::uint64_t clientsDropped() const { return dropped_.load(); }      // Outbox over maxOutboundBytes
+    double averageBatchSize() const {
+        std::uint64_t b = batches_.load();
+        return b ? static_cast<double>(requests_.load()) / b : 0.0;
+    }
+};
+
+#endif // PRICING_SERVER_H
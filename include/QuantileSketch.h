@@ -0,0 +1,138 @@
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Mergeable quantile sketch for non-negative values (relative-error log buckets).
+// A value x > 0 is counted in bucket i = ceil(log(x) / log(gamma)), gamma = (1 + a) / (1 - a),
+// whose representative 2 gamma^i / (gamma + 1) is within relative error a of every value
+// in it. Values <= 0 (no exposure) are counted apart.
+// Memory is bounded by max_buckets: a count of bucket i is kept in bucket
+// max(i, floor), floor = top - max_buckets + 1, where top is the highest bucket ever seen.
+// This only costs accuracy in the low quantiles (PFE reads the high ones). The floor depends
+// on nothing but the top, which never decreases, and clamping to a floor then to a higher
+// one equals clamping once to the higher one; counts are integers. So the sketch of a set
+// of values is the same whatever the insertion order or the way partial sketches are merged.
+class QuantileSketch {
+private:
+    double accuracy_;
+    double log_gamma_;
+    int max_buckets_;
+    std::vector<std::uint64_t> counts_;
+    int offset_ = 0;                 // Bucket index of counts_[0] (>= floorBucket())
+    int top_ = 0;                    // Highest bucket seen (valid when counts_ is not empty)
+    std::uint64_t zeros_ = 0;
+    std::uint64_t count_ = 0;
+    double min_ = std::numeric_limits<double>::infinity();    // Smallest positive value
+    double max_ = 0.0;
+
+    // Lowest bucket kept: everything below is counted in it
+    int floorBucket() const { return top_ - max_buckets_ + 1; }
+
+    // Position in counts_ of bucket 'index' (clamped to the floor), growing the array and
+    // folding the buckets that fall below a raised floor
+    std::size_t slot(int index) {
+        if (counts_.empty()) {
+            offset_ = top_ = index;
+            counts_.assign(1, 0);
+            return 0;
+        }
+        if (index > top_) {
+            counts_.resize(counts_.size() + (index - top_), 0);
+            top_ = index;
+            if (offset_ < floorBucket()) {
+                std::size_t k = static_cast<std::size_t>(floorBucket() - offset_);
+                std::uint64_t folded = 0;
+                for (std::size_t i = 0; i < k; ++i) folded += counts_[i];
+                counts_.erase(counts_.begin(), counts_.begin() + k);
+                counts_[0] += folded;
+                offset_ = floorBucket();
+            }
+        }
+        index = std::max(index, floorBucket());
+        if (index < offset_) {
+            counts_.insert(counts_.begin(), offset_ - index, 0);
+            offset_ = index;
+        }
+        return static_cast<std::size_t>(index - offset_);
+    }
+
+public:
+    explicit QuantileSketch(double relative_accuracy = 0.005, int max_buckets = 2048)
+        : accuracy_(relative_accuracy), max_buckets_(max_buckets) {
+        if (!(relative_accuracy > 0.0 && relative_accuracy < 1.0) || max_buckets < 1) {
+            throw std::invalid_argument("QuantileSketch: accuracy must be in (0, 1) and max_buckets >= 1");
+        }
+        log_gamma_ = std::log((1.0 + accuracy_) / (1.0 - accuracy_));
+    }
+
+    void add(double x) {
+        ++count_;
+        if (!(x > 0.0)) {
+            ++zeros_;
+            return;
+        }
+        min_ = std::min(min_, x);
+        max_ = std::max(max_, x);
+        ++counts_[slot(static_cast<int>(std::ceil(std::log(x) / log_gamma_)))];
+    }
+
+    // Adds the counts of another sketch built with the same accuracy
+    void merge(const QuantileSketch& other) {
+        if (other.accuracy_ != accuracy_) {
+            throw std::invalid_argument("QuantileSketch: cannot merge sketches of different accuracy");
+        }
+        count_ += other.count_;
+        zeros_ += other.zeros_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        for (std::size_t i = 0; i < other.counts_.size(); ++i) {
+            if (other.counts_[i]) counts_[slot(other.offset_ + static_cast<int>(i))] += other.counts_[i];
+        }
+    }
+
+    // Value at quantile q in [0, 1] (0 for an empty sketch)
+    double quantile(double q) const {
+        if (count_ == 0) return 0.0;
+        q = std::min(1.0, std::max(0.0, q));
+        double rank = q * static_cast<double>(count_ - 1);
+        double seen = static_cast<double>(zeros_);
+        if (rank < seen) return 0.0;
+        for (std::size_t i = 0; i < counts_.size(); ++i) {
+            seen += static_cast<double>(counts_[i]);
+            if (rank < seen) {
+                double value = 2.0 * std::exp(log_gamma_ * (offset_ + static_cast<int>(i))) /
+                               (std::exp(log_gamma_) + 1.0);
+                return std::min(max_, std::max(min_, value));
+            }
+        }
+        return max_;
+    }
+
+    void clear() {
+        counts_.clear();
+        offset_ = 0;
+        top_ = 0;
+        zeros_ = 0;
+        count_ = 0;
+        min_ = std::numeric_limits<double>::infinity();
+        max_ = 0.0;
+    }
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t zeroCount() const { return zeros_; }
+    std::size_t bucketCount() const { return counts_.size(); }
+    double relativeAccuracy() const { return accuracy_; }
+
+    bool operator==(const QuantileSketch& o) const {
+        return accuracy_ == o.accuracy_ && count_ == o.count_ && zeros_ == o.zeros_ &&
+               offset_ == o.offset_ && counts_ == o.counts_;
+    }
+};
+
+#endif // QUANTILE_SKETCH_H
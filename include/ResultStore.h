@@ -0,0 +1,303 @@
+#ifndef RESULT_STORE_H
+#define RESULT_STORE_H
+
+#include "OptionBook.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Net position of one underlying: quantity-weighted sums over its trades
+struct RiskAggregate {
+    double value = 0.0;
+    double delta = 0.0;
+    double gamma = 0.0;
+    double vega = 0.0;
+};
+
+// Book-level totals read in one pass
+struct RiskSnapshot {
+    std::vector<RiskAggregate> byUnderlying;   // In the order of ResultStore::underlyings()
+    RiskAggregate total;
+    std::uint64_t updates = 0;                 // Results published, as seen by the shard reads
+};
+
+// Concurrent store of per-trade results and per-underlying aggregates.
+//
+// Pricing workers publish() trade results while any number of readers (GUI, risk report,
+// limit checks) read trades or book totals. Trades are spread over shards (trade t lives in
+// shard t % shards); each shard is a seqlock over its trade slots and its own per-underlying
+// aggregates:
+//   - a writer takes its shard by moving the sequence from even to odd (CAS), replaces the
+//     trade's contribution (new - old, times the quantity) in the shard aggregates with
+//     compensated additions, stores the result and makes the sequence even again;
+//   - a reader copies what it needs between two loads of the sequence and retries if a
+//     write overlapped. Readers never write shared memory, so they never block or slow a
+//     writer (beyond sharing its cache lines); writers only wait for writers of the same shard.
+// A snapshot sums the shards, each read consistently, so every trade contributes exactly
+// one of the results published for it (never a torn or double-counted one); shards may be
+// read at slightly different moments. Payload fields are relaxed atomics, which keeps the
+// seqlock within the C++ memory model.
+// The trade set is fixed at construction: slots never move, so no reader can race a resize.
+class ResultStore {
+public:
+    static constexpr int FIELDS = 4;   // value, delta, gamma, vega
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    // Sum plus Neumaier compensation: aggregates are maintained by adding and removing
+    // contributions forever, and the compensation keeps them from drifting
+    struct Compensated {
+        std::atomic<double> sum{0.0};
+        std::atomic<double> compensation{0.0};
+    };
+
+    // The four aggregates of one underlying in one shard: exactly one cache line
+    struct alignas(CACHE_LINE) AggregateLine {
+        Compensated field[FIELDS];
+    };
+
+    // Trade result storage in whole cache lines, so shards never share a line
+    struct alignas(CACHE_LINE) ResultLine {
+        std::atomic<double> value[CACHE_LINE / sizeof(double)];
+    };
+
+    struct alignas(CACHE_LINE) Shard {
+        std::atomic<std::uint64_t> sequence{0};           // Odd while a writer is inside; writes = sequence / 2
+        std::unique_ptr<AggregateLine[]> aggregates;      // [underlying]
+        std::unique_ptr<ResultLine[]> lines;
+        std::atomic<double>* results = nullptr;           // [local trade][field], inside 'lines'
+    };
+
+    std::size_t num_trades_;
+    int num_shards_;
+    std::vector<std::string> underlyings_;
+    std::vector<std::size_t> underlying_of_;
+    std::vector<double> quantity_;
+    std::unique_ptr<Shard[]> shards_;
+
+    static_assert(std::atomic<double>::is_always_lock_free, "ResultStore: needs lock-free atomic<double>");
+
+    void checkTrade(std::size_t trade) const {
+        if (trade >= num_trades_) {
+            throw std::out_of_range("ResultStore: trade " + std::to_string(trade) + " outside the " +
+                                    std::to_string(num_trades_) + " trades of the store");
+        }
+    }
+
+    // Trades added to a book after its store was built have no slot: nothing is published
+    void checkBook(const OptionBook& book) const {
+        if (book.size() != num_trades_) {
+            throw std::invalid_argument("ResultStore: book has " + std::to_string(book.size()) +
+                                        " trades, the store was built for " + std::to_string(num_trades_));
+        }
+    }
+
+    Shard& shardOf(std::size_t trade) const { return shards_[trade % num_shards_]; }
+    std::size_t localIndex(std::size_t trade) const { return trade / num_shards_; }
+
+    static void pack(const TradeResult& r, double* f) {
+        f[0] = r.price;
+        f[1] = r.delta;
+        f[2] = r.gamma;
+        f[3] = r.vega;
+    }
+
+    static void add(Compensated& c, double x) {
+        double sum = c.sum.load(std::memory_order_relaxed);
+        double comp = c.compensation.load(std::memory_order_relaxed);
+        double t = sum + x;
+        comp += std::abs(sum) >= std::abs(x) ? (sum - t) + x : (x - t) + sum;
+        c.sum.store(t, std::memory_order_relaxed);
+        c.compensation.store(comp, std::memory_order_relaxed);
+    }
+
+    // Runs copy() until it completes without an overlapping write; returns the sequence it
+    // was validated against
+    template <typename Copy>
+    static std::uint64_t readConsistent(const Shard& shard, Copy&& copy) {
+        for (int attempt = 0;; ++attempt) {
+            std::uint64_t before = shard.sequence.load(std::memory_order_acquire);
+            if ((before & 1) == 0) {
+                copy();
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (shard.sequence.load(std::memory_order_relaxed) == before) return before;
+            }
+            if (attempt >= 64) std::this_thread::yield();   // A writer was preempted inside
+        }
+    }
+
+    void init(int shards) {
+        if (shards < 1) throw std::invalid_argument("ResultStore: at least one shard");
+        num_shards_ = static_cast<int>(std::min<std::size_t>(static_cast<std::size_t>(shards), std::max<std::size_t>(1, num_trades_)));
+        const std::size_t per_line = CACHE_LINE / sizeof(double);
+        const std::size_t values = (num_trades_ + num_shards_ - 1) / num_shards_ * FIELDS;
+        shards_.reset(new Shard[num_shards_]);
+        for (int s = 0; s < num_shards_; ++s) {
+            Shard& shard = shards_[s];
+            shard.aggregates.reset(new AggregateLine[std::max<std::size_t>(1, underlyings_.size())]);
+            shard.lines.reset(new ResultLine[std::max<std::size_t>(1, (values + per_line - 1) / per_line)]);
+            shard.results = shard.lines[0].value;
+            for (std::size_t i = 0; i < values; ++i) shard.results[i].store(0.0, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    // Trades of a book, grouped by their underlying; results start at zero
+    explicit ResultStore(const OptionBook& book, int shards = 64) : num_trades_(book.size()) {
+        for (std::size_t id = 0; id < book.size(); ++id) {
+            const Trade& t = book.trade(id);
+            std::size_t u = std::find(underlyings_.begin(), underlyings_.end(), t.underlying) - underlyings_.begin();
+            if (u == underlyings_.size()) underlyings_.push_back(t.underlying);
+            underlying_of_.push_back(u);
+            quantity_.push_back(t.quantity);
+        }
+        init(shards);
+    }
+
+    // Explicit layout: trade i belongs to underlyings[underlying_of[i]] with quantity[i]
+    ResultStore(const std::vector<std::string>& underlyings, const std::vector<std::size_t>& underlying_of,
+                const std::vector<double>& quantity, int shards = 64)
+        : num_trades_(underlying_of.size()), underlyings_(underlyings), underlying_of_(underlying_of), quantity_(quantity) {
+        if (quantity.size() != underlying_of.size()) throw std::invalid_argument("ResultStore: one quantity per trade");
+        for (std::size_t u : underlying_of) {
+            if (u >= underlyings.size()) throw std::invalid_argument("ResultStore: unknown underlying index");
+        }
+        init(shards);
+    }
+
+    ResultStore(const ResultStore&) = delete;
+    ResultStore& operator=(const ResultStore&) = delete;
+
+    // --- WRITERS (any thread) ---
+
+    // Throws std::out_of_range for a trade the store was not built with
+    void publish(std::size_t trade, const TradeResult& result) {
+        checkTrade(trade);
+        Shard& shard = shardOf(trade);
+        std::uint64_t seq = shard.sequence.load(std::memory_order_relaxed);
+        for (;;) {
+            if ((seq & 1) == 0 &&
+                shard.sequence.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                break;
+            }
+            seq = shard.sequence.load(std::memory_order_relaxed);
+        }
+        // Payload stores may not move above the odd sequence
+        std::atomic_thread_fence(std::memory_order_release);
+
+        double next[FIELDS];
+        pack(result, next);
+        std::atomic<double>* slot = shard.results + localIndex(trade) * FIELDS;
+        Compensated* agg = shard.aggregates[underlying_of_[trade]].field;
+        const double q = quantity_[trade];
+        for (int f = 0; f < FIELDS; ++f) {
+            double previous = slot[f].load(std::memory_order_relaxed);
+            add(agg[f], q * next[f] - q * previous);
+            slot[f].store(next[f], std::memory_order_relaxed);
+        }
+
+        shard.sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Publishes the current results of every trade of a book (same trades as the store)
+    void publishAll(const OptionBook& book) {
+        checkBook(book);
+        for (std::size_t id = 0; id < num_trades_; ++id) publish(id, book.result(id));
+    }
+
+    // Publishes only the trades revalued by the book's last reprice() (incremental updates)
+    void publishRepriced(const OptionBook& book) {
+        checkBook(book);
+        for (std::size_t id : book.lastRepriced()) publish(id, book.result(id));
+    }
+
+    // --- READERS (any thread, wait-free for writers) ---
+
+    TradeResult result(std::size_t trade) const {
+        checkTrade(trade);
+        const Shard& shard = shardOf(trade);
+        const std::atomic<double>* slot = shard.results + localIndex(trade) * FIELDS;
+        double f[FIELDS];
+        readConsistent(shard, [&]() {
+            for (int k = 0; k < FIELDS; ++k) f[k] = slot[k].load(std::memory_order_relaxed);
+        });
+        return {f[0], f[1], f[2], f[3]};
+    }
+
+    RiskAggregate aggregate(std::size_t underlying) const {
+        double total[FIELDS] = {0.0, 0.0, 0.0, 0.0};
+        for (int s = 0; s < num_shards_; ++s) {
+            const Compensated* agg = shards_[s].aggregates[underlying].field;
+            double f[FIELDS];
+            readConsistent(shards_[s], [&]() {
+                for (int k = 0; k < FIELDS; ++k) {
+                    f[k] = agg[k].sum.load(std::memory_order_relaxed) + agg[k].compensation.load(std::memory_order_relaxed);
+                }
+            });
+            for (int k = 0; k < FIELDS; ++k) total[k] += f[k];
+        }
+        return {total[0], total[1], total[2], total[3]};
+    }
+
+    RiskAggregate aggregate(const std::string& underlying) const {
+        std::size_t u = std::find(underlyings_.begin(), underlyings_.end(), underlying) - underlyings_.begin();
+        if (u == underlyings_.size()) throw std::invalid_argument("ResultStore: unknown underlying '" + underlying + "'");
+        return aggregate(u);
+    }
+
+    // Every underlying and the book total, one consistent copy per shard
+    RiskSnapshot snapshot() const {
+        const std::size_t U = underlyings_.size();
+        RiskSnapshot snap;
+        snap.byUnderlying.resize(U);
+        std::vector<double> local(U * FIELDS);
+        for (int s = 0; s < num_shards_; ++s) {
+            const AggregateLine* lines = shards_[s].aggregates.get();
+            std::uint64_t seq = readConsistent(shards_[s], [&]() {
+                for (std::size_t u = 0; u < U; ++u) {
+                    for (int k = 0; k < FIELDS; ++k) {
+                        const Compensated& c = lines[u].field[k];
+                        local[u * FIELDS + k] = c.sum.load(std::memory_order_relaxed) +
+                                                c.compensation.load(std::memory_order_relaxed);
+                    }
+                }
+            });
+            snap.updates += seq / 2;
+            for (std::size_t u = 0; u < U; ++u) {
+                RiskAggregate& a = snap.byUnderlying[u];
+                a.value += local[u * FIELDS];
+                a.delta += local[u * FIELDS + 1];
+                a.gamma += local[u * FIELDS + 2];
+                a.vega += local[u * FIELDS + 3];
+            }
+        }
+        for (const RiskAggregate& a : snap.byUnderlying) {
+            snap.total.value += a.value;
+            snap.total.delta += a.delta;
+            snap.total.gamma += a.gamma;
+            snap.total.vega += a.vega;
+        }
+        return snap;
+    }
+
+    std::size_t size() const { return num_trades_; }
+    int shards() const { return num_shards_; }
+    const std::vector<std::string>& underlyings() const { return underlyings_; }
+
+    // Results published so far (each shard counts its own writes, so writers share no counter)
+    std::uint64_t updates() const {
+        std::uint64_t total = 0;
+        for (int s = 0; s < num_shards_; ++s) total += shards_[s].sequence.load(std::memory_order_relaxed) / 2;
+        return total;
+    }
+};
+
+#endif // RESULT_STORE_H
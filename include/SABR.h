@@ -0,0 +1,290 @@
+#ifndef SABR_H
+#define SABR_H
+
+#include "Arena.h"
+#include "BatchPricer.h"
+#include "Executor.h"
+#include "TermStructure.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// SABR stochastic volatility: dF = alpha_t F^beta dW1, d alpha_t = nu alpha_t dW2, <dW1, dW2> = rho dt
+struct SABRParams {
+    double alpha = 0.2;   // Initial volatility level
+    double beta = 1.0;    // CEV exponent (fixed by convention, not calibrated)
+    double rho = 0.0;     // Spot/vol correlation
+    double nu = 0.3;      // Vol of vol
+};
+
+// Lognormal (Black) implied volatility of SABR: Hagan et al. (2002) expansion with the
+// Obloj (2008) leading term, which stays correct for beta < 1 far from the money.
+//
+//   sigma(K) = [nu log(F/K) / x(z)] * [1 + ((1-b)^2/24 a^2/(FK)^(1-b) + rho b nu a/(4 (FK)^((1-b)/2))
+//                                            + (2 - 3 rho^2)/24 nu^2) T]
+//   z = nu (F^(1-b) - K^(1-b)) / (a (1-b)),   x(z) = log((sqrt(1 - 2 rho z + z^2) + z - rho) / (1 - rho))
+//
+// Both ratios of the leading term are written in forms with a finite limit at K = F.
+namespace SABR {
+
+inline double impliedVol(double forward, double strike, double maturity, const SABRParams& p) {
+    const double one_b = 1.0 - p.beta;
+    const double log_fk = std::log(forward / strike);
+    const double fk_pow = std::exp(0.5 * one_b * (std::log(forward) + std::log(strike)));   // (FK)^((1-b)/2)
+    const double f_pow = std::exp(one_b * std::log(forward));                                 // F^(1-b)
+
+    // nu log(F/K) / z = alpha / F^(1-b) * w / (1 - e^-w), w = (1-b) log(F/K)
+    const double w = one_b * log_fk;
+    const double ratio_z = (w == 0.0) ? 1.0 : w / -std::expm1(-w);
+    const double level = p.alpha / f_pow * ratio_z;
+
+    // z / x(z) -> 1 - rho z / 2 at the money
+    const double z = (p.alpha > 0.0) ? p.nu * log_fk / (p.alpha / f_pow * ratio_z) : 0.0;
+    double z_over_x;
+    if (std::abs(z) < 1e-7) {
+        z_over_x = 1.0 - 0.5 * p.rho * z;
+    } else {
+        double x = std::log((std::sqrt(1.0 - 2.0 * p.rho * z + z * z) + z - p.rho) / (1.0 - p.rho));
+        z_over_x = z / x;
+    }
+
+    const double correction = 1.0 + maturity * (one_b * one_b / 24.0 * p.alpha * p.alpha / (fk_pow * fk_pow)
+                                                + 0.25 * p.rho * p.beta * p.nu * p.alpha / fk_pow
+                                                + (2.0 - 3.0 * p.rho * p.rho) / 24.0 * p.nu * p.nu);
+    return level * z_over_x * correction;
+}
+
+// Vols of a whole strike array of one expiry (branch-light loop over contiguous strikes)
+inline void impliedVols(double forward, const double* strikes, std::size_t n, double maturity,
+                        const SABRParams& p, double* out) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = impliedVol(forward, strikes[i], maturity, p);
+}
+
+// Prices and Greeks of one expiry's strikes: SABR vols, then the batch Black kernel on the
+// expiry's forward. 'vols' is caller scratch of n values (filled with the SABR vols).
+inline void priceExpiry(const ExpiryContext& ctx, const SABRParams& p, const double* strikes,
+                        const OptionType* types, std::size_t n, double* vols, const GreeksBatch& out,
+                        Executor& executor = defaultExecutor()) {
+    executor.parallelFor(n, [&](std::size_t begin, std::size_t end, int) {
+        impliedVols(ctx.forward, strikes + begin, end - begin, ctx.maturity, p, vols + begin);
+        BatchPricer::priceExpiryRange(ctx, strikes, vols, types, out, begin, end);
+    });
+}
+
+} // namespace SABR
+
+// Market smile of one expiry
+struct SABRSlice {
+    double forward = 100.0;
+    double maturity = 1.0;
+    std::vector<double> strikes;
+    std::vector<double> vols;      // Black implied vols
+    std::vector<double> weights;   // Optional (empty = all 1)
+};
+
+struct SABRFit {
+    SABRParams params;
+    double rmse = 0.0;        // Root mean square vol error (weighted)
+    int iterations = 0;
+    bool converged = false;
+};
+
+// Per-expiry calibration of (alpha, rho, nu) with beta fixed, by Levenberg-Marquardt on
+// the vol residuals. Parameters are solved in unconstrained coordinates
+// (log alpha, atanh rho, log nu) so every trial point is admissible.
+// Expiries are independent and run in parallel on the executor. Each expiry starts from
+// its previous fit when the surface has the same number of expiries (warm start), which
+// is the intraday case: a few iterations instead of a cold search.
+class SABRCalibrator {
+private:
+    double beta_;
+    Executor* executor_;
+    int max_iterations_ = 100;
+    double tolerance_ = 1e-8;    // On the relative decrease of the squared error
+    std::vector<SABRParams> warm_;
+    WorkspacePool workspaces_;
+
+    // Unconstrained coordinates <-> parameters
+    SABRParams fromCoordinates(const double* u) const {
+        SABRParams p;
+        p.alpha = std::exp(u[0]);
+        p.beta = beta_;
+        p.rho = 0.999 * std::tanh(u[1]);
+        p.nu = std::exp(u[2]);
+        return p;
+    }
+
+    static void toCoordinates(const SABRParams& p, double* u) {
+        u[0] = std::log(p.alpha);
+        u[1] = std::atanh(std::max(-0.998, std::min(0.998, p.rho)) / 0.999);
+        u[2] = std::log(std::max(p.nu, 1e-6));
+    }
+
+    // Weighted residuals sqrt(w_i) (sigma(K_i) - sigma_i), returns the squared error
+    double residuals(const SABRSlice& s, const double* u, double* r) const {
+        SABRParams p = fromCoordinates(u);
+        const std::size_t n = s.strikes.size();
+        SABR::impliedVols(s.forward, s.strikes.data(), n, s.maturity, p, r);
+        double cost = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            double w = s.weights.empty() ? 1.0 : std::sqrt(s.weights[i]);
+            r[i] = w * (r[i] - s.vols[i]);
+            cost += r[i] * r[i];
+        }
+        return cost;
+    }
+
+    // Initial guess from the smile: alpha matches the vol nearest the money
+    SABRParams coldStart(const SABRSlice& s) const {
+        std::size_t atm = 0;
+        for (std::size_t i = 1; i < s.strikes.size(); ++i) {
+            if (std::abs(s.strikes[i] - s.forward) < std::abs(s.strikes[atm] - s.forward)) atm = i;
+        }
+        SABRParams p;
+        p.beta = beta_;
+        p.alpha = s.vols[atm] * std::pow(s.forward, 1.0 - beta_);
+        p.rho = 0.0;
+        p.nu = 0.5;
+        return p;
+    }
+
+    SABRFit fitSlice(const SABRSlice& s, const SABRParams& start, Arena& arena) const {
+        const std::size_t n = s.strikes.size();
+        double* r = arena.allocate<double>(n);
+        double* r_trial = arena.allocate<double>(n);
+        double* J = arena.allocate<double>(3 * n);   // Column-major: J[k * n + i] = d r_i / d u_k
+
+        double u[3];
+        toCoordinates(start, u);
+        double cost = residuals(s, u, r);
+        double lambda = 1e-3;
+        SABRFit fit;
+
+        for (int it = 0; it < max_iterations_; ++it) {
+            fit.iterations = it + 1;
+
+            // Forward-difference Jacobian
+            for (int k = 0; k < 3; ++k) {
+                double h = 1e-7 * std::max(1.0, std::abs(u[k]));
+                double saved = u[k];
+                u[k] += h;
+                residuals(s, u, J + k * n);
+                u[k] = saved;
+                for (std::size_t i = 0; i < n; ++i) J[k * n + i] = (J[k * n + i] - r[i]) / h;
+            }
+
+            // Normal equations A = J^T J, g = J^T r
+            double A[3][3], g[3];
+            for (int a = 0; a < 3; ++a) {
+                g[a] = 0.0;
+                for (std::size_t i = 0; i < n; ++i) g[a] += J[a * n + i] * r[i];
+                for (int b = 0; b <= a; ++b) {
+                    double sum = 0.0;
+                    for (std::size_t i = 0; i < n; ++i) sum += J[a * n + i] * J[b * n + i];
+                    A[a][b] = A[b][a] = sum;
+                }
+            }
+
+            // Damped steps until the error decreases
+            bool improved = false;
+            double new_cost = cost;
+            double step_norm = 0.0;
+            for (int attempt = 0; attempt < 20 && !improved; ++attempt) {
+                double M[3][3];
+                for (int a = 0; a < 3; ++a) {
+                    for (int b = 0; b < 3; ++b) M[a][b] = A[a][b];
+                    M[a][a] += lambda * std::max(A[a][a], 1e-12);
+                }
+                double delta[3];
+                if (!solve3(M, g, delta)) {
+                    lambda *= 10.0;
+                    continue;
+                }
+                double trial[3] = {u[0] - delta[0], u[1] - delta[1], u[2] - delta[2]};
+                new_cost = residuals(s, trial, r_trial);
+                if (new_cost < cost) {
+                    improved = true;
+                    step_norm = std::abs(delta[0]) + std::abs(delta[1]) + std::abs(delta[2]);
+                    std::copy(trial, trial + 3, u);
+                    std::copy(r_trial, r_trial + n, r);
+                    lambda = std::max(lambda / 3.0, 1e-12);
+                } else {
+                    lambda *= 4.0;
+                }
+            }
+
+            if (!improved) {
+                fit.converged = true;   // No descent direction left: at a (local) minimum
+                break;
+            }
+            double decrease = cost - new_cost;
+            cost = new_cost;
+            if (decrease <= tolerance_ * std::max(cost, 1e-300) || step_norm < 1e-12 || cost < 1e-24) {
+                fit.converged = true;
+                break;
+            }
+        }
+
+        fit.params = fromCoordinates(u);
+        fit.rmse = n > 0 ? std::sqrt(cost / n) : 0.0;
+        return fit;
+    }
+
+    // Solves the 3x3 system M x = g (Cramer's rule); false if singular
+    static bool solve3(const double M[3][3], const double* g, double* x) {
+        double det = M[0][0] * (M[1][1] * M[2][2] - M[1][2] * M[2][1])
+                   - M[0][1] * (M[1][0] * M[2][2] - M[1][2] * M[2][0])
+                   + M[0][2] * (M[1][0] * M[2][1] - M[1][1] * M[2][0]);
+        if (!(std::abs(det) > 1e-300)) return false;
+        for (int c = 0; c < 3; ++c) {
+            double m[3][3];
+            for (int a = 0; a < 3; ++a) {
+                for (int b = 0; b < 3; ++b) m[a][b] = (b == c) ? g[a] : M[a][b];
+            }
+            x[c] = (m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+                  - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+                  + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0])) / det;
+        }
+        return true;
+    }
+
+public:
+    explicit SABRCalibrator(double beta = 1.0, Executor& executor = defaultExecutor())
+        : beta_(beta), executor_(&executor) {}
+
+    void setExecutor(Executor& executor) { executor_ = &executor; }
+    void setMaxIterations(int iterations) { max_iterations_ = std::max(1, iterations); }
+    double getBeta() const { return beta_; }
+
+    // Forget previous fits: the next calibration starts cold
+    void resetWarmStart() { warm_.clear(); }
+
+    // Fits every expiry of the surface (one fit per slice, in order)
+    std::vector<SABRFit> calibrate(const std::vector<SABRSlice>& surface) {
+        for (const SABRSlice& s : surface) {
+            if (s.strikes.size() != s.vols.size() || s.strikes.size() < 3 ||
+                (!s.weights.empty() && s.weights.size() != s.strikes.size())) {
+                throw std::invalid_argument("SABRCalibrator: each slice needs >= 3 strikes with matching vols/weights");
+            }
+        }
+        std::vector<SABRFit> fits(surface.size());
+        const bool warm = warm_.size() == surface.size();
+        workspaces_.prepare(executor_->concurrency());
+
+        executor_->parallelFor(surface.size(), [&](std::size_t begin, std::size_t end, int worker) {
+            Arena& arena = workspaces_.arena(worker);
+            for (std::size_t e = begin; e < end; ++e) {
+                SABRParams start = warm ? warm_[e] : coldStart(surface[e]);
+                start.beta = beta_;
+                fits[e] = fitSlice(surface[e], start, arena);
+            }
+        });
+
+        warm_.resize(surface.size());
+        for (std::size_t e = 0; e < surface.size(); ++e) warm_[e] = fits[e].params;
+        return fits;
+    }
+};
+
+#endif // SABR_H
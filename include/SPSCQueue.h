@@ -0,0 +1,79 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+// Capacity is rounded up to a power of two; head and tail live on separate cache lines
+// and each side keeps a cached copy of the other index to avoid cross-core traffic.
+template <typename T>
+class SPSCQueue {
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    std::vector<T> buffer_;
+    std::size_t mask_;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> head_{0}; // next slot to read (consumer)
+    alignas(CACHE_LINE) std::size_t cachedTail_ = 0;        // consumer's view of tail_
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0}; // next slot to write (producer)
+    alignas(CACHE_LINE) std::size_t cachedHead_ = 0;        // producer's view of head_
+
+    static std::size_t roundUp(std::size_t n) {
+        std::size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+public:
+    explicit SPSCQueue(std::size_t capacity)
+        : buffer_(roundUp(capacity)), mask_(buffer_.size() - 1) {}
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    // Producer side: returns false when the queue is full
+    bool tryPush(const T& item) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == buffer_.size()) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == buffer_.size()) return false;
+        }
+        buffer_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: returns false when the queue is empty
+    bool tryPop(T& item) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) return false;
+        }
+        item = buffer_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: pops up to max_items into out, returns the number popped
+    std::size_t popBatch(T* out, std::size_t max_items) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (cachedTail_ - head < max_items) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+        }
+        std::size_t available = cachedTail_ - head;
+        std::size_t n = available < max_items ? available : max_items;
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = buffer_[(head + i) & mask_];
+        }
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    std::size_t capacity() const { return buffer_.size(); }
+};
+
+#endif // SPSC_QUEUE_H
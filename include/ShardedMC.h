@@ -0,0 +1,215 @@
+#ifndef SHARDED_MC_H
+#define SHARDED_MC_H
+
+#include "Executor.h"
+#include "MCAccumulator.h"
+#include "EuropeanOption.h"
+#include "MonteCarlo.h"
+#include "PricingProtocol.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Chunks [first, last) of a Monte Carlo run
+struct ChunkRange {
+    std::uint64_t first = 0;
+    std::uint64_t last = 0;
+};
+
+// Shard 'index' of 'shards' contiguous ranges covering 'chunks' (sizes differ by at most one).
+// Also the split to use when shards run in other containers or hosts.
+inline ChunkRange shardRange(std::uint64_t chunks, int shards, int index) {
+    std::uint64_t base = chunks / shards, extra = chunks % shards;
+    std::uint64_t i = static_cast<std::uint64_t>(index);
+    ChunkRange r;
+    r.first = i * base + std::min(i, extra);
+    r.last = r.first + base + (i < extra ? 1 : 0);
+    return r;
+}
+
+// Threads of the calling process (/proc/self/task), or -1 where that cannot be read
+inline int processThreadCount() {
+    DIR* dir = ::opendir("/proc/self/task");
+    if (!dir) return -1;
+    int count = 0;
+    while (const dirent* entry = ::readdir(dir)) {
+        if (entry->d_name[0] != '.') ++count;
+    }
+    ::closedir(dir);
+    return count;
+}
+
+// Monte Carlo spread over local worker processes.
+// The workers are forked once, by the constructor, which must run while the process is still
+// single-threaded (first thing in main(), before any executor or OpenMP region starts): a
+// child forked from a multithreaded process inherits the locks other threads held (malloc,
+// stdio) and may not start threads of its own. The constructor checks this and throws
+// std::logic_error otherwise. Each worker then serves jobs on a socket pair with its own
+// thread pool: a job is the pricer's configuration, a vanilla option (EuropeanOption), the
+// market and a chunk range, and the reply is the serialised MCAccumulator, which the
+// coordinator merges. Chunk c always draws CounterRNG(seed, c) and accumulators merge
+// exactly, so the result is bitwise identical to MonteCarloPricer::accumulate() over all
+// chunks in one process, for any process count. Separate processes can be pinned to one
+// socket each (numactl), and the same shards can be run in containers with
+// accumulate(first, last), their bytes shipped back and merged. One coordinator thread at a
+// time may call accumulate().
+class ShardedMonteCarlo {
+private:
+    // One shard of one accumulate() call, sent as raw bytes to a worker of the same binary
+    struct Job {
+        std::int32_t numSimulations;
+        std::uint32_t seed;
+        std::int32_t chunkSize;
+        std::int32_t antithetic;
+        std::int32_t type;      // 0 = Call, 1 = Put
+        std::int32_t reserved;
+        double strike;
+        double volatility;
+        ExpiryContext market;
+        std::uint64_t first;
+        std::uint64_t last;
+    };
+
+    struct Worker {
+        pid_t pid;
+        int fd;
+    };
+
+    int processes_;
+    int threads_per_process_;
+    std::vector<Worker> workers_;
+    bool failed_ = false;
+
+    // Worker process: prices jobs until the coordinator closes its end
+    static void serve(int fd, int threads) {
+        ThreadPoolExecutor pool(threads);
+        Job job;
+        while (PricingProtocol::readAll(fd, &job, sizeof(job))) {
+            MonteCarloPricer pricer(job.numSimulations, job.seed, pool);
+            pricer.setDeterministic(true, job.chunkSize);
+            EuropeanOption option(job.strike, job.market.maturity, job.type == 0 ? OptionType::CALL : OptionType::PUT);
+            std::string bytes =
+                pricer.accumulate(option, job.market, job.volatility, job.antithetic != 0, job.first, job.last).serialize();
+            if (!PricingProtocol::writeAll(fd, bytes.data(), bytes.size())) return;
+        }
+    }
+
+    void shutdown() {
+        for (const Worker& w : workers_) ::close(w.fd);   // Workers leave on end of file
+        for (const Worker& w : workers_) ::waitpid(w.pid, nullptr, 0);
+        workers_.clear();
+    }
+
+    // Sends one shard to every worker, then merges the replies
+    MCAccumulator run(const MonteCarloPricer& pricer, const Option& option, const ExpiryContext& market,
+                      double volatility, bool use_antithetic) {
+        if (!dynamic_cast<const EuropeanOption*>(&option)) {
+            throw std::invalid_argument("ShardedMonteCarlo: workers price EuropeanOption payoffs only");
+        }
+        if (failed_) throw std::runtime_error("ShardedMonteCarlo: a worker process failed");
+
+        Job job = {};
+        job.numSimulations = pricer.getNumSimulations();
+        job.seed = pricer.getSeed();
+        job.chunkSize = pricer.getChunkSize();
+        job.antithetic = use_antithetic ? 1 : 0;
+        job.type = option.getType() == OptionType::CALL ? 0 : 1;
+        job.strike = option.getStrike();
+        job.volatility = volatility;
+        job.market = market;
+        const std::uint64_t chunks = pricer.numChunks(use_antithetic);
+
+        bool ok = true;
+        for (int s = 0; s < processes_; ++s) {
+            ChunkRange r = shardRange(chunks, processes_, s);
+            job.first = r.first;
+            job.last = r.last;
+            ok = PricingProtocol::writeAll(workers_[s].fd, &job, sizeof(job)) && ok;
+        }
+        MCAccumulator total;
+        for (int s = 0; s < processes_ && ok; ++s) {
+            std::string bytes(MCAccumulator::SERIALIZED_SIZE, '\0');
+            if (!PricingProtocol::readAll(workers_[s].fd, &bytes[0], bytes.size())) {
+                ok = false;
+                break;
+            }
+            total.merge(MCAccumulator::deserialize(bytes));
+        }
+        if (!ok) {
+            failed_ = true;   // Replies may be out of step now: the workers are not reused
+            throw std::runtime_error("ShardedMonteCarlo: a worker process failed");
+        }
+        return total;
+    }
+
+public:
+    // threads_per_process = 0: all hardware threads in each process
+    explicit ShardedMonteCarlo(int processes, int threads_per_process = 0)
+        : processes_(std::max(1, processes)), threads_per_process_(threads_per_process) {
+        if (processThreadCount() > 1) {
+            throw std::logic_error("ShardedMonteCarlo: construct it before any thread is started (fork)");
+        }
+        for (int s = 0; s < processes_; ++s) {
+            int fds[2];
+            if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+                shutdown();
+                throw std::runtime_error("ShardedMonteCarlo: socketpair failed");
+            }
+            pid_t pid = ::fork();
+            if (pid < 0) {
+                ::close(fds[0]);
+                ::close(fds[1]);
+                shutdown();
+                throw std::runtime_error("ShardedMonteCarlo: fork failed");
+            }
+            if (pid == 0) {
+                // Child: serve jobs, leave without running the parent's atexit handlers or
+                // flushing its stdio buffers
+                ::close(fds[0]);
+                for (const Worker& w : workers_) ::close(w.fd);
+                int status = 0;
+                try {
+                    serve(fds[1], threads_per_process_);
+                } catch (...) {
+                    status = 2;
+                }
+                ::close(fds[1]);
+                ::_exit(status);
+            }
+            ::close(fds[1]);
+            workers_.push_back({pid, fds[0]});
+        }
+    }
+
+    ~ShardedMonteCarlo() { shutdown(); }
+
+    ShardedMonteCarlo(const ShardedMonteCarlo&) = delete;
+    ShardedMonteCarlo& operator=(const ShardedMonteCarlo&) = delete;
+
+    int processes() const { return processes_; }
+
+    MCAccumulator accumulate(const MonteCarloPricer& pricer, const Option& option, double spot, double rate,
+                             double volatility, bool use_antithetic = true) {
+        // Flat market: the same drift and discount factor as the scalar accumulate()
+        ExpiryContext market;
+        market.maturity = option.getMaturity();
+        market.spot = spot;
+        market.rate = rate;
+        market.discount = std::exp(-rate * market.maturity);
+        return run(pricer, option, market, volatility, use_antithetic);
+    }
+
+    MCAccumulator accumulate(const MonteCarloPricer& pricer, const Option& option, const ExpiryContext& ctx,
+                             double volatility, bool use_antithetic = true) {
+        return run(pricer, option, ctx, volatility, use_antithetic);
+    }
+};
+
+#endif // SHARDED_MC_H
@@ -0,0 +1,242 @@
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Vectorizable exp / log / sqrt for the simulation kernels.
+//
+// libm's exp and log are opaque calls, and std::sqrt keeps an errno path for negative
+// inputs, so none of them vectorize: the step loop of the Heston kernel and the terminal
+// loop of the MC kernel run one path at a time. The functions below are branch-free
+// arithmetic (range reduction, polynomial, exponent bits built with integer shifts), which
+// the compiler inlines and vectorizes at the width of the target (SSE2, AVX2, AVX-512,
+// NEON), in double or float. Like other non-IEEE SIMD math, they skip the special cases:
+// exp takes |x| <= EXP_RANGE (1400 in double, 170 in float; NaN propagates), log and sqrt expect positive normal inputs
+// (and sqrt also 0); infinities, negatives and subnormals give unspecified values.
+// Loops that call them vectorize at -O3, or at -O2 under SIMD_LOOP.
+//
+// Kernels are instantiated with a policy type:
+//  - LibmMath:    the standard library (reference; the default, results unchanged);
+//  - PreciseMath: full precision, within a few ulp of libm;
+//  - FastMath:    shorter polynomials and one Newton step less, relative error ~1e-10 in
+//                 double (~1e-6 in float), well below the Monte Carlo error.
+// test_simdmath measures the error and throughput of each tier.
+enum class MathPolicy {
+    LIBM,
+    PRECISE,
+    FAST
+};
+
+// Asks the compiler to vectorize the next loop (OpenMP simd; nothing without OpenMP).
+// Only for loops whose iterations are independent.
+#if defined(_OPENMP)
+#define SIMD_LOOP _Pragma("omp simd")
+#else
+#define SIMD_LOOP
+#endif
+
+namespace SimdMath {
+
+template <typename To, typename From>
+inline To bitCast(From x) {
+    static_assert(sizeof(To) == sizeof(From), "bitCast: size mismatch");
+    To y;
+    std::memcpy(&y, &x, sizeof(To));
+    return y;
+}
+
+// Layout of the floating-point type, and the range of each function
+template <typename Real> struct Traits;
+
+template <> struct Traits<double> {
+    using Bits = std::uint64_t;
+    static constexpr int MANTISSA = 52;
+    static constexpr Bits BIAS = 1023;
+    static constexpr double SHIFTER = 6755399441055744.0;        // 1.5 2^52: x + SHIFTER rounds x to an integer
+    static constexpr double TWO_MANTISSA = 4503599627370496.0;   // 2^52
+    static constexpr double EXP_RANGE = 1400.0;                  // Each half of 2^n stays a normal number
+    static constexpr double LN2_HI = 6.93147180369123816490e-01; // ln 2 in two parts (Cody-Waite)
+    static constexpr double LN2_LO = 1.90821492927058770002e-10;
+    static constexpr Bits RSQRT_MAGIC = 0x5FE6EB50C7B537A9ull;    // First guess of 1/sqrt(x) from the bits
+};
+
+template <> struct Traits<float> {
+    using Bits = std::uint32_t;
+    static constexpr int MANTISSA = 23;
+    static constexpr Bits BIAS = 127;
+    static constexpr float SHIFTER = 12582912.0f;                // 1.5 2^23
+    static constexpr float TWO_MANTISSA = 8388608.0f;            // 2^23
+    static constexpr float EXP_RANGE = 170.0f;
+    static constexpr float LN2_HI = 6.9314575195e-01f;
+    static constexpr float LN2_LO = 1.4286068203e-06f;
+    static constexpr Bits RSQRT_MAGIC = 0x5F375A86u;
+};
+
+// 2^n for an integer-valued n held as Real, |n| well inside the exponent range
+template <typename Real>
+inline Real exp2Integer(Real n) {
+    using T = Traits<Real>;
+    using Bits = typename T::Bits;
+    // The low bits of n + SHIFTER are 2^(MANTISSA-1) + n: shifted into the exponent field,
+    // the 2^(MANTISSA-1) term falls off the top of the word and n remains
+    Bits bits = bitCast<Bits>(static_cast<Real>(n + T::SHIFTER));
+    return bitCast<Real>(static_cast<Bits>((bits + T::BIAS) << T::MANTISSA));
+}
+
+// The series and iterations below are unrolled at compile time: a loop left inside the
+// function would keep the caller's loop from vectorizing.
+
+// 1 + r/K (1 + r/(K+1) (... (1 + r/DEGREE))): Horner form of the Taylor series of e^r
+template <typename Real, int K, int DEGREE>
+inline Real expSeries(Real r) {
+    if constexpr (K > DEGREE) {
+        return Real(1);
+    } else {
+        return 1 + (r * static_cast<Real>(1.0 / K)) * expSeries<Real, K + 1, DEGREE>(r);
+    }
+}
+
+// sum_{k < TERMS} s2^k / (2k + 1), Horner form
+template <typename Real, int K, int TERMS>
+inline Real atanhSeries(Real s2) {
+    if constexpr (K + 1 == TERMS) {
+        return static_cast<Real>(1.0 / (2 * K + 1));
+    } else {
+        return static_cast<Real>(1.0 / (2 * K + 1)) + s2 * atanhSeries<Real, K + 1, TERMS>(s2);
+    }
+}
+
+// ITERATIONS Newton steps y <- y (3/2 - x/2 y^2) towards 1/sqrt(x)
+template <typename Real, int ITERATIONS>
+inline Real rsqrtNewton(Real y, Real half_x) {
+    if constexpr (ITERATIONS == 0) {
+        return y;
+    } else {
+        return rsqrtNewton<Real, ITERATIONS - 1>(y * (static_cast<Real>(1.5) - (half_x * y) * y), half_x);
+    }
+}
+
+// e^x = 2^n e^r with n = round(x / ln 2), |r| <= ln 2 / 2, and e^r from its Taylor series
+// of the given degree. 2^n is applied in two halves, so subnormal results, underflow to 0
+// and overflow to +inf come out right for |x| <= EXP_RANGE without a clamp (a clamp is a
+// branch that the compiler may duplicate, which stops the vectorizer).
+template <typename Real, int DEGREE>
+inline Real exp(Real x) {
+    using T = Traits<Real>;
+    const Real LOG2E = static_cast<Real>(1.4426950408889634);
+    const Real n = (x * LOG2E + T::SHIFTER) - T::SHIFTER;
+    const Real r = (x - n * T::LN2_HI) - n * T::LN2_LO;
+    const Real half = (n * static_cast<Real>(0.5) + T::SHIFTER) - T::SHIFTER;
+    return expSeries<Real, 1, DEGREE>(r) * exp2Integer(half) * exp2Integer(n - half);
+}
+
+// ln x = e ln 2 + ln m with x = 2^e m, m in [sqrt(1/2), sqrt(2)), and
+// ln m = 2 atanh(s) = 2 (s + s^3/3 + s^5/5 + ...), s = (m - 1) / (m + 1), |s| < 0.172.
+// Adding (1 - sqrt(1/2)) to the bits carries into the exponent exactly when the mantissa
+// is >= sqrt(2), which picks e and m without a comparison.
+template <typename Real, int TERMS>
+inline Real log(Real x) {
+    using T = Traits<Real>;
+    using Bits = typename T::Bits;
+    const Bits ONE = T::BIAS << T::MANTISSA;
+    const Bits INV_SQRT2 = bitCast<Bits>(static_cast<Real>(0.70710678118654752));
+    const Bits MANTISSA_MASK = (Bits(1) << T::MANTISSA) - 1;
+    const Bits bits = bitCast<Bits>(x) + (ONE - INV_SQRT2);
+
+    // Exponent field as a Real: (2^MANTISSA + field) - 2^MANTISSA
+    const Bits field = bits >> T::MANTISSA;
+    const Real e = (bitCast<Real>(static_cast<Bits>(field | bitCast<Bits>(T::TWO_MANTISSA))) - T::TWO_MANTISSA) -
+                   static_cast<Real>(T::BIAS);
+    const Real m = bitCast<Real>(static_cast<Bits>((bits & MANTISSA_MASK) + INV_SQRT2));
+
+    const Real s = (m - 1) / (m + 1);
+    const Real p = atanhSeries<Real, 0, TERMS>(s * s);
+    return e * T::LN2_HI + (2 * s * p + e * T::LN2_LO);
+}
+
+// sqrt x = x / sqrt(x): a first guess of 1/sqrt(x) from the bits (relative error < 3.5%),
+// ITERATIONS Newton steps on 1/sqrt(x) (each squares the error), then one Newton step on
+// the square root itself (Markstein), which squares it once more. sqrt(0) = 0.
+// libm's scalar sqrt is a single instruction; this one is only worth it when it lets the
+// surrounding loop vectorize.
+template <typename Real, int ITERATIONS>
+inline Real sqrt(Real x) {
+    using T = Traits<Real>;
+    using Bits = typename T::Bits;
+    Real y = bitCast<Real>(static_cast<Bits>(T::RSQRT_MAGIC - (bitCast<Bits>(x) >> 1)));
+    // (x/2 y) y rather than x/2 (y y): y is huge for x = 0 and y^2 would overflow
+    const Real half_x = static_cast<Real>(0.5) * x;
+    y = rsqrtNewton<Real, ITERATIONS>(y, half_x);
+    // s + y/2 (x - s^2), written as s + s/2 (1 - s y): x - s^2 is subnormal for small x
+    const Real s = x * y;
+    return s + static_cast<Real>(0.5) * s * (1 - s * y);
+}
+
+// Polynomial degrees and iteration counts of each tier, per type
+template <typename Real> struct Precise;
+template <> struct Precise<double> { static constexpr int EXP = 13, LOG = 10, RSQRT = 3; };
+template <> struct Precise<float> { static constexpr int EXP = 7, LOG = 5, RSQRT = 2; };
+
+template <typename Real> struct Fast;
+template <> struct Fast<double> { static constexpr int EXP = 9, LOG = 6, RSQRT = 2; };
+template <> struct Fast<float> { static constexpr int EXP = 5, LOG = 3, RSQRT = 1; };
+
+} // namespace SimdMath
+
+// --- POLICIES ---
+
+struct LibmMath {
+    static constexpr MathPolicy policy = MathPolicy::LIBM;
+    template <typename Real> static Real exp(Real x) { return std::exp(x); }
+    template <typename Real> static Real log(Real x) { return std::log(x); }
+    template <typename Real> static Real sqrt(Real x) { return std::sqrt(x); }
+};
+
+struct PreciseMath {
+    static constexpr MathPolicy policy = MathPolicy::PRECISE;
+    template <typename Real> static Real exp(Real x) {
+        return SimdMath::exp<Real, SimdMath::Precise<Real>::EXP>(x);
+    }
+    template <typename Real> static Real log(Real x) {
+        return SimdMath::log<Real, SimdMath::Precise<Real>::LOG>(x);
+    }
+    template <typename Real> static Real sqrt(Real x) {
+        return SimdMath::sqrt<Real, SimdMath::Precise<Real>::RSQRT>(x);
+    }
+};
+
+struct FastMath {
+    static constexpr MathPolicy policy = MathPolicy::FAST;
+    template <typename Real> static Real exp(Real x) {
+        return SimdMath::exp<Real, SimdMath::Fast<Real>::EXP>(x);
+    }
+    template <typename Real> static Real log(Real x) {
+        return SimdMath::log<Real, SimdMath::Fast<Real>::LOG>(x);
+    }
+    template <typename Real> static Real sqrt(Real x) {
+        return SimdMath::sqrt<Real, SimdMath::Fast<Real>::RSQRT>(x);
+    }
+};
+
+// Calls f(Policy{}) with the policy type selected at run time, so a kernel is instantiated
+// once per tier and the choice is made outside its loops
+template <typename F>
+inline decltype(auto) withMathPolicy(MathPolicy policy, F&& f) {
+    switch (policy) {
+    case MathPolicy::PRECISE: return f(PreciseMath{});
+    case MathPolicy::FAST: return f(FastMath{});
+    default: return f(LibmMath{});
+    }
+}
+
+inline const char* mathPolicyName(MathPolicy policy) {
+    switch (policy) {
+    case MathPolicy::PRECISE: return "precise";
+    case MathPolicy::FAST: return "fast";
+    default: return "libm";
+    }
+}
+
+#endif // SIMD_MATH_H
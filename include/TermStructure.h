@@ -0,0 +1,159 @@
+#ifndef TERM_STRUCTURE_H
+#define TERM_STRUCTURE_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// Continuously compounded zero curve.
+// Pillars are (time, zero rate); log discount factors are interpolated linearly in time
+// (piecewise-flat forwards) and the curve is flat beyond its first and last pillar.
+// Pillar discount factors are computed once at construction.
+class YieldCurve {
+private:
+    std::vector<double> times_;
+    std::vector<double> zeros_;
+    std::vector<double> log_discounts_;   // -r_i * t_i at each pillar
+
+    // Index i such that times_[i] <= t < times_[i + 1] (t strictly inside the pillar range)
+    std::size_t segment(double t) const {
+        return static_cast<std::size_t>(std::upper_bound(times_.begin(), times_.end(), t) - times_.begin()) - 1;
+    }
+
+public:
+    // Flat curve at 'rate'
+    explicit YieldCurve(double rate = 0.0) : times_{1.0}, zeros_{rate}, log_discounts_{-rate} {}
+
+    YieldCurve(const std::vector<double>& times, const std::vector<double>& zero_rates)
+        : times_(times), zeros_(zero_rates) {
+        if (times_.empty() || times_.size() != zeros_.size()) {
+            throw std::invalid_argument("YieldCurve: need as many zero rates as pillar times");
+        }
+        for (std::size_t i = 0; i < times_.size(); ++i) {
+            if (times_[i] <= 0.0 || (i > 0 && times_[i] <= times_[i - 1])) {
+                throw std::invalid_argument("YieldCurve: pillar times must be positive and increasing");
+            }
+            log_discounts_.push_back(-zeros_[i] * times_[i]);
+        }
+    }
+
+    static YieldCurve flat(double rate) { return YieldCurve(rate); }
+
+    // Zero rate to time t (flat extrapolation, so a flat curve returns its rate exactly)
+    double zeroRate(double t) const {
+        if (t <= times_.front()) return zeros_.front();
+        if (t >= times_.back()) return zeros_.back();
+        std::size_t i = segment(t);
+        double w = (t - times_[i]) / (times_[i + 1] - times_[i]);
+        double log_df = log_discounts_[i] + w * (log_discounts_[i + 1] - log_discounts_[i]);
+        return -log_df / t;
+    }
+
+    double discount(double t) const { return std::exp(-zeroRate(t) * t); }
+
+    // Continuously compounded forward rate between t1 and t2
+    double forwardRate(double t1, double t2) const {
+        return (zeroRate(t2) * t2 - zeroRate(t1) * t1) / (t2 - t1);
+    }
+
+    bool isFlat() const { return times_.size() == 1; }
+    const std::vector<double>& times() const { return times_; }
+    const std::vector<double>& zeroRates() const { return zeros_; }
+
+    bool operator==(const YieldCurve& o) const { return times_ == o.times_ && zeros_ == o.zeros_; }
+    bool operator!=(const YieldCurve& o) const { return !(*this == o); }
+};
+
+// Cash dividend paid at 'time' (years from today)
+struct CashDividend {
+    double time;
+    double amount;
+
+    bool operator==(const CashDividend& o) const { return time == o.time && amount == o.amount; }
+};
+
+// Dividends of one underlying: a continuous yield term structure and/or discrete cash amounts.
+// Cash dividends use the escrowed model: the spot that diffuses is S minus the present value
+// of the dividends paid before expiry.
+class DividendCurve {
+private:
+    YieldCurve yield_;
+    std::vector<CashDividend> cash_;   // Sorted by time
+
+public:
+    DividendCurve() = default;
+    explicit DividendCurve(double yield) : yield_(yield) {}
+    DividendCurve(const YieldCurve& yield, const std::vector<CashDividend>& cash = {})
+        : yield_(yield), cash_(cash) {
+        std::sort(cash_.begin(), cash_.end(), [](const CashDividend& a, const CashDividend& b) {
+            return a.time < b.time;
+        });
+    }
+
+    // Equivalent continuous yield to time t
+    double yield(double t) const { return yield_.zeroRate(t); }
+
+    // Present value of the cash dividends paid in (0, t]
+    double cashPresentValue(double t, const YieldCurve& rates) const {
+        double pv = 0.0;
+        for (const CashDividend& d : cash_) {
+            if (d.time > t) break;
+            if (d.time > 0.0) pv += d.amount * rates.discount(d.time);
+        }
+        return pv;
+    }
+
+    const std::vector<CashDividend>& cash() const { return cash_; }
+    const YieldCurve& yieldCurve() const { return yield_; }
+
+    bool operator==(const DividendCurve& o) const { return yield_ == o.yield_ && cash_ == o.cash_; }
+    bool operator!=(const DividendCurve& o) const { return !(*this == o); }
+};
+
+// Everything a European pricer needs for one underlying and one expiry.
+// Computed once per expiry and shared by every strike of the chain, so curve lookups and
+// dividend sums are not repeated per option. Pricers use it as an equivalent flat market:
+// spot (ex-dividend PV), rate and dividend yield constant to expiry.
+struct ExpiryContext {
+    double maturity = 0.0;       // T
+    double spot = 0.0;           // S minus PV of cash dividends paid before T
+    double rate = 0.0;           // Zero rate r(T)
+    double dividendYield = 0.0;  // Continuous yield q(T)
+    double discount = 1.0;       // exp(-r(T) T)
+    double forward = 0.0;        // spot * exp((r(T) - q(T)) T)
+};
+
+// Resolves the curves at expiry T for an underlying quoted at 'spot'
+inline ExpiryContext makeExpiryContext(double spot, double T, const YieldCurve& rates, const DividendCurve& dividends) {
+    ExpiryContext ctx;
+    ctx.maturity = T;
+    ctx.rate = rates.zeroRate(T);
+    ctx.dividendYield = dividends.yield(T);
+    ctx.spot = spot - dividends.cashPresentValue(T, rates);
+    ctx.discount = std::exp(-ctx.rate * T);
+    ctx.forward = ctx.spot * std::exp((ctx.rate - ctx.dividendYield) * T);
+    return ctx;
+}
+
+// Rates and dividends of one underlying
+class MarketCurves {
+private:
+    YieldCurve rates_;
+    DividendCurve dividends_;
+
+public:
+    explicit MarketCurves(const YieldCurve& rates = YieldCurve(), const DividendCurve& dividends = DividendCurve())
+        : rates_(rates), dividends_(dividends) {}
+
+    ExpiryContext expiry(double spot, double T) const {
+        return makeExpiryContext(spot, T, rates_, dividends_);
+    }
+
+    const YieldCurve& rates() const { return rates_; }
+    const DividendCurve& dividends() const { return dividends_; }
+    void setRates(const YieldCurve& rates) { rates_ = rates; }
+    void setDividends(const DividendCurve& dividends) { dividends_ = dividends; }
+};
+
+#endif // TERM_STRUCTURE_H
@@ -0,0 +1,181 @@
+#ifndef TUNING_H
+#define TUNING_H
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+// Machine-specific kernel settings, measured on the host by the autotuner (Autotune.h) and
+// persisted as a small "key = value" text file. The pricers read them once at startup through
+// machineTuning(): the default executor takes its kind and thread count from them, and
+// MonteCarloPricer / HestonPricer their RNG block size and tile width.
+// Block size and tile width only change how draws are batched, never which draw a path
+// gets, so they leave prices unchanged. The executor's worker count does not: standard-mode
+// MC and Heston draw one RNG stream per worker, so a tuned thread count changes their seeded
+// prices (by sampling noise) against untuned runs or other machines. Deterministic-mode MC
+// (and everything analytic) is unaffected. Such a file is flagged in MachineTuning::status,
+// which the programs print at startup.
+struct TuningConfig {
+    std::string executor = "openmp";   // "openmp" or "thread-pool"
+    int threads = 0;                    // Workers of the default executor (0 = all hardware threads)
+    bool pinThreads = false;            // Thread pool only: workers pinned NUMA node by node
+    int mcBlockSize = 1024;             // Normals drawn per batch by MonteCarloPricer::price()
+    int hestonTileWidth = 16;           // Paths stepped together by HestonPricer
+
+    // Where the settings were measured; a file copied to another host is not applied
+    std::string machine;
+    unsigned int hardwareThreads = 0;
+
+    static std::string thisMachine() {
+#if defined(__unix__) || defined(__APPLE__)
+        char name[256] = {};
+        if (gethostname(name, sizeof(name) - 1) == 0 && name[0] != '\0') return name;
+#endif
+        return "unknown";
+    }
+
+    // Stamps the settings with the current host
+    void stampMachine() {
+        machine = thisMachine();
+        hardwareThreads = std::thread::hardware_concurrency();
+    }
+
+    bool matchesThisMachine() const {
+        return machine == thisMachine() && hardwareThreads == std::thread::hardware_concurrency();
+    }
+
+    // True when the default executor would not have its built-in worker count, i.e. seeded
+    // standard-mode MC / Heston prices differ from those of an untuned run
+    bool changesStandardPrices() const {
+        const TuningConfig builtin;
+        return threads != builtin.threads || executor != builtin.executor;
+    }
+
+    bool operator==(const TuningConfig& o) const {
+        return executor == o.executor && threads == o.threads && pinThreads == o.pinThreads &&
+               mcBlockSize == o.mcBlockSize && hestonTileWidth == o.hestonTileWidth;
+    }
+    bool operator!=(const TuningConfig& o) const { return !(*this == o); }
+
+    std::string describe() const {
+        std::ostringstream s;
+        s << executor << (pinThreads ? " (pinned)" : "") << " x" << (threads > 0 ? std::to_string(threads) : "all")
+          << ", MC block " << mcBlockSize << ", Heston tile " << hestonTileWidth;
+        return s.str();
+    }
+
+    // --- PERSISTENCE ---
+    // Unknown keys are ignored (files written by newer versions still load); bad values throw
+
+    void save(const std::string& path) const {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) throw std::runtime_error("TuningConfig: cannot open " + path + " for writing");
+        out << "# Kernel settings measured by the autotuner (Benchmark --autotune)\n"
+            << "machine = " << machine << "\n"
+            << "hardware_threads = " << hardwareThreads << "\n"
+            << "executor = " << executor << "\n"
+            << "threads = " << threads << "\n"
+            << "pin_threads = " << (pinThreads ? 1 : 0) << "\n"
+            << "mc_block_size = " << mcBlockSize << "\n"
+            << "heston_tile_width = " << hestonTileWidth << "\n";
+        if (!out) throw std::runtime_error("TuningConfig: write failed for " + path);
+    }
+
+    static TuningConfig load(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("TuningConfig: cannot open " + path);
+        TuningConfig c;
+        std::string line;
+        while (std::getline(in, line)) {
+            std::size_t eq = line.find('=');
+            if (line.empty() || line[0] == '#' || eq == std::string::npos) continue;
+            std::string key = trim(line.substr(0, eq));
+            std::string value = trim(line.substr(eq + 1));
+            if (key == "machine") c.machine = value;
+            else if (key == "hardware_threads") c.hardwareThreads = static_cast<unsigned int>(integer(value, key, 0, 1 << 20, path));
+            else if (key == "executor") c.executor = value;
+            else if (key == "threads") c.threads = integer(value, key, 0, 1 << 16, path);
+            else if (key == "pin_threads") c.pinThreads = integer(value, key, 0, 1, path) == 1;
+            else if (key == "mc_block_size") c.mcBlockSize = integer(value, key, 1, 1 << 20, path);
+            else if (key == "heston_tile_width") c.hestonTileWidth = integer(value, key, 1, 4096, path);
+        }
+        if (c.executor != "openmp" && c.executor != "thread-pool") {
+            throw std::runtime_error("TuningConfig: unknown executor '" + c.executor + "' in " + path);
+        }
+        return c;
+    }
+
+    // Settings of 'path' if it exists and was measured on this host, else the built-in
+    // defaults; never throws (a bad file must not stop the pricers from starting)
+    static TuningConfig loadForThisMachine(const std::string& path, std::string* status = nullptr) {
+        auto report = [&](const std::string& s) { if (status) *status = s; };
+        if (!std::ifstream(path)) {
+            report("no tuning file");
+            return TuningConfig();
+        }
+        try {
+            TuningConfig c = load(path);
+            if (!c.matchesThisMachine()) {
+                report("tuned on another machine (" + c.machine + "), ignored");
+                return TuningConfig();
+            }
+            report("loaded " + path);
+            return c;
+        } catch (const std::exception& e) {
+            report(std::string(e.what()) + ", ignored");
+            return TuningConfig();
+        }
+    }
+
+private:
+    static std::string trim(const std::string& s) {
+        std::size_t b = s.find_first_not_of(" \t\r");
+        std::size_t e = s.find_last_not_of(" \t\r");
+        return b == std::string::npos ? std::string() : s.substr(b, e - b + 1);
+    }
+
+    static int integer(const std::string& value, const std::string& key, long lo, long hi, const std::string& path) {
+        char* end = nullptr;
+        long v = std::strtol(value.c_str(), &end, 10);
+        if (value.empty() || *end != '\0' || v < lo || v > hi) {
+            throw std::runtime_error("TuningConfig: bad value '" + value + "' for " + key + " in " + path);
+        }
+        return static_cast<int>(v);
+    }
+};
+
+// Tuning file of this process: $PRICING_TUNING_FILE, else pricing_tuning.cfg in the working directory
+inline std::string tuningFilePath() {
+    const char* env = std::getenv("PRICING_TUNING_FILE");
+    return (env && *env) ? env : "pricing_tuning.cfg";
+}
+
+// Settings of this process, read once on first use from tuningFilePath()
+struct MachineTuning {
+    TuningConfig config;
+    std::string status;   // Why config holds what it holds (for startup banners)
+
+    static const MachineTuning& instance() {
+        static const MachineTuning loaded = []() {
+            MachineTuning t;
+            t.config = TuningConfig::loadForThisMachine(tuningFilePath(), &t.status);
+            if (t.config.changesStandardPrices()) {
+                t.status += "; workers fixed to " + (t.config.threads > 0 ? std::to_string(t.config.threads) : std::string("all")) +
+                            " (" + t.config.executor + "): seeded standard-mode MC/Heston prices differ from untuned runs";
+            }
+            return t;
+        }();
+        return loaded;
+    }
+};
+
+inline const TuningConfig& machineTuning() { return MachineTuning::instance().config; }
+
+#endif // TUNING_H
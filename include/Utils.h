@@ -2,6 +2,7 @@
 #define UTILS_H
 
 #include <cmath>
+#include <cstdint>
 #include <random>
 
 // Constants
@@ -39,18 +40,118 @@ class RandomGenerator {
 private:
     std::mt19937 generator_;
     std::normal_distribution<double> distribution_;
+    std::uniform_real_distribution<double> uniform_;
     
 public:
     RandomGenerator(unsigned int seed = 42) 
-        : generator_(seed), distribution_(0.0, 1.0) {}
+        : generator_(seed), distribution_(0.0, 1.0), uniform_(0.0, 1.0) {}
     
     double getNormal() {
         return distribution_(generator_);
     }
+
+    // Uniform in [0, 1)
+    double getUniform() {
+        return uniform_(generator_);
+    }
     
     void setSeed(unsigned int seed) {
         generator_.seed(seed);
     }
 };
 
+// Arithmetic used for path evolution in the simulation kernels.
+// FLOAT evolves paths in float32 (twice the SIMD width, half the bandwidth) while payoffs
+// are still accumulated in double.
+enum class Precision {
+    DOUBLE,
+    FLOAT
+};
+
+// Counter-based normal generator (Philox4x32-10 + Box-Muller).
+// The stream is a pure function of (seed, stream id), so work split into numbered chunks
+// draws the same numbers whichever thread runs each chunk.
+class CounterRNG {
+private:
+    std::uint32_t key_[2];
+    std::uint32_t counter_[4];
+    double spare_ = 0.0;
+    bool has_spare_ = false;
+
+    static void mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi, std::uint32_t& lo) {
+        std::uint64_t p = static_cast<std::uint64_t>(a) * b;
+        hi = static_cast<std::uint32_t>(p >> 32);
+        lo = static_cast<std::uint32_t>(p);
+    }
+
+    void nextBlock(std::uint32_t out[4]) {
+        std::uint32_t c[4] = {counter_[0], counter_[1], counter_[2], counter_[3]};
+        std::uint32_t k0 = key_[0], k1 = key_[1];
+        for (int round = 0; round < 10; ++round) {
+            std::uint32_t hi0, lo0, hi1, lo1;
+            mulhilo(0xD2511F53u, c[0], hi0, lo0);
+            mulhilo(0xCD9E8D57u, c[2], hi1, lo1);
+            std::uint32_t n[4] = {hi1 ^ c[1] ^ k0, lo1, hi0 ^ c[3] ^ k1, lo0};
+            c[0] = n[0]; c[1] = n[1]; c[2] = n[2]; c[3] = n[3];
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        out[0] = c[0]; out[1] = c[1]; out[2] = c[2]; out[3] = c[3];
+        if (++counter_[0] == 0) ++counter_[1];
+    }
+
+    // Uniform in (0, 1) from 53 random bits
+    static double toUniform(std::uint32_t hi, std::uint32_t lo) {
+        std::uint64_t bits = ((static_cast<std::uint64_t>(hi) << 32) | lo) >> 11;
+        return (static_cast<double>(bits) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+
+public:
+    CounterRNG(std::uint64_t seed, std::uint64_t stream) {
+        key_[0] = static_cast<std::uint32_t>(seed);
+        key_[1] = static_cast<std::uint32_t>(seed >> 32);
+        counter_[0] = 0;
+        counter_[1] = 0;
+        counter_[2] = static_cast<std::uint32_t>(stream);
+        counter_[3] = static_cast<std::uint32_t>(stream >> 32);
+    }
+
+    double getNormal() {
+        if (has_spare_) {
+            has_spare_ = false;
+            return spare_;
+        }
+        std::uint32_t r[4];
+        nextBlock(r);
+        double u1 = toUniform(r[0], r[1]);
+        double u2 = toUniform(r[2], r[3]);
+        double radius = std::sqrt(-2.0 * std::log(u1));
+        double angle = 2.0 * PI * u2;
+        spare_ = radius * std::sin(angle);
+        has_spare_ = true;
+        return radius * std::cos(angle);
+    }
+};
+
+// Compensated (Neumaier) summation: the rounding error of every addition is carried
+// in a separate term, so long sums keep close to full double precision.
+struct NeumaierSum {
+    double sum = 0.0;
+    double compensation = 0.0;
+
+    void add(double x) {
+        double t = sum + x;
+        if (std::abs(sum) >= std::abs(x)) compensation += (sum - t) + x;
+        else compensation += (x - t) + sum;
+        sum = t;
+    }
+
+    void merge(const NeumaierSum& other) {
+        add(other.sum);
+        add(other.compensation);
+    }
+
+    double value() const { return sum + compensation; }
+};
+
 #endif // UTILS_H
\ No newline at end of file
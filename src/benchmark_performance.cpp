@@ -1,85 +1,723 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <string>
+#include <random>
 #include <chrono>
+#include <thread>
+#include <memory>
+#include "Autotune.h"
+#include "BatchPricer.h"
+#include "BenchmarkHarness.h"
 #include "BlackScholes.h"
+#include "ChebyshevSurrogate.h"
+#include "Executor.h"
+#include "ExposureEngine.h"
+#include "HedgeSimulator.h"
+#include "HestonMC.h"
+#include "ImpliedVolatility.h"
+#include "JumpDiffusion.h"
+#include "Instrumentation.h"
 #include "MonteCarlo.h"
+#include "MonteCarloGreeks.h"
+#include "MultiAssetMC.h"
+#include "ResultStore.h"
+#include "SABR.h"
+#include "ShardedMC.h"
+#include "SimdMath.h"
+#include "TermStructure.h"
+#include "Tuning.h"
 
-// Helper function to measure time
-template<typename Func>
-long long measure_execution_time(Func f) {
-    auto start = std::chrono::high_resolution_clock::now();
-    f();
-    auto end = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+void printSeparator() {
+    std::cout << std::string(85, '=') << "\n";
 }
 
-void printSeparator() {
-    std::cout << std::string(70, '=') << "\n";
+void printSection(const std::string& title) {
+    std::cout << "\n" << title << "\n";
+    BenchmarkHarness::printHeader();
 }
 
-int main() {
+// Randomized option inputs, generated once outside the timed region
+struct Inputs {
+    std::vector<double> spot, strike, rate, vol, maturity, price;
+    std::vector<OptionType> type;
+
+    Inputs(std::size_t n, unsigned int seed)
+        : spot(n), strike(n), rate(n), vol(n), maturity(n), price(n), type(n) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+        for (std::size_t i = 0; i < n; ++i) {
+            spot[i] = 80.0 + 40.0 * u(gen);
+            strike[i] = spot[i] * (0.8 + 0.4 * u(gen));
+            rate[i] = 0.05 * u(gen);
+            vol[i] = 0.10 + 0.40 * u(gen);
+            maturity[i] = 0.1 + 2.0 * u(gen);
+            type[i] = u(gen) < 0.5 ? OptionType::CALL : OptionType::PUT;
+            price[i] = BlackScholes(spot[i], strike[i], rate[i], vol[i], maturity[i], type[i]).price();
+        }
+    }
+
+    OptionBatch batch() const {
+        OptionBatch b;
+        b.size = spot.size();
+        b.spot = spot.data(); b.strike = strike.data(); b.rate = rate.data();
+        b.volatility = vol.data(); b.maturity = maturity.data(); b.type = type.data();
+        return b;
+    }
+};
+
+void printUsage() {
+    std::cout << "Usage: benchmark_performance [--quick] [--json FILE] [--threads 1,2,4,...] [--reps N] [--autotune]\n"
+              << "  --autotune  search the kernel settings of this machine, save them to the tuning file\n"
+              << "              ($PRICING_TUNING_FILE or pricing_tuning.cfg) and compare them with the defaults\n";
+}
+
+int main(int argc, char** argv) {
+    // Forked before any thread starts (the default executor may be a thread pool)
+    ShardedMonteCarlo sharded(2, std::max(1, static_cast<int>(std::thread::hardware_concurrency()) / 2));
+    bool quick = false;
+    bool autotune = false;
+    int reps = 10;
+    std::string json_path;
+    std::vector<int> thread_counts;
+    const int max_threads = defaultExecutor().concurrency();
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (arg == "--quick") quick = true;
+        else if (arg == "--autotune") autotune = true;
+        else if (arg == "--json" && has_value) json_path = argv[++i];
+        else if (arg == "--reps" && has_value) reps = std::stoi(argv[++i]);
+        else if (arg == "--threads" && has_value) {
+            std::string list = argv[++i];
+            std::size_t pos = 0;
+            while (pos < list.size()) {
+                std::size_t comma = list.find(',', pos);
+                thread_counts.push_back(std::stoi(list.substr(pos, comma - pos)));
+                pos = (comma == std::string::npos) ? list.size() : comma + 1;
+            }
+        } else { printUsage(); return arg == "--help" ? 0 : 1; }
+    }
+    if (thread_counts.empty()) {
+        for (int t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+        thread_counts.push_back(max_threads);
+    }
+    if (quick) reps = std::min(reps, 3);
+
+    const std::size_t N_BS = quick ? 200'000 : 1'000'000;
+    const std::size_t N_IV = quick ? 20'000 : 100'000;
+    const int MC_PATHS = quick ? 200'000 : 1'000'000;
+    const int GREEK_PATHS = quick ? 50'000 : 200'000;
+    const int HESTON_PATHS = quick ? 5'000 : 20'000;
+    const int HESTON_STEPS = 100;
+    const int BASKET_PATHS = quick ? 20'000 : 100'000;
+    const int BASKET_ASSETS = 50;
+
     printSeparator();
-    std::cout << "   Performance Benchmark: C++ Pricing Engine\n";
+    std::cout << "   Performance Benchmark Suite: C++ Pricing Engine\n";
     printSeparator();
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency()
+              << " | default executor: " << defaultExecutor().name() << " x" << max_threads
+              << " | warm-up 2, repetitions " << reps << "\n";
+    std::cout << "Tuning: " << MachineTuning::instance().status << " (" << machineTuning().describe() << ")\n";
+
+    BenchmarkHarness bench(2, reps);
+    Instrumentation::HardwareCounters hw;
+    if (Instrumentation::enabled()) {
+        std::cout << "Instrumentation: ON (hardware counters "
+                  << (hw.available() ? "available" : "unavailable") << ")\n";
+        hw.start();
+    }
+    Inputs in(N_BS, 12345);
+    std::mt19937 gen(777);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+
+    auto writeReport = [&](const std::map<std::string, std::string>& sections) {
+        if (json_path.empty()) return;
+        std::map<std::string, std::string> context = {
+            {"timestamp", BenchmarkHarness::timestamp()},
+            {"compiler", BenchmarkHarness::compiler()},
+            {"hardware_threads", std::to_string(std::thread::hardware_concurrency())},
+            {"default_executor", defaultExecutor().name()},
+            {"max_threads", std::to_string(max_threads)},
+            {"mode", autotune ? "autotune" : (quick ? "quick" : "full")},
+            {"startup_tuning", machineTuning().describe()},
+            {"instrumentation", Instrumentation::enabled() ? "on" : "off"}
+        };
+        bool ok = bench.writeJson(json_path, context, sections);
+        std::cout << "\n" << (ok ? "JSON report written to " : "Could not write ") << json_path << "\n";
+    };
+
+    // Built-in defaults vs tuned settings on the MC and Heston kernels, each side on the
+    // executor its settings describe (what a fresh process with that tuning file would use)
+    auto compareTuning = [&](const std::string& title, const TuningConfig& tuned) {
+        printSection(title);
+        const TuningConfig builtin;
+        std::unique_ptr<Executor> builtin_ex = Autotuner::makeExecutor(builtin);
+        std::unique_ptr<Executor> tuned_ex = Autotuner::makeExecutor(tuned);
+        EuropeanOption call(100.0, 1.0, OptionType::CALL);
+        double spot = 100.0;
+        auto next_spot = [&]() { spot = 90.0 + 20.0 * u(gen); };
+
+        MonteCarloPricer mc_builtin(MC_PATHS, 42, *builtin_ex), mc_tuned(MC_PATHS, 42, *tuned_ex);
+        mc_builtin.setBlockSize(builtin.mcBlockSize);
+        mc_tuned.setBlockSize(tuned.mcBlockSize);
+        double mc_default_ms = bench.run("tune.mc.antithetic.default", MC_PATHS, "paths", builtin_ex->concurrency(), [&]() {
+            doNotOptimize(mc_builtin.price(call, spot, 0.05, 0.2, true).first);
+        }, next_spot).median_ms;
+        BenchResult& mt = bench.run("tune.mc.antithetic.tuned", MC_PATHS, "paths", tuned_ex->concurrency(), [&]() {
+            doNotOptimize(mc_tuned.price(call, spot, 0.05, 0.2, true).first);
+        }, next_spot);
+        double mc_gain = mc_default_ms / mt.median_ms;
+        mt.extra["vs_default"] = mc_gain;
+
+        HestonPricer heston_builtin(HESTON_PATHS, HESTON_STEPS, *builtin_ex), heston_tuned(HESTON_PATHS, HESTON_STEPS, *tuned_ex);
+        heston_builtin.setTileWidth(builtin.hestonTileWidth);
+        heston_tuned.setTileWidth(tuned.hestonTileWidth);
+        const double path_steps = static_cast<double>(HESTON_PATHS) * HESTON_STEPS;
+        double heston_default_ms = bench.run("tune.heston.default", path_steps, "path-steps", builtin_ex->concurrency(), [&]() {
+            doNotOptimize(heston_builtin.price(call, spot, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7));
+        }, next_spot).median_ms;
+        BenchResult& ht = bench.run("tune.heston.tuned", path_steps, "path-steps", tuned_ex->concurrency(), [&]() {
+            doNotOptimize(heston_tuned.price(call, spot, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7));
+        }, next_spot);
+        double heston_gain = heston_default_ms / ht.median_ms;
+        ht.extra["vs_default"] = heston_gain;
+
+        std::cout << "\nTuned (" << tuned.describe() << ") vs default (" << builtin.describe() << "):\n"
+                  << "  MC " << std::fixed << std::setprecision(2) << mc_gain << "x, Heston " << heston_gain << "x throughput\n";
+    };
+
+    // --- AUTOTUNE MODE: search, save, compare, stop ---
+    // (the other sections would still run on the settings this process started with)
+    if (autotune) {
+        std::cout << "\nAutotune: executor, thread count, MC block size and Heston tile width\n"
+                  << std::string(85, '-') << "\n";
+        Autotuner tuner(MC_PATHS, HESTON_PATHS, HESTON_STEPS);
+        tuner.setRepetitions(quick ? 3 : 5);
+        TuningReport report = tuner.tune();
+        std::cout << std::left << std::setw(22) << "Parameter" << std::setw(28) << "Value" << std::right
+                  << std::setw(12) << "MC ms" << std::setw(12) << "Heston ms" << "\n";
+        for (const TuningTrial& t : report.trials) {
+            std::cout << std::left << std::setw(22) << t.parameter << std::setw(28) << t.value << std::right << std::fixed
+                      << std::setprecision(3) << std::setw(12) << t.mcMs << std::setw(12) << t.hestonMs << "\n";
+        }
+        std::cout << "Best: " << report.config.describe() << " (search " << std::setprecision(1) << report.seconds << " s)\n";
+        try {
+            report.config.save(tuningFilePath());
+            std::cout << "Saved to " << tuningFilePath() << "; pricers load it at startup\n";
+        } catch (const std::exception& e) {
+            std::cout << e.what() << "\n";
+            return 1;
+        }
+        compareTuning("Tuned vs default settings", report.config);
+        writeReport({});
+        printSeparator();
+        return 0;
+    }
 
-    // Parameters
-    double spot = 100.0;
-    double strike = 100.0;
-    double rate = 0.05;
-    double vol = 0.20;
-    double maturity = 1.0;
-    OptionType type = OptionType::CALL;
-
-    // --- TEST 1: BLACK-SCHOLES THROUGHPUT ---
-    std::cout << "1. Benchmarking Black-Scholes Analytical Formula...\n";
-    
-    // We run it 10 million times to get a measurable duration
-    const int BS_ITERATIONS = 10'000'000;
-    
-    // Create the object once to measure pure pricing method speed
-    BlackScholes bs(spot, strike, rate, vol, maturity, type);
-    
-    // Volatile variable to prevent compiler optimization (dead code elimination)
-    volatile double dummySum = 0.0;
-
-    auto bs_duration = measure_execution_time([&]() {
-        for(int i = 0; i < BS_ITERATIONS; ++i) {
-            dummySum = dummySum + bs.price();
+    // --- 1. ANALYTICS (randomized inputs, one option per iteration) ---
+    printSection("1. Analytical pricing");
+
+    bench.run("bs.price", N_BS, "options", 1, [&]() {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < N_BS; ++i) {
+            sum += BlackScholes(in.spot[i], in.strike[i], in.rate[i], in.vol[i], in.maturity[i], in.type[i]).price();
         }
+        doNotOptimize(sum);
     });
 
-    std::cout << "   Iterations: " << BS_ITERATIONS << "\n";
-    std::cout << "   Total Time: " << bs_duration << " ms\n";
-    double bs_ops = (double)BS_ITERATIONS / (bs_duration / 1000.0);
-    std::cout << "   Throughput: " << std::fixed << std::setprecision(0) << bs_ops << " options/sec\n\n";
+    bench.run("bs.price+greeks", N_BS, "options", 1, [&]() {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < N_BS; ++i) {
+            BlackScholes bs(in.spot[i], in.strike[i], in.rate[i], in.vol[i], in.maturity[i], in.type[i]);
+            sum += bs.price() + bs.delta() + bs.gamma() + bs.vega();
+        }
+        doNotOptimize(sum);
+    });
 
+    std::vector<double> out_price(N_BS), out_delta(N_BS), out_gamma(N_BS), out_vega(N_BS);
+    bench.run("bs.batch.price+greeks", N_BS, "options", max_threads, [&]() {
+        BatchPricer::priceBlackScholes(in.batch(), {out_price.data(), out_delta.data(), out_gamma.data(), out_vega.data()});
+        doNotOptimize(out_price[N_BS / 2]);
+    });
 
-    // --- TEST 2: MONTE CARLO SIMULATION SPEED ---
-    std::cout << "2. Benchmarking Monte Carlo Simulation...\n";
-    
-    // We run 1 million paths (simulations) in a single pricing call
-    const int MC_PATHS = 1'000'000;
-    EuropeanOption option(strike, maturity, type);
-    MonteCarloPricer pricer(MC_PATHS);
+    // Same kernel on a chain sharing one expiry of a yield curve with dividends: the context is
+    // resolved once, so curves cost nothing per option
+    MarketCurves curves(YieldCurve({0.25, 1.0, 2.0, 5.0}, {0.030, 0.035, 0.040, 0.042}),
+                        DividendCurve(YieldCurve::flat(0.01), {{0.3, 1.5}, {0.8, 1.5}}));
+    bench.run("bs.expiry.price+greeks", N_BS, "options", max_threads, [&]() {
+        ExpiryContext ctx = curves.expiry(100.0, 1.0);
+        BatchPricer::priceExpiry(ctx, in.strike.data(), in.vol.data(), in.type.data(), N_BS,
+                                 {out_price.data(), out_delta.data(), out_gamma.data(), out_vega.data()});
+        doNotOptimize(out_price[N_BS / 2]);
+    });
 
-    auto mc_duration = measure_execution_time([&]() {
-        pricer.price(option, spot, rate, vol);
+    // Merton series on a short-dated equity jump profile (about 10 terms per option)
+    JumpParams jumps;
+    jumps.intensity = 1.0;
+    jumps.mean = -0.1;
+    jumps.stddev = 0.15;
+    BenchResult& merton = bench.run("merton.batch.price", N_IV, "options", max_threads, [&]() {
+        OptionBatch batch = in.batch();
+        batch.size = N_IV;
+        BatchPricer::priceMerton(batch, jumps, {out_price.data(), nullptr, nullptr, nullptr});
+        doNotOptimize(out_price[N_IV / 2]);
     });
+    MertonJumpDiffusion merton_atm(100.0, 100.0, 0.05, 0.2, 1.0, OptionType::CALL, jumps);
+    merton_atm.price();
+    merton.extra["series_terms_atm"] = merton_atm.termsUsed();
 
-    std::cout << "   Simulations: " << MC_PATHS << "\n";
-    std::cout << "   Total Time:  " << mc_duration << " ms\n";
-    
-    // Calculate paths per second
-    double mc_pps = (double)MC_PATHS / (mc_duration / 1000.0);
-    std::cout << "   Throughput:  " << std::fixed << std::setprecision(0) << mc_pps << " paths/sec\n";
-    
-    printSeparator();
-    std::cout << "Performance Analysis:\n";
-    if (bs_ops > 1'000'000) {
-        std::cout << "Black-Scholes is extremely fast (>1M ops/sec).\n";
+    BenchResult& iv = bench.run("iv.newton", N_IV, "solves", 1, [&]() {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < N_IV; ++i) {
+            sum += ImpliedVolatility::calculate(in.price[i], in.spot[i], in.strike[i], in.rate[i], in.maturity[i], in.type[i]);
+        }
+        doNotOptimize(sum);
+    });
+    {
+        std::size_t failures = 0;
+        for (std::size_t i = 0; i < N_IV; ++i) {
+            double v = ImpliedVolatility::calculate(in.price[i], in.spot[i], in.strike[i], in.rate[i], in.maturity[i], in.type[i]);
+            if (v < 0.0) ++failures;
+        }
+        iv.extra["failure_rate"] = static_cast<double>(failures) / N_IV;
+    }
+
+    // Result store: single-writer publish rate and the cost of a full risk snapshot
+    const std::size_t STORE_TRADES = 10000, STORE_UNDERLYINGS = 32;
+    const std::size_t STORE_UPDATES = quick ? 1000000 : 5000000, STORE_SNAPSHOTS = quick ? 20000 : 100000;
+    std::vector<std::string> store_names;
+    for (std::size_t u = 0; u < STORE_UNDERLYINGS; ++u) store_names.push_back("U" + std::to_string(u));
+    std::vector<std::size_t> store_underlying(STORE_TRADES);
+    for (std::size_t i = 0; i < STORE_TRADES; ++i) store_underlying[i] = (i * 7) % STORE_UNDERLYINGS;
+    ResultStore store(store_names, store_underlying, std::vector<double>(STORE_TRADES, 1.0));
+    bench.run("store.publish", STORE_UPDATES, "updates", 1, [&]() {
+        for (std::size_t i = 0; i < STORE_UPDATES; ++i) {
+            double p = in.price[i % N_BS];
+            store.publish((i * 2654435761u) % STORE_TRADES, {p, 0.5, 0.01, 0.2 * p});
+        }
+    });
+    bench.run("store.snapshot." + std::to_string(STORE_UNDERLYINGS) + "underlyings", STORE_SNAPSHOTS, "snapshots", 1, [&]() {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < STORE_SNAPSHOTS; ++i) sum += store.snapshot().total.delta;
+        doNotOptimize(sum);
+    });
+
+    // --- 2. MONTE CARLO (all threads, spot re-randomized before every repetition) ---
+    printSection("2. Monte Carlo (all threads)");
+
+    double mc_spot = 100.0;
+    auto new_spot = [&]() { mc_spot = 90.0 + 20.0 * u(gen); };
+    EuropeanOption atm(100.0, 1.0, OptionType::CALL);
+
+    MonteCarloPricer mc(MC_PATHS);
+    bench.run("mc.price.standard", MC_PATHS, "paths", max_threads, [&]() {
+        doNotOptimize(mc.price(atm, mc_spot, 0.05, 0.2, false).first);
+    }, new_spot);
+
+    bench.run("mc.price.antithetic", MC_PATHS, "paths", max_threads, [&]() {
+        doNotOptimize(mc.price(atm, mc_spot, 0.05, 0.2, true).first);
+    }, new_spot);
+
+    MonteCarloPricer mc_det(MC_PATHS);
+    mc_det.setDeterministic(true);
+    bench.run("mc.price.antithetic.deterministic", MC_PATHS, "paths", max_threads, [&]() {
+        doNotOptimize(mc_det.price(atm, mc_spot, 0.05, 0.2, true).first);
+    }, new_spot);
+
+    bench.run("mc.accumulate", MC_PATHS, "paths", max_threads, [&]() {
+        doNotOptimize(mc_det.accumulate(atm, mc_spot, 0.05, 0.2).price().first);
+    }, new_spot);
+
+    bench.run("mc.sharded.2proc", MC_PATHS, "paths", max_threads, [&]() {
+        doNotOptimize(sharded.accumulate(mc_det, atm, mc_spot, 0.05, 0.2).price().first);
+    }, new_spot);
+
+    MonteCarloGreeks greeks(GREEK_PATHS);
+    bench.run("mc.greeks.delta+gamma", GREEK_PATHS, "paths", max_threads, [&]() {
+        doNotOptimize(greeks.delta(atm, mc_spot, 0.05, 0.2) + greeks.gamma(atm, mc_spot, 0.05, 0.2));
+    }, new_spot);
+
+    // 100-point spot curve from one simulation (spot ladder)
+    MonteCarloPricer ladder_mc(GREEK_PATHS);
+    std::vector<double> ladder_spots(100);
+    BenchResult& ladder_row = bench.run("mc.ladder.100spots", 100.0 * GREEK_PATHS, "path-spots", max_threads, [&]() {
+        doNotOptimize(ladder_mc.priceLadder(atm, ladder_spots, 0.05, 0.2).prices[50]);
+    }, [&]() {
+        new_spot();
+        for (int i = 0; i < 100; ++i) ladder_spots[i] = mc_spot * (0.5 + 0.01 * i);
+    });
+    ladder_row.extra["ms_per_spot"] = ladder_row.median_ms / 100.0;
+
+    HestonPricer heston(HESTON_PATHS, HESTON_STEPS);
+    double heston_ms = bench.run("heston.price", static_cast<double>(HESTON_PATHS) * HESTON_STEPS, "path-steps", max_threads, [&]() {
+        doNotOptimize(heston.price(atm, mc_spot, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7));
+    }, new_spot).median_ms;
+
+    // Whole chain (calls and puts) from one simulation, against one heston.price per call
+    const std::vector<double> chain_expiries = {0.25, 0.5, 1.0, 2.0};
+    std::vector<double> chain_strikes;
+    for (int k = 0; k < 10; ++k) chain_strikes.push_back(80.0 + 4.0 * k);
+    const double chain_contracts = static_cast<double>(chain_expiries.size() * chain_strikes.size());
+    HestonPricer heston_chain(HESTON_PATHS, HESTON_STEPS);
+    BenchResult& chain_row = bench.run("heston.chain.4x10", 2.0 * chain_contracts, "quotes", max_threads, [&]() {
+        doNotOptimize(heston_chain.priceChain(mc_spot, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7,
+                                              chain_expiries, chain_strikes).calls[0]);
+    }, new_spot);
+    chain_row.extra["per_call_equivalent_ms"] = heston_ms * chain_contracts;
+    chain_row.extra["speedup_vs_per_call"] = heston_ms * chain_contracts / chain_row.median_ms;
+
+    // Heston surrogate over (spot, vol): built once, then evaluated like a closed form
+    const int SURROGATE_EVALS = 1'000'000;
+    auto surrogate_start = std::chrono::high_resolution_clock::now();
+    ChebyshevSurrogate heston_surrogate = buildHestonSurrogate(HestonPoint(), OptionType::CALL,
+        {{HestonInput::SPOT, {50.0, 150.0, 16}}, {HestonInput::VOL, {0.05, 0.6, 10}}}, 2000, 25);
+    double surrogate_build_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - surrogate_start).count();
+    // The tail estimate is only a heuristic: report the measured error next to it
+    double surrogate_max_error = heston_surrogate.validate([](const double* x, int) {
+        HestonPoint p;
+        p.spot = x[0];
+        p.vol = x[1];
+        return hestonPointPrice(p, OptionType::CALL, 2000, 25);
+    }, 100);
+    BenchResult& surrogate_row = bench.run("heston.surrogate.eval", SURROGATE_EVALS, "evals", 1, [&]() {
+        double sum = 0.0;
+        for (int i = 0; i < SURROGATE_EVALS; ++i) {
+            double x[2] = {mc_spot - 25.0 + 50.0 * (i & 1023) / 1024.0, 0.05 + 0.5 * (i >> 10) / 1024.0};
+            sum += heston_surrogate.evaluate(x);
+        }
+        doNotOptimize(sum);
+    }, new_spot);
+    surrogate_row.extra["ns_per_eval"] = surrogate_row.median_ms * 1e6 / SURROGATE_EVALS;
+    surrogate_row.extra["build_ms"] = surrogate_build_ms;
+    surrogate_row.extra["tail_estimate"] = heston_surrogate.errorEstimate();
+    surrogate_row.extra["validated_max_error"] = surrogate_max_error;
+
+    // SABR smile: vols of a dense strike array, then a warm intraday recalibration of a surface
+    const int SABR_STRIKES = 100'000;
+    SABRParams sabr;
+    sabr.beta = 0.7;
+    sabr.alpha = 0.2 * std::pow(100.0, 0.3);
+    sabr.rho = -0.3;
+    sabr.nu = 0.5;
+    std::vector<double> sabr_strikes(SABR_STRIKES), sabr_vols(SABR_STRIKES);
+    for (int i = 0; i < SABR_STRIKES; ++i) sabr_strikes[i] = 50.0 + 100.0 * i / SABR_STRIKES;
+    bench.run("sabr.vols", SABR_STRIKES, "vols", 1, [&]() {
+        SABR::impliedVols(mc_spot, sabr_strikes.data(), sabr_strikes.size(), 1.0, sabr, sabr_vols.data());
+        doNotOptimize(sabr_vols[SABR_STRIKES / 2]);
+    }, new_spot);
+
+    std::vector<SABRSlice> sabr_surface(12);
+    for (int e = 0; e < 12; ++e) {
+        SABRSlice& slice = sabr_surface[e];
+        slice.maturity = 0.1 + 0.25 * e;
+        slice.forward = 100.0 * std::exp(0.02 * slice.maturity);
+        for (int k = 0; k < 21; ++k) {
+            slice.strikes.push_back(slice.forward * std::exp(0.6 * std::sqrt(slice.maturity) * (k - 10) / 10.0));
+            slice.vols.push_back(SABR::impliedVol(slice.forward, slice.strikes.back(), slice.maturity, sabr));
+        }
+    }
+    SABRCalibrator sabr_calibrator(sabr.beta);
+    sabr_calibrator.calibrate(sabr_surface);
+    int sabr_tick = 0;
+    BenchResult& sabr_row = bench.run("sabr.calibrate.12x21.warm", 12, "expiries", max_threads, [&]() {
+        doNotOptimize(sabr_calibrator.calibrate(sabr_surface)[0].rmse);
+    }, [&]() {
+        // Small smile move per repetition, as between two intraday snapshots
+        double bump = 0.001 * ((++sabr_tick & 1) ? 1.0 : -1.0);
+        for (SABRSlice& slice : sabr_surface) {
+            for (std::size_t k = 0; k < slice.vols.size(); ++k) slice.vols[k] += bump * (1.0 + 0.1 * std::sin(static_cast<double>(k)));
+        }
+    });
+    SABRCalibrator sabr_cold(sabr.beta);
+    auto sabr_cold_start = std::chrono::high_resolution_clock::now();
+    doNotOptimize(sabr_cold.calibrate(sabr_surface)[0].rmse);
+    sabr_row.extra["cold_ms"] = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - sabr_cold_start).count();
+
+    // Exposure profile of a mixed book: 40 Black-Scholes trades on two underlyings plus two
+    // Heston trades (regression proxies), monthly grid over two years
+    const int EXPOSURE_PATHS = quick ? 4000 : 20000;
+    OptionBook exposure_book(0.03);
+    exposure_book.addUnderlying("A", 100.0, 0.2);
+    exposure_book.addUnderlying("B", 50.0, 0.3);
+    for (int k = 0; k < 20; ++k) {
+        exposure_book.addTrade({"A", 80.0 + 2.0 * k, 0.5 + 0.075 * k, k % 2 ? OptionType::PUT : OptionType::CALL,
+                                PricingModel::BLACK_SCHOLES, k % 3 ? 1.0 : -1.0});
+        exposure_book.addTrade({"B", 40.0 + k, 2.0 - 0.05 * k, OptionType::CALL, PricingModel::BLACK_SCHOLES, -0.5});
+    }
+    exposure_book.addTrade({"A", 100.0, 1.0, OptionType::CALL, PricingModel::HESTON});
+    exposure_book.addTrade({"A", 95.0, 2.0, OptionType::PUT, PricingModel::HESTON, -2.0});
+    std::vector<double> exposure_dates;
+    for (int m = 1; m <= 24; ++m) exposure_dates.push_back(m / 12.0);
+    ExposureEngine exposure(EXPOSURE_PATHS);
+    exposure.setRegressionPaths(EXPOSURE_PATHS);
+    exposure.setCorrelation(0.5);
+    BenchResult& exposure_row = bench.run("exposure.profile.42trades.24dates", static_cast<double>(EXPOSURE_PATHS) * exposure_dates.size(),
+                                          "path-dates", max_threads, [&]() {
+        doNotOptimize(exposure.profile(exposure_book, exposure_dates).pfe.back());
+    });
+    exposure_row.extra["us_per_path"] = exposure_row.median_ms * 1e3 / EXPOSURE_PATHS;
+
+    // Delta-hedging backtest: short ATM call, weekly rebalancing with 10bp costs
+    const int HEDGE_PATHS = quick ? 20000 : 100000, HEDGE_REBALANCES = 52;
+    HedgeSimulator hedge(HEDGE_PATHS, HEDGE_REBALANCES);
+    hedge.setTransactionCost(0.001);
+    for (const char* dynamics : {"gbm", "heston"}) {
+        const bool gbm = dynamics[0] == 'g';
+        bench.run(std::string("hedge.") + dynamics + "." + std::to_string(HEDGE_REBALANCES) + "rebalances",
+                  static_cast<double>(HEDGE_PATHS) * HEDGE_REBALANCES, "path-rebalances", max_threads, [&]() {
+            HestonParams h;
+            h.xi = 0.3;
+            doNotOptimize(gbm ? hedge.simulate(atm, mc_spot, 0.05, 0.2).stdDev : hedge.simulate(atm, mc_spot, 0.05, h).stdDev);
+        }, new_spot);
+    }
+
+    HestonPricer bates(HESTON_PATHS, HESTON_STEPS);
+    bates.setJumps(jumps);
+    bench.run("bates.price", static_cast<double>(HESTON_PATHS) * HESTON_STEPS, "path-steps", max_threads, [&]() {
+        doNotOptimize(bates.price(atm, mc_spot, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7));
+    }, new_spot);
+
+    // Heston-Hull-White hybrid: one more normal and the rate/discount update per step
+    HestonPricer hybrid(HESTON_PATHS, HESTON_STEPS);
+    HullWhiteParams hull_white;
+    hull_white.volatility = 0.01;
+    hull_white.rhoSpot = 0.3;
+    hybrid.setHullWhite(hull_white);
+    BenchResult& hybrid_row = bench.run("heston.hullwhite.price", static_cast<double>(HESTON_PATHS) * HESTON_STEPS, "path-steps", max_threads, [&]() {
+        doNotOptimize(hybrid.price(atm, mc_spot, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7));
+    }, new_spot);
+    hybrid_row.extra["cost_vs_heston"] = hybrid_row.median_ms / heston_ms;
+
+    MultiAssetPricer multi(BASKET_PATHS);
+    multi.setUniformCorrelation(BASKET_ASSETS, 0.4);
+    BasketOption basket(100.0, 1.0, OptionType::CALL, std::vector<double>(BASKET_ASSETS, 1.0 / BASKET_ASSETS));
+    std::vector<double> basket_spots(BASKET_ASSETS), basket_vols(BASKET_ASSETS);
+    for (int i = 0; i < BASKET_ASSETS; ++i) basket_vols[i] = 0.15 + 0.2 * i / BASKET_ASSETS;
+    bench.run("mc.multiasset.basket" + std::to_string(BASKET_ASSETS), static_cast<double>(BASKET_PATHS) * BASKET_ASSETS,
+              "path-assets", max_threads, [&]() {
+        doNotOptimize(multi.price(basket, basket_spots, basket_vols, 0.05).first);
+    }, [&]() {
+        new_spot();
+        for (int i = 0; i < BASKET_ASSETS; ++i) basket_spots[i] = mc_spot * (0.9 + 0.2 * i / BASKET_ASSETS);
+    });
+
+    std::cout << "\nHeston surrogate error: tail estimate " << std::scientific << std::setprecision(2)
+              << heston_surrogate.errorEstimate() << ", measured max " << surrogate_max_error
+              << " (100 random points vs the sampled pricer)\n" << std::fixed;
+
+    // --- 3. EXECUTORS (same kernel, all workers) ---
+    printSection("3. Executors (mc.price.antithetic)");
+    {
+        SerialExecutor serial;
+        OpenMPExecutor openmp(max_threads);
+        ThreadPoolExecutor pool(max_threads);
+        ThreadPoolExecutor pinned(max_threads, true);
+        ParallelAlgorithmsExecutor parallel(max_threads);
+        std::vector<std::pair<std::string, Executor*>> executors = {
+            {"serial", &serial}, {"openmp", &openmp}, {"thread-pool", &pool},
+            {"thread-pool.pinned", &pinned}, {"std::execution", &parallel}};
+        for (const auto& e : executors) {
+            mc.setExecutor(*e.second);
+            bench.run("executor." + e.first, MC_PATHS, "paths", e.second->concurrency(), [&]() {
+                doNotOptimize(mc.price(atm, mc_spot, 0.05, 0.2, true).first);
+            }, new_spot);
+        }
+        mc.setExecutor(defaultExecutor());
+    }
+
+    // --- 4. THREAD SCALING (one executor per thread count) ---
+    printSection("4. Thread scaling");
+
+    double mc_base = 0.0, det_base = 0.0, heston_base = 0.0;
+    for (int t : thread_counts) {
+        OpenMPExecutor executor(t);
+        mc.setExecutor(executor);
+        mc_det.setExecutor(executor);
+        heston.setExecutor(executor);
+
+        BenchResult& m = bench.run("scaling.mc.antithetic", MC_PATHS, "paths", t, [&]() {
+            doNotOptimize(mc.price(atm, mc_spot, 0.05, 0.2, true).first);
+        }, new_spot);
+        if (mc_base == 0.0) mc_base = m.median_ms;
+        m.extra["speedup"] = mc_base / m.median_ms;
+        m.extra["efficiency"] = mc_base / m.median_ms / t;
+
+        BenchResult& d = bench.run("scaling.mc.deterministic", MC_PATHS, "paths", t, [&]() {
+            doNotOptimize(mc_det.price(atm, mc_spot, 0.05, 0.2, true).first);
+        }, new_spot);
+        if (det_base == 0.0) det_base = d.median_ms;
+        d.extra["speedup"] = det_base / d.median_ms;
+        d.extra["efficiency"] = det_base / d.median_ms / t;
+
+        BenchResult& h = bench.run("scaling.heston", static_cast<double>(HESTON_PATHS) * HESTON_STEPS, "path-steps", t, [&]() {
+            doNotOptimize(heston.price(atm, mc_spot, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7));
+        }, new_spot);
+        if (heston_base == 0.0) heston_base = h.median_ms;
+        h.extra["speedup"] = heston_base / h.median_ms;
+        h.extra["efficiency"] = heston_base / h.median_ms / t;
     }
-    std::cout << "ℹMonte Carlo is computationally intensive (Generating random numbers).\n";
-    
+    mc.setExecutor(defaultExecutor());
+    mc_det.setExecutor(defaultExecutor());
+    heston.setExecutor(defaultExecutor());
+
+    std::cout << "\nScaling summary (speedup vs " << thread_counts.front() << " thread(s)):\n";
+    for (const BenchResult& r : bench.results()) {
+        if (r.extra.count("speedup")) {
+            std::cout << "  " << std::left << std::setw(24) << r.name << std::right << std::setw(4) << r.threads
+                      << " threads: " << std::fixed << std::setprecision(2) << r.extra.at("speedup") << "x ("
+                      << std::setprecision(0) << 100.0 * r.extra.at("efficiency") << "% efficiency)\n";
+        }
+    }
+
+    // --- 5. PRECISION (float path evolution vs double, same seeds and normals) ---
+    printSection("5. Precision (float32 paths, double accumulation)");
+    {
+        // Same normals in both modes, so the price difference is the precision-induced bias
+        MonteCarloPricer mc_float(MC_PATHS);
+        mc_float.setPrecision(Precision::FLOAT);
+        auto mc_double_res = mc.price(atm, 100.0, 0.05, 0.2, true);
+        auto mc_float_res = mc_float.price(atm, 100.0, 0.05, 0.2, true);
+
+        // (results are stored in a vector: read each BenchResult before the next run)
+        double mc_double_ms = bench.run("precision.mc.antithetic.double", MC_PATHS, "paths", max_threads, [&]() {
+            doNotOptimize(mc.price(atm, mc_spot, 0.05, 0.2, true).first);
+        }, new_spot).median_ms;
+        BenchResult& f = bench.run("precision.mc.antithetic.float", MC_PATHS, "paths", max_threads, [&]() {
+            doNotOptimize(mc_float.price(atm, mc_spot, 0.05, 0.2, true).first);
+        }, new_spot);
+        double mc_speedup = mc_double_ms / f.median_ms;
+        double mc_bias = mc_float_res.first - mc_double_res.first;
+        f.extra["speedup"] = mc_speedup;
+        f.extra["bias"] = mc_bias;
+        f.extra["bias_std_err"] = mc_bias / mc_double_res.second;
+
+        HestonPricer heston_float(HESTON_PATHS, HESTON_STEPS);
+        heston_float.setPrecision(Precision::FLOAT);
+        double heston_double_price = heston.price(atm, 100.0, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7);
+        double heston_float_price = heston_float.price(atm, 100.0, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7);
+
+        double heston_double_ms = bench.run("precision.heston.double", static_cast<double>(HESTON_PATHS) * HESTON_STEPS, "path-steps", max_threads, [&]() {
+            doNotOptimize(heston.price(atm, mc_spot, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7));
+        }, new_spot).median_ms;
+        BenchResult& hf = bench.run("precision.heston.float", static_cast<double>(HESTON_PATHS) * HESTON_STEPS, "path-steps", max_threads, [&]() {
+            doNotOptimize(heston_float.price(atm, mc_spot, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7));
+        }, new_spot);
+        double heston_speedup = heston_double_ms / hf.median_ms;
+        double heston_bias = heston_float_price - heston_double_price;
+        hf.extra["speedup"] = heston_speedup;
+        hf.extra["bias"] = heston_bias;
+        hf.extra["relative_bias"] = heston_bias / heston_double_price;
+
+        std::cout << "\nPrecision-induced bias (float - double, ATM call, spot 100):\n"
+                  << "  mc.antithetic  " << std::scientific << std::setprecision(3) << std::setw(11) << mc_bias
+                  << "  (" << mc_bias / mc_double_res.second << " std err), "
+                  << std::fixed << std::setprecision(2) << mc_speedup << "x faster\n"
+                  << "  heston         " << std::scientific << std::setprecision(3) << std::setw(11) << heston_bias
+                  << "  (" << heston_bias / heston_double_price << " relative), "
+                  << std::fixed << std::setprecision(2) << heston_speedup << "x faster\n";
+    }
+
+    // --- 6. MATH POLICIES (libm vs vectorized exp/log/sqrt, same draws) ---
+    printSection("6. Math policies (libm / precise / fast exp, log, sqrt)");
+    {
+        const int VALUES = 1 << 16;
+        std::vector<double> exp_in(VALUES), log_in(VALUES), math_out(VALUES);
+        for (int i = 0; i < VALUES; ++i) {
+            exp_in[i] = -20.0 + 40.0 * u(gen);
+            log_in[i] = std::exp(exp_in[i]);
+        }
+        for (MathPolicy policy : {MathPolicy::LIBM, MathPolicy::PRECISE, MathPolicy::FAST}) {
+            withMathPolicy(policy, [&](auto math) {
+                using Math = decltype(math);
+                std::string tier = mathPolicyName(policy);
+                bench.run("math.exp." + tier, VALUES, "values", 1, [&]() {
+                    SIMD_LOOP
+                    for (int i = 0; i < VALUES; ++i) math_out[i] = Math::exp(exp_in[i]);
+                    doNotOptimize(math_out[VALUES / 2]);
+                });
+                bench.run("math.log." + tier, VALUES, "values", 1, [&]() {
+                    SIMD_LOOP
+                    for (int i = 0; i < VALUES; ++i) math_out[i] = Math::log(log_in[i]);
+                    doNotOptimize(math_out[VALUES / 2]);
+                });
+                bench.run("math.sqrt." + tier, VALUES, "values", 1, [&]() {
+                    SIMD_LOOP
+                    for (int i = 0; i < VALUES; ++i) math_out[i] = Math::sqrt(log_in[i]);
+                    doNotOptimize(math_out[VALUES / 2]);
+                });
+            });
+        }
+
+        // Kernels: same normals under every policy, so the price moves only by the function error
+        HestonPricer heston_math(HESTON_PATHS, HESTON_STEPS);
+        MonteCarloPricer mc_math(MC_PATHS);
+        double heston_libm_ms = 0.0, heston_libm_price = 0.0, mc_libm_ms = 0.0, mc_libm_price = 0.0;
+        std::cout << "\nMath policy vs libm (ATM call, spot 100):\n";
+        for (MathPolicy policy : {MathPolicy::LIBM, MathPolicy::PRECISE, MathPolicy::FAST}) {
+            std::string tier = mathPolicyName(policy);
+            heston_math.setMathPolicy(policy);
+            mc_math.setMathPolicy(policy);
+            double heston_price = heston_math.price(atm, 100.0, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7);
+            double mc_price = mc_math.price(atm, 100.0, 0.05, 0.2, true).first;
+
+            // (results are stored in a vector: finish each BenchResult before the next run)
+            BenchResult& hm = bench.run("math.heston." + tier, static_cast<double>(HESTON_PATHS) * HESTON_STEPS, "path-steps", max_threads, [&]() {
+                doNotOptimize(heston_math.price(atm, mc_spot, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7));
+            }, new_spot);
+            if (policy == MathPolicy::LIBM) {
+                heston_libm_ms = hm.median_ms;
+                heston_libm_price = heston_price;
+            }
+            double heston_speedup = heston_libm_ms / hm.median_ms;
+            double heston_diff = (heston_price - heston_libm_price) / heston_libm_price;
+            hm.extra["speedup_vs_libm"] = heston_speedup;
+            hm.extra["relative_diff"] = heston_diff;
+
+            BenchResult& mm = bench.run("math.mc.antithetic." + tier, MC_PATHS, "paths", max_threads, [&]() {
+                doNotOptimize(mc_math.price(atm, mc_spot, 0.05, 0.2, true).first);
+            }, new_spot);
+            if (policy == MathPolicy::LIBM) {
+                mc_libm_ms = mm.median_ms;
+                mc_libm_price = mc_price;
+            }
+            double mc_speedup = mc_libm_ms / mm.median_ms;
+            double mc_diff = (mc_price - mc_libm_price) / mc_libm_price;
+            mm.extra["speedup_vs_libm"] = mc_speedup;
+            mm.extra["relative_diff"] = mc_diff;
+
+            std::cout << "  " << std::left << std::setw(8) << tier << std::right << "heston " << std::scientific
+                      << std::setprecision(2) << std::setw(10) << heston_diff << " rel, " << std::fixed << heston_speedup
+                      << "x   mc " << std::scientific << std::setw(10) << mc_diff << " rel, " << std::fixed
+                      << mc_speedup << "x\n";
+        }
+    }
+
+    // --- 7. TUNED VS DEFAULT SETTINGS (machines with a tuning file) ---
+    if (machineTuning() != TuningConfig()) {
+        compareTuning("7. Tuned vs default settings", machineTuning());
+    } else {
+        std::cout << "\n7. Tuned vs default settings: no tuning for this machine (run with --autotune)\n";
+    }
+
+    // --- 8. KERNEL COUNTERS (instrumented builds only) ---
+    Instrumentation::Snapshot counters;
+    if (Instrumentation::enabled()) {
+        counters = Instrumentation::snapshot();
+        counters.hardware = hw.stop();
+        std::cout << "\n8. Kernel counters (whole run)\n" << std::string(85, '-') << "\n";
+        counters.print(std::cout);
+    }
+
+    // --- 9. REPORT ---
+    std::map<std::string, std::string> sections;
+    if (Instrumentation::enabled()) sections["counters"] = counters.toJson();
+    writeReport(sections);
+
+    printSeparator();
     return 0;
-}
\ No newline at end of file
+}
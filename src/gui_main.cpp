@@ -6,12 +6,157 @@
 #include <vector>
 #include <cmath>
 #include <iostream>
-#include <omp.h>
 
 // Finance Headers
 #include "BlackScholes.h"
+#include "ChebyshevSurrogate.h"
 #include "EuropeanOption.h"
+#include "Executor.h"
 #include "HestonMC.h"
+#include "Instrumentation.h"
+#include "JobSystem.h"
+#include "MonteCarlo.h"
+
+// Snapshot of the inputs a cached result was computed from
+struct ModelInputs {
+    float spot, strike, rate, volatility, maturity;
+    float kappa, theta, xi, rho;
+    int optionType;
+    int heatmapModel;   // 0 = Black-Scholes, 1 = Heston (Chebyshev surrogate)
+
+    bool operator==(const ModelInputs& o) const {
+        return spot == o.spot && strike == o.strike && rate == o.rate && volatility == o.volatility &&
+               maturity == o.maturity && kappa == o.kappa && theta == o.theta && xi == o.xi &&
+               rho == o.rho && optionType == o.optionType && heatmapModel == o.heatmapModel;
+    }
+    bool operator!=(const ModelInputs& o) const { return !(*this == o); }
+};
+
+// Spot-dependent result: the Heston price at the current spot
+struct LiveResult {
+    double priceHeston = 0.0;
+};
+
+// Spot-independent results: model curves over the spot axis and the BS heatmap
+struct SurfaceResult {
+    std::vector<float> x, bs, heston, mc;
+    int hm_res = 0;
+    std::vector<float> heatmap;
+};
+
+// Refinement levels of the background jobs: a coarse pass first, then the full one
+struct Refinement {
+    int heston_paths, heston_steps;   // Live Heston price
+    int points;                       // Curve points
+    int chain_paths, chain_steps;     // Heston curve (one chain simulation)
+    int ladder_paths;                 // GBM Monte Carlo curve (one spot ladder)
+    int hm_res;                       // Heatmap cells per side
+    int surrogate_paths;              // Heston heatmap: paths per surrogate node
+    int surrogate_spot_nodes, surrogate_vol_nodes;
+};
+static const Refinement LEVELS[] = {
+    {1000, 25, 25, 2000, 15, 2000, 20, 1000, 8, 6},
+    {5000, 50, 100, 20000, 30, 20000, 80, 4000, 16, 10},
+};
+static const int NUM_LEVELS = 2;
+
+static const float hm_spot_min = 50.0f, hm_spot_max = 150.0f;
+static const float hm_vol_min = 0.05f, hm_vol_max = 1.0f;
+
+static OptionType optionTypeOf(const ModelInputs& in) {
+    return (in.optionType == 0) ? OptionType::CALL : OptionType::PUT;
+}
+
+// Heston price at the current spot (v0 = volatility^2 to match the BS input)
+static void computeLive(const ModelInputs& in, const Refinement& level, Executor& pool, LiveResult& out) {
+    EuropeanOption opt(in.strike, in.maturity, optionTypeOf(in));
+    HestonPricer heston(level.heston_paths, level.heston_steps, pool);
+    out.priceHeston = heston.price(opt, in.spot, in.rate, in.volatility * in.volatility,
+                                   in.kappa, in.theta, in.xi, in.rho);
+}
+
+// Curves and heatmap; the spot only moves the tag, so 'in.spot' is not used
+static void computeSurface(const ModelInputs& in, const Refinement& level, Executor& pool,
+                           SurfaceResult& out, const JobToken& token) {
+    OptionType type = optionTypeOf(in);
+    EuropeanOption opt(in.strike, in.maturity, type);
+    double v0 = in.volatility * in.volatility;
+    const int n = level.points;
+    out.x.resize(n);
+    out.bs.resize(n);
+    out.heston.resize(n);
+    out.mc.resize(n);
+
+    // Heston: one simulation from S0 = 100 prices the whole curve. The model is
+    // homogeneous of degree one in (S, K), so C(s, K) = (s / S0) C(S0, K S0 / s).
+    const double S0 = 100.0;
+    std::vector<double> chain_strikes(n), ladder_spots(n);
+    for (int i = 0; i < n; ++i) {
+        out.x[i] = 50.0f + i * (100.0f / n);
+        chain_strikes[i] = in.strike * S0 / out.x[i];
+        ladder_spots[i] = out.x[i];
+    }
+    HestonPricer curveHeston(level.chain_paths, level.chain_steps, pool);
+    HestonChain chain = curveHeston.priceChain(S0, in.rate, v0, in.kappa, in.theta, in.xi, in.rho,
+                                               {static_cast<double>(in.maturity)}, chain_strikes);
+    if (token.cancelled()) return;
+
+    // GBM Monte Carlo: the same draws for every spot (smooth curve, one simulation)
+    MonteCarloPricer curveMC(level.ladder_paths, 42, pool);
+    SpotLadder ladder = curveMC.priceLadder(opt, ladder_spots, in.rate, in.volatility);
+    if (token.cancelled()) return;
+
+    pool.parallelFor(n, [&](std::size_t begin, std::size_t end, int) {
+        for (int i = static_cast<int>(begin); i < static_cast<int>(end); ++i) {
+            float s = out.x[i];
+            out.mc[i] = (float)ladder.price(i);
+
+            // BS
+            BlackScholes tBS(s, in.strike, in.rate, in.volatility, in.maturity, type);
+            out.bs[i] = (float)tBS.price();
+
+            // Heston, rescaled from the chain
+            double quote = (type == OptionType::CALL) ? chain.call(0, i) : chain.put(0, i);
+            out.heston[i] = (float)(s / S0 * quote);
+        }
+    });
+
+    // Heatmap (spot x volatility). Heston goes through a Chebyshev surrogate: a few hundred
+    // MC prices on the nodes, then every cell is a polynomial evaluation.
+    ChebyshevSurrogate surrogate;
+    if (in.heatmapModel == 1) {
+        HestonPoint base;
+        base.strike = in.strike;
+        base.rate = in.rate;
+        base.kappa = in.kappa;
+        base.theta = in.theta;
+        base.xi = in.xi;
+        base.rho = in.rho;
+        base.maturity = in.maturity;
+        surrogate = buildHestonSurrogate(base, type,
+            {{HestonInput::SPOT, {hm_spot_min, hm_spot_max, level.surrogate_spot_nodes}},
+             {HestonInput::VOL, {hm_vol_min, hm_vol_max, level.surrogate_vol_nodes}}},
+            level.surrogate_paths, 25, pool);
+        if (token.cancelled()) return;
+    }
+
+    const int res = level.hm_res;
+    out.hm_res = res;
+    out.heatmap.resize(res * res);
+    pool.parallelFor(res * res, [&](std::size_t begin, std::size_t end, int) {
+        for (int cell = static_cast<int>(begin); cell < static_cast<int>(end); ++cell) {
+            int y = cell / res, x = cell % res;
+            float s = hm_spot_min + (float)x / (res - 1) * (hm_spot_max - hm_spot_min);
+            float v = hm_vol_min + (float)y / (res - 1) * (hm_vol_max - hm_vol_min);
+            if (in.heatmapModel == 1) {
+                out.heatmap[cell] = (float)surrogate.evaluate({s, v});
+            } else {
+                BlackScholes cellBS(s, in.strike, in.rate, v, in.maturity, type);
+                out.heatmap[cell] = (float)cellBS.price();
+            }
+        }
+    });
+}
 
 static void glfw_error_callback(int error, const char* description) {
     fprintf(stderr, "GLFW Error %d: %s\n", error, description);
@@ -54,6 +199,7 @@ int main(int, char**) {
     float volatility = 0.20f;
     float maturity = 1.0f;
     int optionType = 0; 
+    int heatmapModel = 0;
 
     // --- HESTON PARAMETERS [NEW] ---
     // v0: Initial Variance
@@ -66,20 +212,18 @@ int main(int, char**) {
     float h_xi = 0.1f;
     float h_rho = -0.7f;   // Standard negative correlation in equity markets
 
-    // Graph Buffers
-    const int resolution = 100;
-    std::vector<float> x_data(resolution);
-    std::vector<float> y_bs(resolution);
-    std::vector<float> y_heston(resolution); // Store Heston curve data
+    // Worker pool shared by every computation of the dashboard
+    ThreadPoolExecutor pool;
 
-    // Heatmap Buffers
-    const int hm_res = 80; // Reduced resolution for real-time performance
-    std::vector<float> heatmap_values(hm_res * hm_res);
-    float hm_spot_min = 50.0f, hm_spot_max = 150.0f;
-    float hm_vol_min = 0.05f, hm_vol_max = 1.0f;
+    // Results published by the background jobs; the render loop only reads them
+    DoubleBuffer<LiveResult> liveBuffer;
+    DoubleBuffer<SurfaceResult> surfaceBuffer;
 
-    // Heston Instance (Lower sim count for GUI responsiveness)
-    HestonPricer hestonPricer(5000, 50); 
+    // Background jobs (declared after what they use, so they stop first).
+    // A new submission supersedes the running job of the same kind.
+    JobRunner liveJobs, surfaceJobs;
+    bool has_live = false, has_surface = false;
+    ModelInputs live_inputs{}, surface_inputs{};
 
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
@@ -117,25 +261,71 @@ int main(int, char**) {
 
         // --- LIVE PRICING ---
         OptionType type = (optionType == 0) ? OptionType::CALL : OptionType::PUT;
-        EuropeanOption opt(strike, maturity, type);
-        
+
         // 1. Black-Scholes Price
         BlackScholes bs(spot, strike, rate, volatility, maturity, type);
         double priceBS = bs.price();
 
-        // 2. Heston Price (Current Spot)
-        // Note: v0 = volatility^2 to match BS input
-        double v0 = volatility * volatility;
-        double priceHeston = hestonPricer.price(opt, spot, rate, v0, h_kappa, h_theta, h_xi, h_rho);
+        // 2. Heston Price (Current Spot) and curves: submitted when their inputs move,
+        // computed off the render thread, coarse first
+        ModelInputs inputs{spot, strike, rate, volatility, maturity, h_kappa, h_theta, h_xi, h_rho, optionType, heatmapModel};
+        ModelInputs live_key = inputs;
+        live_key.heatmapModel = 0;
+        if (!has_live || live_key != live_inputs) {
+            liveJobs.submit([&pool, &liveBuffer, inputs](const JobToken& token) {
+                refineProgressively(liveBuffer, token, NUM_LEVELS, [&](int level, LiveResult& out, const JobToken&) {
+                    computeLive(inputs, LEVELS[level], pool, out);
+                });
+            });
+            live_inputs = live_key;
+            has_live = true;
+        }
+        ModelInputs surface_key = inputs;
+        surface_key.spot = 0.0f;
+        if (!has_surface || surface_key != surface_inputs) {
+            surfaceJobs.submit([&pool, &surfaceBuffer, surface_key](const JobToken& token) {
+                refineProgressively(surfaceBuffer, token, NUM_LEVELS, [&](int level, SurfaceResult& out, const JobToken& t) {
+                    computeSurface(surface_key, LEVELS[level], pool, out, t);
+                });
+            });
+            surface_inputs = surface_key;
+            has_surface = true;
+        }
+
+        double priceHeston = 0.0;
+        bool liveFinal = false;
+        liveBuffer.read([&](const LiveResult& r, std::uint64_t generation, int level) {
+            priceHeston = r.priceHeston;
+            liveFinal = generation == liveJobs.generation() && level == NUM_LEVELS - 1;
+        });
 
         ImGui::TextColored(ImVec4(0, 1, 0, 1), "PRICING RESULTS");
         ImGui::Text("BS Price:      %.4f $", priceBS);
-        ImGui::Text("Heston Price:  %.4f $", priceHeston);
+        ImGui::Text("Heston Price:  %.4f $%s", priceHeston, liveFinal ? "" : "  (refining...)");
         
         double diff = priceHeston - priceBS;
         ImGui::TextColored(diff > 0 ? ImVec4(1,0.3f,0.3f,1) : ImVec4(0.3f,0.3f,1,1), 
                           "Diff (Model Risk): %.4f $", diff);
 
+#if PRICING_INSTRUMENTATION
+        // --- ENGINE COUNTERS ---
+        ImGui::Spacing(); ImGui::Separator();
+        ImGui::TextColored(ImVec4(1, 1, 0, 1), "ENGINE COUNTERS");
+        Instrumentation::Snapshot snap = Instrumentation::snapshot();
+        for (int p = 0; p < Instrumentation::NUM_PHASES; ++p) {
+            if (snap.phaseCalls[p] == 0) continue;
+            Instrumentation::Phase phase = static_cast<Instrumentation::Phase>(p);
+            ImGui::Text("%-16s %9.2f ms (x%.2f)", Instrumentation::phaseName(phase),
+                        snap.phaseMs(phase), snap.imbalance(phase));
+        }
+        for (int c = 0; c < Instrumentation::NUM_COUNTERS; ++c) {
+            if (snap.counters[c] == 0) continue;
+            ImGui::Text("%-16s %12llu", Instrumentation::counterName(static_cast<Instrumentation::Counter>(c)),
+                        static_cast<unsigned long long>(snap.counters[c]));
+        }
+        if (ImGui::Button("Reset Counters")) Instrumentation::reset();
+#endif
+
         ImGui::EndChild();
 
         // --- RIGHT COLUMN: VISUALIZATION ---
@@ -147,49 +337,35 @@ int main(int, char**) {
             // TAB 1: MODEL COMPARISON
             if (ImGui::BeginTabItem("Model Comparison")) {
                 
-                // Parallel calculation of the full curve
-                #pragma omp parallel for
-                for (int i = 0; i < resolution; ++i) {
-                    float s = 50.0f + i * (100.0f / resolution); 
-                    x_data[i] = s;
-                    
-                    // BS
-                    BlackScholes tBS(s, strike, rate, volatility, maturity, type);
-                    y_bs[i] = (float)tBS.price();
-
-                    // Heston (Using local thread-safe instance)
-                    HestonPricer localHeston(2000, 30); // Reduced precision for full graph speed
-                    y_heston[i] = (float)localHeston.price(opt, s, rate, v0, h_kappa, h_theta, h_xi, h_rho);
-                }
-
                 if (ImPlot::BeginPlot("Black-Scholes vs Heston", ImVec2(-1, -1))) {
                     ImPlot::SetupAxes("Spot Price", "Option Value");
-                    ImPlot::PlotLine("Black-Scholes", x_data.data(), y_bs.data(), resolution);
-                    ImPlot::SetNextLineStyle(ImVec4(1, 0.5f, 0, 1)); // Orange for Heston
-                    ImPlot::PlotLine("Heston Model", x_data.data(), y_heston.data(), resolution);
-                    
+                    surfaceBuffer.read([&](const SurfaceResult& r, std::uint64_t, int) {
+                        int n = static_cast<int>(r.x.size());
+                        ImPlot::PlotLine("Black-Scholes", r.x.data(), r.bs.data(), n);
+                        ImPlot::SetNextLineStyle(ImVec4(1, 0.5f, 0, 1)); // Orange for Heston
+                        ImPlot::PlotLine("Heston Model", r.x.data(), r.heston.data(), n);
+                        ImPlot::SetNextLineStyle(ImVec4(0.3f, 0.8f, 0.3f, 1)); // Green for GBM Monte Carlo
+                        ImPlot::PlotLine("Monte Carlo (GBM)", r.x.data(), r.mc.data(), n);
+                    });
+
                     ImPlot::TagX(spot, ImVec4(1,1,1,0.5f), "Spot");
                     ImPlot::EndPlot();
                 }
                 ImGui::EndTabItem();
             }
 
-            // TAB 2: HEATMAP (Keep BS Heatmap for speed/visual clarity)
-            if (ImGui::BeginTabItem("BS Heatmap")) {
-                #pragma omp parallel for collapse(2)
-                for (int y = 0; y < hm_res; ++y) {
-                    for (int x = 0; x < hm_res; ++x) {
-                        float s = hm_spot_min + (float)x / (hm_res - 1) * (hm_spot_max - hm_spot_min);
-                        float v = hm_vol_min + (float)y / (hm_res - 1) * (hm_vol_max - hm_vol_min);
-                        BlackScholes cellBS(s, strike, rate, v, maturity, type);
-                        heatmap_values[y * hm_res + x] = (float)cellBS.price();
-                    }
-                }
+            // TAB 2: HEATMAP (Black-Scholes, or Heston through its Chebyshev surrogate)
+            if (ImGui::BeginTabItem("Price Heatmap")) {
+                ImGui::RadioButton("Black-Scholes", &heatmapModel, 0); ImGui::SameLine();
+                ImGui::RadioButton("Heston (surrogate)", &heatmapModel, 1);
                 ImPlot::PushColormap(ImPlotColormap_Jet);
                 if (ImPlot::BeginPlot("##Heatmap", ImVec2(-1, -1))) {
                     ImPlot::SetupAxes("Spot Price", "Volatility", 0, 0);
-                    ImPlot::PlotHeatmap("Price", heatmap_values.data(), hm_res, hm_res, 0, 0, nullptr, 
-                                      {hm_spot_min, hm_vol_min}, {hm_spot_max, hm_vol_max});
+                    surfaceBuffer.read([&](const SurfaceResult& r, std::uint64_t, int) {
+                        if (r.hm_res == 0) return;
+                        ImPlot::PlotHeatmap("Price", r.heatmap.data(), r.hm_res, r.hm_res, 0, 0, nullptr,
+                                            {hm_spot_min, hm_vol_min}, {hm_spot_max, hm_vol_max});
+                    });
                     ImPlot::PlotScatter("You", &spot, &volatility, 1);
                     ImPlot::EndPlot();
                 }
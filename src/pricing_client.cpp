@@ -0,0 +1,188 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include "BlackScholes.h"
+#include "PricingProtocol.h"
+
+using namespace PricingProtocol;
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+struct ConnectionResult {
+    std::vector<std::int64_t> latencies_ns;
+    std::size_t errors = 0;
+    double max_price_error = 0.0; // Against a local BlackScholes, PRICE/GREEKS only
+    bool failed = false;
+};
+
+static std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static RequestKind kindFor(const std::string& mode, std::size_t i) {
+    if (mode == "price") return RequestKind::PRICE;
+    if (mode == "greeks") return RequestKind::GREEKS;
+    if (mode == "iv") return RequestKind::IMPLIED_VOL;
+    if (mode == "mc") return RequestKind::MC_PRICE;
+    // mix: mostly analytic, a few IV, rare MC
+    if (i % 100 == 0) return RequestKind::MC_PRICE;
+    if (i % 10 == 0) return RequestKind::IMPLIED_VOL;
+    return (i % 2 == 0) ? RequestKind::PRICE : RequestKind::GREEKS;
+}
+
+// Keeps 'inflight' requests outstanding on one connection until 'total' responses arrived
+static void runConnection(const Endpoint& endpoint, const std::string& mode, std::size_t total,
+                          std::size_t inflight, unsigned int seed, ConnectionResult& result) {
+    // 1. Pre-build every request so the timed loop only does I/O
+    std::vector<RequestFrame> requests(total);
+    RandomGenerator rng(seed);
+    for (std::size_t i = 0; i < total; ++i) {
+        RequestFrame& r = requests[i];
+        std::memset(&r, 0, sizeof(r));
+        r.id = static_cast<std::uint32_t>(i);
+        r.kind = kindFor(mode, i);
+        r.optionType = static_cast<std::uint8_t>(i % 2);
+        r.spot = 100.0 + 5.0 * rng.getNormal();
+        r.strike = 80.0 + static_cast<double>(i % 41);
+        r.rate = 0.03;
+        r.volatility = 0.15 + 0.05 * std::abs(rng.getNormal());
+        r.maturity = 0.25 + static_cast<double>(i % 8) * 0.25;
+        if (r.kind == RequestKind::IMPLIED_VOL) {
+            r.volatility = BlackScholes(r.spot, r.strike, r.rate, r.volatility, r.maturity,
+                                        r.optionType == 0 ? OptionType::CALL : OptionType::PUT).price();
+        }
+    }
+
+    int fd;
+    try {
+        fd = connectTo(endpoint);
+    } catch (const std::exception&) {
+        result.failed = true;
+        return;
+    }
+
+    std::vector<std::int64_t> sent_at(total);
+    result.latencies_ns.reserve(total);
+    std::vector<ResponseFrame> responses(inflight);
+
+    // 2. Fill the pipeline
+    std::size_t sent = std::min(inflight, total);
+    std::int64_t t0 = nowNs();
+    for (std::size_t i = 0; i < sent; ++i) sent_at[i] = t0;
+    if (!writeAll(fd, requests.data(), sent * sizeof(RequestFrame))) result.failed = true;
+
+    // 3. For every batch of responses received, send as many new requests
+    std::size_t received = 0;
+    std::vector<char> buffer(inflight * sizeof(ResponseFrame));
+    std::size_t filled = 0;
+    while (!result.failed && received < total) {
+        ssize_t r = ::recv(fd, buffer.data() + filled, buffer.size() - filled, 0);
+        if (r <= 0) { result.failed = true; break; }
+        filled += static_cast<std::size_t>(r);
+        std::size_t complete = filled / sizeof(ResponseFrame);
+        std::int64_t now = nowNs();
+
+        for (std::size_t k = 0; k < complete; ++k) {
+            ResponseFrame resp;
+            std::memcpy(&resp, buffer.data() + k * sizeof(ResponseFrame), sizeof(resp));
+            result.latencies_ns.push_back(now - sent_at[resp.id]);
+            if (resp.status != Status::OK) ++result.errors;
+
+            const RequestFrame& q = requests[resp.id];
+            if (resp.status == Status::OK && (q.kind == RequestKind::PRICE || q.kind == RequestKind::GREEKS)) {
+                double local = BlackScholes(q.spot, q.strike, q.rate, q.volatility, q.maturity,
+                                            q.optionType == 0 ? OptionType::CALL : OptionType::PUT).price();
+                result.max_price_error = std::max(result.max_price_error, std::abs(local - resp.values[0]));
+            }
+        }
+        received += complete;
+        std::size_t consumed = complete * sizeof(ResponseFrame);
+        std::memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+        filled -= consumed;
+
+        std::size_t to_send = std::min(complete, total - sent);
+        if (to_send > 0) {
+            now = nowNs();
+            for (std::size_t i = sent; i < sent + to_send; ++i) sent_at[i] = now;
+            if (!writeAll(fd, requests.data() + sent, to_send * sizeof(RequestFrame))) result.failed = true;
+            sent += to_send;
+        }
+    }
+    ::close(fd);
+}
+
+int main(int argc, char** argv) {
+    std::string address = "unix:/tmp/option_pricing.sock";
+    std::string mode = "mix";
+    std::size_t connections = 4, requests = 100000, inflight = 64;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (arg == "--connections" && has_value) connections = std::stoul(argv[++i]);
+        else if (arg == "--requests" && has_value) requests = std::stoul(argv[++i]);
+        else if (arg == "--inflight" && has_value) inflight = std::stoul(argv[++i]);
+        else if (arg == "--kind" && has_value) mode = argv[++i];
+        else if (arg[0] != '-') address = arg;
+        else {
+            std::cout << "Usage: pricing_client [unix:PATH | tcp:PORT] [--connections C] [--requests N per connection]\n"
+                      << "                      [--inflight W] [--kind price|greeks|iv|mc|mix]\n";
+            return 1;
+        }
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    printSeparator();
+    std::cout << "   Pricing Server Load Generator\n";
+    printSeparator();
+    std::cout << "Target: " << address << " | " << connections << " connections x " << requests
+              << " requests | " << inflight << " in flight | kind=" << mode << "\n\n";
+
+    Endpoint endpoint = Endpoint::parse(address);
+    std::vector<ConnectionResult> results(connections);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t c = 0; c < connections; ++c) {
+        threads.emplace_back(runConnection, std::cref(endpoint), std::cref(mode), requests, inflight,
+                             static_cast<unsigned int>(1000 + c), std::ref(results[c]));
+    }
+    for (auto& t : threads) t.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<std::int64_t> all;
+    std::size_t errors = 0;
+    double max_err = 0.0;
+    bool failed = false;
+    for (const ConnectionResult& r : results) {
+        all.insert(all.end(), r.latencies_ns.begin(), r.latencies_ns.end());
+        errors += r.errors;
+        max_err = std::max(max_err, r.max_price_error);
+        failed = failed || r.failed;
+    }
+    std::sort(all.begin(), all.end());
+
+    auto pct = [&](double q) {
+        return all.empty() ? 0.0 : all[static_cast<std::size_t>(q * (all.size() - 1))] / 1000.0;
+    };
+
+    std::cout << std::left << std::fixed;
+    std::cout << std::setw(26) << "Responses:" << all.size() << (failed ? "  (connection failure!)" : "") << "\n";
+    std::cout << std::setw(26) << "Error statuses:" << errors << "\n";
+    std::cout << std::setw(26) << "Throughput:" << std::setprecision(0) << all.size() / seconds << " req/sec\n";
+    std::cout << std::setw(26) << "Latency p50:" << std::setprecision(1) << pct(0.50) << " us\n";
+    std::cout << std::setw(26) << "Latency p99:" << pct(0.99) << " us\n";
+    std::cout << std::setw(26) << "Latency p99.9:" << pct(0.999) << " us\n";
+    std::cout << std::setw(26) << "Max BS price error:" << std::scientific << std::setprecision(2) << max_err << "\n";
+    printSeparator();
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <thread>
+#include "PricingServer.h"
+
+static std::atomic<bool> g_stop{false};
+
+static void onSignal(int) {
+    g_stop.store(true);
+}
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+int main(int argc, char** argv) {
+    std::string address = "unix:/tmp/option_pricing.sock";
+    ServerConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if (arg == "--max-batch" && has_value) config.maxBatch = std::stoul(argv[++i]);
+        else if (arg == "--max-delay-us" && has_value) config.maxDelayUs = std::stoi(argv[++i]);
+        else if (arg == "--mc-paths" && has_value) config.mcPaths = std::stoi(argv[++i]);
+        else if (arg == "--threads" && has_value) config.pricingThreads = std::stoi(argv[++i]);
+        else if (arg == "--max-queue" && has_value) config.maxQueue = std::stoul(argv[++i]);
+        else if (arg[0] != '-') address = arg;
+        else {
+            std::cout << "Usage: pricing_server [unix:PATH | tcp:PORT] [--max-batch N] [--max-delay-us N] [--mc-paths N] [--threads N]\n"
+                      << "                      [--max-queue N]\n";
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    printSeparator();
+    std::cout << "   Headless Pricing Server\n";
+    printSeparator();
+
+    PricingServer server(config);
+    try {
+        server.start(address);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    std::cout << "Listening on " << address << " (max batch " << config.maxBatch
+              << ", window " << config.maxDelayUs << " us, queue "
+              << config.maxQueue << "). Ctrl-C to stop.\n";
+    if (config.pricingThreads == 0) std::cout << "Tuning: " << MachineTuning::instance().status << "\n";
+
+    while (!g_stop.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    server.stop();
+
+    std::cout << "\nRequests served: " << server.requestsServed() << "\n";
+    std::cout << "Batches run:     " << server.batchesRun() << "\n";
+    std::cout << "Avg batch size:  " << std::fixed << std::setprecision(1) << server.averageBatchSize() << "\n";
+    std::cout << "Rejected (BUSY): " << server.requestsRejected() << "\n";
+    std::cout << "Clients dropped: " << server.clientsDropped() << "\n";
+    printSeparator();
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "Arena.h"
+#include "Executor.h"
+#include "HestonMC.h"
+#include "MonteCarlo.h"
+#include "MultiAssetMC.h"
+
+// Counts every global heap allocation made by the program
+static std::atomic<std::uint64_t> g_allocations{0};
+
+// Kept out of line so GCC does not pair the inlined free() with the builtin new (-Wmismatched-new-delete)
+#if defined(__GNUC__)
+#define NOINLINE __attribute__((noinline))
+#else
+#define NOINLINE
+#endif
+
+NOINLINE void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Simulation Workspaces: Arena Allocator\n";
+    printSeparator();
+    bool ok = true;
+
+    // 1. Arena basics: alignment, reset, region merging
+    Arena arena(4096);
+    bool aligned = true;
+    for (int i = 1; i < 200; ++i) {
+        void* p = arena.allocateBytes(i * 24);
+        aligned = aligned && (reinterpret_cast<std::uintptr_t>(p) % Memory::CACHE_LINE == 0);
+    }
+    std::uint64_t regionsFirstPass = arena.systemAllocations();
+    std::size_t highWater = arena.highWater();
+    arena.reset();
+    for (int i = 1; i < 200; ++i) arena.allocateBytes(i * 24);
+    arena.reset();
+    for (int i = 1; i < 200; ++i) arena.allocateBytes(i * 24);
+    std::uint64_t regionsAfter = arena.systemAllocations();
+
+    std::cout << "64-byte alignment:          " << (aligned ? "yes" : "NO") << "\n";
+    std::cout << "High water:                 " << highWater << " bytes\n";
+    std::cout << "Regions mapped (1st pass):  " << regionsFirstPass << "\n";
+    std::cout << "Regions mapped (3 passes):  " << regionsAfter << " (merged once, then reused)\n";
+    ok = ok && aligned && regionsAfter == regionsFirstPass + 1;
+
+    // 2. Steady-state pricing must not touch the heap
+    EuropeanOption call(100.0, 1.0, OptionType::CALL);
+    ThreadPoolExecutor pool(4);
+    SerialExecutor serial;
+    OpenMPExecutor openmp;
+
+    std::cout << "\n" << std::left << std::setw(34) << "Kernel" << std::right << std::setw(14) << "Price"
+              << std::setw(20) << "Heap allocations" << "\n";
+    std::cout << std::string(68, '-') << "\n";
+
+    auto check = [&](const std::string& name, auto&& priceOnce) {
+        double price = priceOnce(); // Warm-up: arenas and per-worker buffers reach their size
+        priceOnce();
+        std::uint64_t before = g_allocations.load();
+        for (int i = 0; i < 5; ++i) price = priceOnce();
+        std::uint64_t allocs = g_allocations.load() - before;
+        std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(4)
+                  << std::setw(14) << price << std::setw(20) << allocs << "\n";
+        ok = ok && allocs == 0;
+    };
+
+    Executor* executors[] = {&serial, &pool, &openmp};
+    for (Executor* ex : executors) {
+        MonteCarloPricer mc(200000, 42, *ex);
+        check(std::string("mc.antithetic / ") + ex->name(), [&]() { return mc.price(call, 100.0, 0.05, 0.2).first; });
+
+        MonteCarloPricer det(200000, 42, *ex);
+        det.setDeterministic(true);
+        check(std::string("mc.deterministic / ") + ex->name(), [&]() { return det.price(call, 100.0, 0.05, 0.2).first; });
+
+        HestonPricer heston(5000, 100, *ex);
+        check(std::string("heston / ") + ex->name(), [&]() {
+            return heston.price(call, 100.0, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7);
+        });
+
+        MultiAssetPricer multi(20000, 42, *ex);
+        multi.setUniformCorrelation(20, 0.4);
+        BasketOption basket(100.0, 1.0, OptionType::CALL, std::vector<double>(20, 0.05));
+        std::vector<double> spots(20, 100.0), vols(20, 0.2);
+        check(std::string("multiasset.basket20 / ") + ex->name(), [&]() {
+            return multi.price(basket, spots, vols, 0.05).first;
+        });
+    }
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Workspaces are reused; steady-state pricing is allocation-free!\n";
+    } else {
+        std::cout << "\n FAILURE: Unexpected heap allocations or misaligned blocks.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "Autotune.h"
+#include "EuropeanOption.h"
+#include "Executor.h"
+#include "HestonMC.h"
+#include "MonteCarlo.h"
+#include "Tuning.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Autotuner: Machine-Specific Kernel Settings\n";
+    printSeparator();
+    bool ok = true;
+    const std::string path = "test_autotune.cfg";
+    std::cout << "Startup tuning: " << MachineTuning::instance().status << " -> " << machineTuning().describe() << "\n";
+
+    // 1. The tuned parameters only rebatch the draws: prices keep their bits
+    ThreadPoolExecutor pool(2);
+    EuropeanOption call(100.0, 1.0, OptionType::CALL);
+    MonteCarloPricer mc(200000, 42, pool);
+    mc.setBlockSize(1024);
+    double mcRef = mc.price(call, 100.0, 0.05, 0.2).first;
+    bool mcSame = true;
+    for (int size : {1, 256, 4096, 100000}) {
+        mc.setBlockSize(size);
+        mcSame = mcSame && sameBits(mc.price(call, 100.0, 0.05, 0.2).first, mcRef);
+    }
+    bool hestonSame = true;
+    for (MathPolicy policy : {MathPolicy::LIBM, MathPolicy::FAST}) {
+        HestonPricer heston(4000, 50, pool);
+        heston.setMathPolicy(policy);
+        heston.setTileWidth(16);
+        double ref = heston.price(call, 100.0, 0.05, 0.04, 1.5, 0.04, 0.5, -0.7);
+        for (int width : {1, 4, 64, 256}) {
+            heston.setTileWidth(width);
+            hestonSame = hestonSame && sameBits(heston.price(call, 100.0, 0.05, 0.04, 1.5, 0.04, 0.5, -0.7), ref);
+        }
+    }
+    std::cout << "MC price across block sizes:     " << (mcSame ? "identical" : "DIFFERENT") << "\n";
+    std::cout << "Heston price across tile widths: " << (hestonSame ? "identical" : "DIFFERENT") << "\n";
+    ok = ok && mcSame && hestonSame;
+
+    // The tuned thread count is not price-neutral in standard mode (one stream per worker):
+    // seeded prices move by sampling noise, deterministic mode keeps its bits, and such a
+    // configuration is flagged
+    ThreadPoolExecutor one(1), three(3);
+    MonteCarloPricer mcOne(200000, 42, one), mcThree(200000, 42, three);
+    auto stdOne = mcOne.price(call, 100.0, 0.05, 0.2), stdThree = mcThree.price(call, 100.0, 0.05, 0.2);
+    HestonPricer hestonOne(4000, 50, one), hestonThree(4000, 50, three);
+    bool hestonMoves = !sameBits(hestonOne.price(call, 100.0, 0.05, 0.04, 1.5, 0.04, 0.5, -0.7),
+                                 hestonThree.price(call, 100.0, 0.05, 0.04, 1.5, 0.04, 0.5, -0.7));
+    mcOne.setDeterministic(true);
+    mcThree.setDeterministic(true);
+    bool detSame = sameBits(mcOne.price(call, 100.0, 0.05, 0.2).first, mcThree.price(call, 100.0, 0.05, 0.2).first);
+    bool withinNoise = std::abs(stdOne.first - stdThree.first) < 4.0 * (stdOne.second + stdThree.second);
+    TuningConfig threadsOnly, blockOnly;
+    threadsOnly.threads = 3;
+    blockOnly.mcBlockSize = 4096;
+    bool flagged = threadsOnly.changesStandardPrices() && !blockOnly.changesStandardPrices() &&
+                   !TuningConfig().changesStandardPrices();
+    std::cout << "Standard MC, 1 vs 3 threads:     " << std::setprecision(6) << stdOne.first << " vs " << stdThree.first
+              << (withinNoise ? " (within noise)" : " (TOO FAR)") << "\n";
+    std::cout << "Deterministic MC, 1 vs 3:        " << (detSame ? "identical" : "DIFFERENT") << "\n";
+    std::cout << "Thread count flagged as pricing: " << (flagged ? "yes" : "NO") << "\n";
+    ok = ok && !sameBits(stdOne.first, stdThree.first) && hestonMoves && withinNoise && detSame && flagged;
+
+    // 2. Short search on this host
+    Autotuner tuner(100000, 2000, 50);
+    tuner.setRepetitions(3);
+    TuningReport report = tuner.tune();
+    std::cout << "\n  parameter            value                  MC ms   Heston ms\n" << std::fixed << std::setprecision(2);
+    for (const TuningTrial& t : report.trials) {
+        std::cout << "  " << std::left << std::setw(21) << t.parameter << std::setw(20) << t.value << std::right
+                  << std::setw(8) << t.mcMs << std::setw(12) << t.hestonMs << "\n";
+    }
+    std::cout << "\nBest: " << report.config.describe() << " (search " << std::setprecision(1) << report.seconds << " s)\n";
+    std::cout << "MC     default " << std::setprecision(2) << report.defaultMcMs << " ms, tuned " << report.tunedMcMs << " ms\n";
+    std::cout << "Heston default " << report.defaultHestonMs << " ms, tuned " << report.tunedHestonMs << " ms\n";
+    // Timing is noisy on a shared host: only a clear loss would be a bug
+    double score = report.tunedMcMs / report.defaultMcMs + report.tunedHestonMs / report.defaultHestonMs;
+    ok = ok && report.config.matchesThisMachine() && score < 2.5 && report.trials.size() > 1;
+
+    // 3. Persistence: round trip, other machines ignored, bad files rejected
+    report.config.save(path);
+    TuningConfig loaded = TuningConfig::load(path);
+    std::string status;
+    TuningConfig applied = TuningConfig::loadForThisMachine(path, &status);
+    bool roundTrip = loaded == report.config && applied == report.config;
+    std::cout << "\nSaved and reloaded:              " << (roundTrip ? "same settings" : "DIFFERENT") << " (" << status << ")\n";
+    ok = ok && roundTrip;
+
+    TuningConfig foreign = report.config;
+    foreign.machine = "some-other-host";
+    foreign.mcBlockSize = 64;
+    foreign.save(path);
+    applied = TuningConfig::loadForThisMachine(path, &status);
+    bool ignored = applied == TuningConfig();
+    std::cout << "File from another machine:       " << (ignored ? "defaults" : "APPLIED") << " (" << status << ")\n";
+    ok = ok && ignored;
+
+    { std::ofstream(path) << "machine = " << TuningConfig::thisMachine() << "\nmc_block_size = lots\n"; }
+    bool rejected = false;
+    try {
+        TuningConfig::load(path);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    applied = TuningConfig::loadForThisMachine(path, &status);
+    std::cout << "Corrupt file:                    " << (rejected && applied == TuningConfig() ? "rejected, defaults" : "ACCEPTED")
+              << " (" << status << ")\n";
+    ok = ok && rejected && applied == TuningConfig();
+    std::remove(path.c_str());
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Tuned settings are found and persisted; only the thread count moves prices!\n";
+    } else {
+        std::cout << "\n FAILURE: Autotuning or its persistence misbehaved.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include "BlackScholes.h"
+#include "BookFile.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+template<typename Func>
+double measure_ms(Func f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Columnar Book File: Save, mmap Load and Zero-Copy Batch Pricing\n";
+    printSeparator();
+
+    // 1. A one-million-trade book held in columns
+    const std::size_t N = 1'000'000;
+    const int SCENARIOS = 4;
+    std::vector<double> spot(N), strike(N), rate(N, 0.05), vol(N), maturity(N);
+    std::vector<OptionType> type(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        spot[i] = 100.0;
+        strike[i] = 70.0 + static_cast<double>(i % 61);
+        vol[i] = 0.10 + 0.01 * static_cast<double>(i % 30);
+        maturity[i] = 0.1 + 0.1 * static_cast<double>(i % 20);
+        type[i] = (i % 2 == 0) ? OptionType::CALL : OptionType::PUT;
+    }
+
+    OptionBatch trades;
+    trades.size = N;
+    trades.spot = spot.data();
+    trades.strike = strike.data();
+    trades.rate = rate.data();
+    trades.volatility = vol.data();
+    trades.maturity = maturity.data();
+    trades.type = type.data();
+
+    const std::string book_path = "book_test.optbook";
+    const std::string result_path = "book_test_results.optbook";
+
+    double write_ms = measure_ms([&]() {
+        BookFile::Writer writer(N);
+        writer.addTrades(trades);
+        writer.write(book_path);
+    });
+    std::cout << "Write 1M trades:          " << std::fixed << std::setprecision(2) << write_ms << " ms\n";
+
+    // 2. Map the file and price straight from the mapping
+    std::vector<double> price(N), delta(N), pnl(N * SCENARIOS);
+    double load_ms = 0.0, price_ms = 0.0;
+    bool ok = true;
+    {
+        std::unique_ptr<BookFile::MappedFile> file;
+        OptionBatch mapped;
+        load_ms = measure_ms([&]() {
+            file.reset(new BookFile::MappedFile(book_path));
+            mapped = file->optionBatch();
+        });
+        price_ms = measure_ms([&]() {
+            BatchPricer::priceBlackScholes(mapped, {price.data(), delta.data(), nullptr, nullptr});
+        });
+
+        // Spot-shock scenario P&L (-10%, -5%, +5%, +10%) stored as one wide column
+        const double shocks[SCENARIOS] = {-0.10, -0.05, 0.05, 0.10};
+        for (std::size_t i = 0; i < N; i += 997) {
+            for (int s = 0; s < SCENARIOS; ++s) {
+                BlackScholes bumped(spot[i] * (1.0 + shocks[s]), strike[i], rate[i], vol[i], maturity[i], type[i]);
+                pnl[i * SCENARIOS + s] = bumped.price() - price[i];
+            }
+        }
+        ok = ok && (mapped.spot != spot.data()); // Really reading from the mapping
+    }
+    std::cout << "mmap load (zero-copy):    " << load_ms << " ms\n";
+    std::cout << "Batch price from mapping: " << price_ms << " ms\n";
+
+    // 3. Results round-trip
+    BookFile::Writer results(N);
+    results.addResults({price.data(), delta.data(), nullptr, nullptr});
+    results.addColumn(BookFile::Columns::SCENARIO_PNL, pnl.data(), SCENARIOS);
+    results.write(result_path);
+
+    BookFile::MappedFile res(result_path);
+    auto price_col = res.doubles(BookFile::Columns::PRICE);
+    auto pnl_col = res.doubles(BookFile::Columns::SCENARIO_PNL);
+    std::cout << "Result columns:           " << res.numColumns() << " (schema v" << res.version() << ")\n";
+
+    double max_err = 0.0;
+    for (std::size_t i = 0; i < N; i += 997) {
+        BlackScholes bs(spot[i], strike[i], rate[i], vol[i], maturity[i], type[i]);
+        max_err = std::max(max_err, std::abs(bs.price() - price_col[i]));
+        max_err = std::max(max_err, std::abs(pnl_col.row(i)[3] - pnl[i * SCENARIOS + 3]));
+    }
+    std::cout << "Max error vs BlackScholes: " << std::scientific << max_err << "\n";
+
+    ok = ok && max_err < 1e-12 && pnl_col.width == SCENARIOS && price_col.rows == N;
+
+    // 4. Dividend yields survive the round trip (and change the prices)
+    const std::size_t M = 1000;
+    std::vector<double> dividend(M);
+    for (std::size_t i = 0; i < M; ++i) dividend[i] = 0.005 * static_cast<double>(i % 9);
+    OptionBatch paying = trades;
+    paying.size = M;
+    paying.dividend = dividend.data();
+    std::vector<double> expected(M), mapped_price(M);
+    BatchPricer::priceBlackScholes(paying, {expected.data(), nullptr, nullptr, nullptr});
+    {
+        BookFile::Writer writer(M);
+        writer.addTrades(paying);
+        writer.write(book_path);
+    }
+    bool dividends = false;
+    {
+        BookFile::MappedFile file(book_path);
+        OptionBatch mapped = file.optionBatch();
+        BatchPricer::priceBlackScholes(mapped, {mapped_price.data(), nullptr, nullptr, nullptr});
+        dividends = mapped.dividend != nullptr && mapped.dividend[8] == dividend[8] && mapped_price == expected &&
+                    expected[8] != price[8];
+    }
+    std::cout << "Dividend column:          " << (dividends ? "round-tripped" : "LOST") << "\n";
+    ok = ok && dividends;
+
+    // 5. Corrupt directories are rejected before any name or column is read
+    auto rejects = [&](std::size_t at, const std::string& bytes) {
+        {
+            std::fstream f(result_path, std::ios::binary | std::ios::in | std::ios::out);
+            f.seekp(static_cast<std::streamoff>(at));
+            f.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        }
+        try {
+            BookFile::MappedFile bad(result_path);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    const std::size_t entry = sizeof(BookFile::FileHeader);
+    std::uint64_t huge = ~std::uint64_t(0) - 63;
+    bool unterminated = rejects(entry, std::string(24, 'x'));
+    results.write(result_path);
+    bool overflow = rejects(entry + offsetof(BookFile::ColumnEntry, offset), std::string(reinterpret_cast<const char*>(&huge), 8));
+    std::cout << "Corrupt name / extent:    " << (unterminated && overflow ? "rejected" : "ACCEPTED") << "\n";
+    ok = ok && unterminated && overflow;
+    std::remove(result_path.c_str());
+    std::remove(book_path.c_str());
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Book and results round-tripped through the columnar file!\n";
+    } else {
+        std::cout << "\n FAILURE: Columnar round-trip mismatch.\n";
+    }
+    printSeparator();
+    return ok ? 0 : 1;
+}
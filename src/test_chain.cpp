@@ -0,0 +1,170 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "EuropeanOption.h"
+#include "HestonMC.h"
+#include "OptionBook.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Option Chain from One Heston Simulation\n";
+    printSeparator();
+    bool ok = true;
+
+    double S = 100.0, r = 0.03;
+    double v0 = 0.04, kappa = 1.5, theta = 0.04, xi = 0.5, rho = -0.7;
+    const int N = 50000, steps = 50;
+
+    // 1. One expiry: the chain sees the very paths of price()
+    std::vector<double> strikes;
+    for (double K = 70.0; K <= 130.0; K += 5.0) strikes.push_back(K);
+    SerialExecutor serial;
+    HestonPricer pricer(N, steps, serial);
+    HestonChain single = pricer.priceChain(S, r, v0, kappa, theta, xi, rho, {1.0}, strikes);
+    double singleErr = 0.0;
+    for (std::size_t k = 0; k < strikes.size(); ++k) {
+        double call = pricer.price(EuropeanOption(strikes[k], 1.0, OptionType::CALL), S, r, v0, kappa, theta, xi, rho);
+        double put = pricer.price(EuropeanOption(strikes[k], 1.0, OptionType::PUT), S, r, v0, kappa, theta, xi, rho);
+        singleErr = std::max(singleErr, std::max(std::abs(call - single.call(0, k)), std::abs(put - single.put(0, k))));
+    }
+    std::cout << "One expiry vs price():      " << std::scientific << std::setprecision(2) << singleErr << "\n";
+    ok = ok && singleErr < 1e-10;
+
+    // 2. Several expiries: parity holds pathwise, prices track independent simulations
+    std::vector<double> expiries = {1.0, 0.25, 2.0, 0.5};   // Unsorted on purpose
+    ThreadPoolExecutor pool;
+    HestonPricer chainPricer(N, steps, pool);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    HestonChain chain = chainPricer.priceChain(S, r, v0, kappa, theta, xi, rho, expiries, strikes);
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    double parityErr = 0.0;
+    double maxDiff = 0.0;
+    for (std::size_t e = 0; e < chain.expiries.size(); ++e) {
+        for (std::size_t k = 0; k < strikes.size(); ++k) {
+            double T = chain.expiries[e];
+            // C - P + K DF is the discounted mean of the simulated spots, whatever the strike
+            double df = std::exp(-r * T);
+            double forwardPV = chain.call(e, 0) - chain.put(e, 0) + strikes[0] * df;
+            double parity = chain.call(e, k) - chain.put(e, k) - (forwardPV - strikes[k] * df);
+            parityErr = std::max(parityErr, std::abs(parity));
+        }
+    }
+    std::cout << "Sorted expiries:            ";
+    for (double T : chain.expiries) std::cout << std::fixed << std::setprecision(2) << T << " ";
+    std::cout << "\nPut-call parity (pathwise): " << std::scientific << parityErr << "\n";
+    ok = ok && parityErr < 1e-10 && chain.expiries.size() == 4 && chain.expiries.front() == 0.25;
+
+    std::cout << "\n" << std::left << std::setw(10) << "T" << std::setw(10) << "K" << std::right
+              << std::setw(12) << "Chain" << std::setw(12) << "Per option" << std::setw(12) << "Diff" << "\n";
+    std::cout << std::string(56, '-') << "\n";
+    auto t2 = std::chrono::high_resolution_clock::now();
+    int contracts = 0;
+    for (std::size_t e = 0; e < chain.expiries.size(); ++e) {
+        double T = chain.expiries[e];
+        HestonPricer own(N, std::max(1, static_cast<int>(std::ceil(steps * T / 2.0))), pool);
+        for (std::size_t k = 0; k < strikes.size(); ++k) {
+            double ref = own.price(EuropeanOption(strikes[k], T, OptionType::CALL), S, r, v0, kappa, theta, xi, rho);
+            ++contracts;
+            double diff = chain.call(e, k) - ref;
+            maxDiff = std::max(maxDiff, std::abs(diff));
+            if (k % 6 == 0) {
+                std::cout << std::left << std::fixed << std::setprecision(2) << std::setw(10) << T << std::setw(10)
+                          << strikes[k] << std::right << std::setprecision(4) << std::setw(12) << chain.call(e, k)
+                          << std::setw(12) << ref << std::setw(12) << diff << "\n";
+            }
+        }
+    }
+    auto t3 = std::chrono::high_resolution_clock::now();
+    double chainMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double loopMs = std::chrono::duration<double, std::milli>(t3 - t2).count();
+    std::cout << "\nMax |chain - per option|:   " << std::fixed << std::setprecision(4) << maxDiff << "\n";
+    std::cout << "Chain (" << 2 * contracts << " quotes):        " << std::setprecision(1) << chainMs << " ms\n";
+    std::cout << "Per-option calls only:      " << loopMs << " ms\n";
+    ok = ok && maxDiff < 0.25;
+
+    // 3. Curves and dividends: each expiry carries its own context
+    MarketCurves curves(YieldCurve({0.25, 1.0, 2.0}, {0.02, 0.03, 0.04}),
+                        DividendCurve(YieldCurve({0.5, 2.0}, {0.01, 0.02}), {{0.75, 2.0}}));
+    ExpiryContext one = curves.expiry(S, 1.0);
+    HestonChain onCtx = pricer.priceChain(std::vector<ExpiryContext>{one}, v0, kappa, theta, xi, rho, strikes);
+    double ctxErr = 0.0;
+    for (std::size_t k = 0; k < strikes.size(); ++k) {
+        double call = pricer.price(EuropeanOption(strikes[k], 1.0, OptionType::CALL), one, v0, kappa, theta, xi, rho);
+        ctxErr = std::max(ctxErr, std::abs(call - onCtx.call(0, k)));
+    }
+
+    HestonChain curveChain = chainPricer.priceChain(curves, S, v0, kappa, theta, xi, rho, expiries, strikes);
+    double forwardErr = 0.0;
+    double curveDiff = 0.0;
+    for (std::size_t e = 0; e < curveChain.expiries.size(); ++e) {
+        double T = curveChain.expiries[e];
+        ExpiryContext ctx = curves.expiry(S, T);
+        // C - P + K DF estimates the discounted forward of the context
+        double forwardPV = curveChain.call(e, 0) - curveChain.put(e, 0) + strikes[0] * ctx.discount;
+        forwardErr = std::max(forwardErr, std::abs(forwardPV - ctx.forward * ctx.discount));
+        HestonPricer own(N, std::max(1, static_cast<int>(std::ceil(steps * T / 2.0))), pool);
+        for (std::size_t k = 0; k < strikes.size(); k += 3) {
+            double ref = own.price(EuropeanOption(strikes[k], T, OptionType::CALL), ctx, v0, kappa, theta, xi, rho);
+            curveDiff = std::max(curveDiff, std::abs(curveChain.call(e, k) - ref));
+        }
+    }
+
+    // The book prices its Heston trades of one underlying as one chain on the same contexts
+    OptionBook book;
+    book.setExecutor(pool);
+    book.setHestonSimulation(N, steps);
+    book.addUnderlying("SPX", S, 0.2, HestonParams{v0, kappa, theta, xi, rho});
+    book.setYieldCurve(curves.rates());
+    book.setDividends("SPX", curves.dividends());
+    for (double T : expiries) {
+        for (std::size_t k = 0; k < strikes.size(); k += 4) {
+            book.addTrade({"SPX", strikes[k], T, (k % 8 == 0) ? OptionType::CALL : OptionType::PUT,
+                           PricingModel::HESTON, 1.0});
+        }
+    }
+    book.reprice();
+    double bookErr = 0.0;
+    for (std::size_t i = 0; i < book.size(); ++i) {
+        const Trade& t = book.trade(i);
+        std::size_t e = std::find(curveChain.expiries.begin(), curveChain.expiries.end(), t.maturity) - curveChain.expiries.begin();
+        std::size_t k = std::find(strikes.begin(), strikes.end(), t.strike) - strikes.begin();
+        double quote = (t.type == OptionType::CALL) ? curveChain.call(e, k) : curveChain.put(e, k);
+        bookErr = std::max(bookErr, std::abs(book.result(i).price - quote));
+    }
+
+    std::cout << "\nCurves: one expiry vs price(ctx): " << std::scientific << std::setprecision(2) << ctxErr << "\n";
+    std::cout << "Curves: |forward - parity|:       " << std::fixed << std::setprecision(4) << forwardErr << "\n";
+    std::cout << "Curves: max |chain - per option|: " << curveDiff << "\n";
+    std::cout << "Book vs chain (" << book.size() << " trades):      " << std::scientific << bookErr << "\n";
+    ok = ok && ctxErr < 1e-10 && forwardErr < 0.3 && curveDiff < 0.25 && bookErr < 1e-10;
+
+    // 4. Jumps are rejected rather than silently ignored
+    bool rejected = false;
+    JumpParams jumps;
+    jumps.intensity = 1.0;
+    chainPricer.setJumps(jumps);
+    try {
+        chainPricer.priceChain(S, r, v0, kappa, theta, xi, rho, {1.0}, strikes);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    ok = ok && rejected;
+
+    if (ok) {
+        std::cout << "\n SUCCESS: One simulation prices the whole chain!\n";
+    } else {
+        std::cout << "\n FAILURE: Chain prices disagree with the per-option pricer.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <vector>
+#include "BatchPricer.h"
+#include "BlackScholes.h"
+#include "HestonMC.h"
+#include "MonteCarlo.h"
+#include "OptionBook.h"
+#include "TermStructure.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Term Structures: Yield Curve, Dividend Yield and Cash Dividends\n";
+    printSeparator();
+    bool ok = true;
+    std::cout << std::scientific << std::setprecision(2);
+
+    // 1. Curve: pillars are hit exactly, forwards are flat between pillars
+    YieldCurve curve({0.25, 1.0, 2.0, 5.0}, {0.030, 0.035, 0.040, 0.042});
+    double pillarErr = std::abs(curve.discount(2.0) - std::exp(-0.040 * 2.0));
+    double fwdErr = std::abs(curve.forwardRate(1.2, 1.5) - curve.forwardRate(1.6, 1.9));
+    std::cout << "Pillar discount error:      " << pillarErr << "\n";
+    std::cout << "Forward flat in [1, 2]:     " << fwdErr << "\n";
+    ok = ok && pillarErr < 1e-15 && fwdErr < 1e-12 && curve.zeroRate(10.0) == 0.042;
+
+    // 2. Flat curve, no dividends: same numbers as the scalar API
+    MarketCurves flat(YieldCurve::flat(0.05));
+    ExpiryContext flatCtx = flat.expiry(100.0, 1.0);
+    double flatErr = std::abs(BlackScholes(flatCtx, 105.0, 0.2, OptionType::CALL).price() -
+                              BlackScholes(100.0, 105.0, 0.05, 0.2, 1.0, OptionType::CALL).price());
+    std::cout << "Flat curve vs scalar BS:    " << flatErr << "\n";
+    ok = ok && flatErr == 0.0;
+
+    // 3. Curve + continuous yield + cash dividends
+    std::vector<CashDividend> cash = {{0.3, 1.5}, {0.8, 1.5}, {1.3, 1.5}};
+    MarketCurves market(curve, DividendCurve(YieldCurve::flat(0.01), cash));
+    double S = 100.0, T = 1.0;
+    ExpiryContext ctx = market.expiry(S, T);
+    double pvCash = 1.5 * curve.discount(0.3) + 1.5 * curve.discount(0.8);
+    double fwd = (S - pvCash) * std::exp((curve.zeroRate(T) - 0.01) * T);
+    std::cout << "Forward (escrowed divs):    " << std::abs(ctx.forward - fwd) << "\n";
+    ok = ok && std::abs(ctx.forward - fwd) < 1e-12;
+
+    // Put-call parity on the forward
+    double call = BlackScholes(ctx, 100.0, 0.25, OptionType::CALL).price();
+    double put = BlackScholes(ctx, 100.0, 0.25, OptionType::PUT).price();
+    double parity = std::abs(call - put - ctx.discount * (ctx.forward - 100.0));
+    std::cout << "Put-call parity:            " << parity << "\n";
+    ok = ok && parity < 1e-12;
+
+    // 4. Expiry chain kernel = per-option pricer
+    const std::size_t N = 200;
+    std::vector<double> strikes(N), vols(N), price(N), delta(N), gamma(N), vega(N);
+    std::vector<OptionType> types(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        strikes[i] = 60.0 + 0.4 * i;
+        vols[i] = 0.15 + 0.001 * i;
+        types[i] = (i % 2 == 0) ? OptionType::CALL : OptionType::PUT;
+    }
+    BatchPricer::priceExpiry(ctx, strikes.data(), vols.data(), types.data(), N,
+                             {price.data(), delta.data(), gamma.data(), vega.data()});
+    double chainErr = 0.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        BlackScholes bs(ctx, strikes[i], vols[i], types[i]);
+        chainErr = std::max(chainErr, std::abs(bs.price() - price[i]) / std::max(1.0, bs.price()));
+        chainErr = std::max(chainErr, std::abs(bs.delta() - delta[i]));
+        chainErr = std::max(chainErr, std::abs(bs.gamma() - gamma[i]));
+        chainErr = std::max(chainErr, std::abs(bs.vega() - vega[i]) / std::max(1.0, bs.vega()));
+    }
+    std::cout << "Chain kernel vs BS:         " << chainErr << "\n";
+    ok = ok && chainErr < 1e-12;
+
+    // 5. Monte Carlo pricers on the same context
+    EuropeanOption atm(100.0, T, OptionType::CALL);
+    MonteCarloPricer mc(1000000);
+    auto mcRes = mc.price(atm, ctx, 0.25);
+    double mcZ = std::abs(mcRes.first - call) / mcRes.second;
+    HestonPricer heston(200000, 20);
+    double hestonPrice = heston.price(atm, ctx, 0.0625, 1.0, 0.0625, 1e-8, 0.0);
+    std::cout << "\n" << std::fixed << std::setprecision(4)
+              << "BS (curves)                 " << call << "\n"
+              << "MC (curves)                 " << mcRes.first << "  (" << std::setprecision(2) << mcZ << " std err)\n"
+              << "Heston, frozen variance     " << std::setprecision(4) << hestonPrice << "\n";
+    ok = ok && mcZ < 4.0 && std::abs(hestonPrice - call) < 0.1;
+
+    // 6. Book: dividends only touch their underlying; results match the context pricer
+    OptionBook book(0.04);
+    book.addUnderlying("AAA", 100.0, 0.2);
+    book.addUnderlying("BBB", 50.0, 0.3);
+    for (int i = 0; i < 20; ++i) {
+        book.addTrade({(i % 2 == 0) ? "AAA" : "BBB", (i % 2 == 0) ? 100.0 : 50.0, 0.5 + 0.25 * (i % 4),
+                       OptionType::CALL, PricingModel::BLACK_SCHOLES, 1.0});
+    }
+    book.reprice();
+    book.setYieldCurve(curve);
+    std::size_t curveMove = book.reprice();
+    book.setDividends("AAA", DividendCurve(YieldCurve::flat(0.02), cash));
+    std::size_t divMove = book.reprice();
+
+    MarketCurves aaa(curve, DividendCurve(YieldCurve::flat(0.02), cash));
+    double bookErr = 0.0;
+    for (std::size_t i = 0; i < book.size(); i += 2) {
+        const Trade& t = book.trade(i);
+        BlackScholes bs(aaa.expiry(100.0, t.maturity), t.strike, 0.2, t.type);
+        bookErr = std::max(bookErr, std::abs(bs.price() - book.result(i).price));
+    }
+    std::cout << "\nCurve move repriced:        " << curveMove << " of " << book.size() << "\n";
+    std::cout << "Dividend move repriced:     " << divMove << " (AAA only)\n";
+    std::cout << "Book vs context pricer:     " << std::scientific << bookErr << "\n";
+    ok = ok && curveMove == 20 && divMove == 10 && bookErr < 1e-12;
+
+    if (ok) {
+        std::cout << "\n SUCCESS: All pricers agree on curves and dividends!\n";
+    } else {
+        std::cout << "\n FAILURE: Curve or dividend handling is inconsistent.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
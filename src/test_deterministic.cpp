@@ -0,0 +1,107 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "BlackScholes.h"
+#include "Executor.h"
+#include "MonteCarlo.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+// Bitwise comparison (== would also accept -0.0 vs 0.0)
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Reproducible Monte Carlo: Same Result for Any Thread Count\n";
+    printSeparator();
+
+    double S = 100.0, K = 100.0, r = 0.05, v = 0.2, T = 1.0;
+    EuropeanOption call(K, T, OptionType::CALL);
+    double bs_price = BlackScholes(S, K, r, v, T, OptionType::CALL).price();
+
+    // Path count deliberately not a multiple of the chunk size (last chunk is partial)
+    MonteCarloPricer mc(1'000'003, 7);
+    mc.setDeterministic(true, 4096);
+
+    // Every executor kind, at several worker counts
+    std::vector<std::unique_ptr<Executor>> executors;
+    executors.emplace_back(new SerialExecutor());
+    for (int t : {2, 3, 4, 7, 16}) executors.emplace_back(new OpenMPExecutor(t));
+    for (int t : {2, 4, 7}) executors.emplace_back(new ThreadPoolExecutor(t));
+    executors.emplace_back(new ParallelAlgorithmsExecutor(4));
+
+    bool ok = true;
+    std::pair<double, double> reference;
+    std::cout << std::left << std::setw(16) << "Executor" << std::right << std::setw(8) << "Threads"
+              << std::setw(22) << "Price" << std::setw(14) << "Std Err" << std::setw(11) << "Identical" << "\n";
+    std::cout << std::string(71, '-') << "\n";
+
+    for (bool antithetic : {false, true}) {
+        for (std::size_t i = 0; i < executors.size(); ++i) {
+            mc.setExecutor(*executors[i]);
+            auto res = mc.price(call, S, r, v, antithetic);
+            if (i == 0) reference = res;
+            bool same = sameBits(res.first, reference.first) && sameBits(res.second, reference.second);
+            ok = ok && same;
+            std::cout << std::left << std::setw(16) << executors[i]->name() << std::right
+                      << std::setw(8) << executors[i]->concurrency() << std::fixed << std::setprecision(15)
+                      << std::setw(22) << res.first << std::setprecision(10) << std::setw(14) << res.second
+                      << std::setw(11) << (same ? "yes" : "NO") << "\n";
+        }
+
+        // Still a sound estimator: within 4 standard errors of Black-Scholes
+        double err = std::abs(reference.first - bs_price);
+        std::cout << (antithetic ? "Antithetic" : "Standard") << " | BS " << std::setprecision(4) << bs_price
+                  << ", error " << err << " (" << std::setprecision(2) << err / reference.second << " std err)\n\n";
+        ok = ok && err < 4.0 * reference.second;
+    }
+
+    // A different seed must give a different stream
+    MonteCarloPricer other(1'000'003, 8);
+    other.setDeterministic(true, 4096);
+    ok = ok && !sameBits(other.price(call, S, r, v, false).first, mc.price(call, S, r, v, false).first);
+
+    // Standard mode keeps one stream per worker: a pool busy with another caller (or a nested
+    // call) runs the loop inline, and must still hand out the same ranges and worker indices
+    ThreadPoolExecutor pool(4);
+    MonteCarloPricer standard(200'003, 7, pool);
+    auto idle = standard.price(call, S, r, v);
+    std::atomic<bool> holding{false};
+    std::thread other_caller([&]() {
+        pool.parallelFor(4, [&](std::size_t, std::size_t, int) {
+            holding.store(true);
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        });
+    });
+    while (!holding.load()) std::this_thread::yield();
+    auto busy = standard.price(call, S, r, v);
+    other_caller.join();
+    std::pair<double, double> nested;
+    pool.parallelFor(4, [&](std::size_t, std::size_t, int worker) {
+        if (worker == 0) nested = standard.price(call, S, r, v);
+    });
+    bool poolStable = sameBits(idle.first, busy.first) && sameBits(idle.first, nested.first) &&
+                      sameBits(idle.second, busy.second);
+    std::cout << "Standard mode, pool busy or nested: " << (poolStable ? "identical" : "DIFFERENT") << "\n";
+    ok = ok && poolStable;
+
+    if (ok) {
+        std::cout << " SUCCESS: Results are bitwise identical across thread counts!\n";
+    } else {
+        std::cout << " FAILURE: Results depend on the thread count.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <vector>
+#include "BlackScholes.h"
+#include "Executor.h"
+#include "ExposureEngine.h"
+#include "HestonMC.h"
+#include "OptionBook.h"
+#include "QuantileSketch.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Exposure Profiles: EE / PFE on Simulated Paths (no nested MC)\n";
+    printSeparator();
+    bool ok = true;
+    std::cout << std::scientific << std::setprecision(2);
+
+    // 1. Sketch: relative error bound, and merging halves gives the sketch of the whole
+    QuantileSketch whole(0.01), left(0.01), right(0.01);
+    std::vector<double> values;
+    for (int i = 0; i < 100000; ++i) {
+        double x = (i % 10 == 0) ? 0.0 : std::exp(std::sin(i * 0.37) * 3.0);
+        values.push_back(x);
+        whole.add(x);
+        (i % 2 ? left : right).add(x);
+    }
+    left.merge(right);
+    std::sort(values.begin(), values.end());
+    double sketchErr = 0.0;
+    for (double q : {0.05, 0.25, 0.5, 0.9, 0.95, 0.99}) {
+        double exact = values[static_cast<std::size_t>(q * (values.size() - 1))];
+        double rel = exact > 0.0 ? std::abs(whole.quantile(q) - exact) / exact : whole.quantile(q);
+        sketchErr = std::max(sketchErr, rel);
+    }
+    std::cout << "Sketch max relative error:  " << sketchErr << " (bound 1e-02, " << whole.bucketCount() << " buckets)\n";
+    std::cout << "Merged halves == whole:     " << (left == whole ? "yes" : "NO") << "\n";
+    ok = ok && sketchErr <= 0.0101 && left == whole;
+
+    // Few buckets, so low buckets get folded: insertion order and merge split still do not matter
+    QuantileSketch folded(0.01, 64), reversed(0.01, 64), merged(0.01, 64);
+    std::vector<QuantileSketch> parts(3, QuantileSketch(0.01, 64));
+    for (std::size_t i = 0; i < 20000; ++i) {
+        double x = std::exp(std::sin(i * 0.37) * 3.0 + std::cos(i * 0.11));
+        folded.add(x);
+        parts[(i * 7) % 3].add(x);
+        values[i] = x;
+    }
+    for (std::size_t i = 20000; i-- > 0;) reversed.add(values[i]);
+    for (int p : {2, 0, 1}) merged.merge(parts[p]);
+    bool foldStable = folded.bucketCount() == 64 && folded == reversed && folded == merged;
+    std::cout << "Folded sketch, any order:   " << (foldStable ? "identical" : "DIFFERENT") << "\n";
+    ok = ok && foldStable;
+
+    // 2. One long call under Black-Scholes: E[C(t, S_t)] = C(0) e^(rt), and the PFE is the
+    //    call at the spot quantile (the value is increasing in S)
+    const double S0 = 100.0, K = 100.0, r = 0.03, sigma = 0.25, T = 2.0;
+    OptionBook book(r);
+    book.addUnderlying("SPX", S0, sigma);
+    book.addTrade({"SPX", K, T, OptionType::CALL});
+    std::vector<double> dates = {0.25, 0.5, 1.0, 1.5, 1.9};
+
+    ThreadPoolExecutor pool;
+    ExposureEngine engine(100000, pool);
+    engine.setQuantile(0.95);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    ExposureProfile analytic = engine.profile(book, dates);
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    const double c0 = BlackScholes(S0, K, r, sigma, T, OptionType::CALL).price();
+    const double z95 = 1.6448536269514722;
+    double eeErr = 0.0, pfeErr = 0.0;
+    std::cout << "\nLong ATM call, 100k paths (" << std::fixed << std::setprecision(1)
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms)\n";
+    std::cout << "   t      EE       exact     PFE95    exact\n";
+    for (std::size_t j = 0; j < dates.size(); ++j) {
+        double t = dates[j];
+        double ee = c0 * std::exp(r * t);
+        double sq = S0 * std::exp((r - 0.5 * sigma * sigma) * t + sigma * std::sqrt(t) * z95);
+        double pfe = BlackScholes(sq, K, r, sigma, T - t, OptionType::CALL).price();
+        eeErr = std::max(eeErr, std::abs(analytic.expectedExposure[j] - ee) / ee);
+        pfeErr = std::max(pfeErr, std::abs(analytic.pfe[j] - pfe) / pfe);
+        std::cout << std::setprecision(2) << std::setw(6) << t << std::setw(10) << analytic.expectedExposure[j]
+                  << std::setw(10) << ee << std::setw(10) << analytic.pfe[j] << std::setw(9) << pfe << "\n";
+    }
+    std::cout << std::scientific << "  max EE relative error:    " << eeErr << "\n";
+    std::cout << "  max PFE relative error:   " << pfeErr << "\n";
+    ok = ok && eeErr < 0.01 && pfeErr < 0.02;
+
+    // Thread count does not change the result
+    SerialExecutor serial;
+    ThreadPoolExecutor four(4);
+    ExposureEngine serialEngine(100000, serial), fourEngine(100000, four);
+    ExposureProfile single = serialEngine.profile(book, dates);
+    ExposureProfile threaded = fourEngine.profile(book, dates);
+    double threadDiff = 0.0;
+    bool sameSketches = true;
+    for (std::size_t j = 0; j < dates.size(); ++j) {
+        threadDiff = std::max(threadDiff, std::abs(single.expectedExposure[j] - threaded.expectedExposure[j]));
+        sameSketches = sameSketches && single.distributions[j] == threaded.distributions[j];
+    }
+    std::cout << "1 vs 4 threads: EE diff " << threadDiff << ", sketches " << (sameSketches ? "identical" : "DIFFERENT") << "\n";
+    ok = ok && threadDiff < 1e-9 && sameSketches;
+
+    // 3. Regression proxy on the same book reproduces the closed-form profile
+    engine.setAnalyticValuation(false);
+    engine.setRegressionPaths(100000);
+    ExposureProfile proxy = engine.profile(book, dates);
+    engine.setAnalyticValuation(true);
+    double proxyErr = 0.0;
+    for (std::size_t j = 0; j < dates.size(); ++j) {
+        proxyErr = std::max(proxyErr, std::abs(proxy.expectedExposure[j] - analytic.expectedExposure[j]) / analytic.expectedExposure[j]);
+    }
+    std::cout << "\nRegression proxy vs closed form, max EE error: " << proxyErr << "\n";
+    ok = ok && proxyErr < 0.01;
+
+    // 4. Netting: long call + short put = long forward, which has two-sided exposure
+    book.addTrade({"SPX", K, T, OptionType::PUT, PricingModel::BLACK_SCHOLES, -1.0});
+    ExposureProfile forward = engine.profile(book, dates);
+    // E[V(t)] of a forward struck at K: S0 - K e^(-rT), grown at r
+    double fwdErr = 0.0;
+    for (std::size_t j = 0; j < dates.size(); ++j) {
+        double expected = (S0 - K * std::exp(-r * T)) * std::exp(r * dates[j]);
+        fwdErr = std::max(fwdErr, std::abs(forward.expectedValue[j] - expected));
+    }
+    std::cout << "Long forward E[V] error:    " << fwdErr << ", ENE(1y) " << std::fixed << std::setprecision(3)
+              << forward.expectedNegativeExposure[2] << " > 0\n";
+    ok = ok && fwdErr < 0.1 && forward.expectedNegativeExposure[2] > 1.0;
+
+    // 5. Heston trade: regression proxy against the Heston price grown at r
+    OptionBook hestonBook(r);
+    HestonParams h;
+    h.xi = 0.5;
+    hestonBook.addUnderlying("SPX", S0, sigma, h);
+    hestonBook.addTrade({"SPX", K, 1.0, OptionType::CALL, PricingModel::HESTON});
+    std::vector<double> hestonDates = {0.1, 0.25, 0.5, 0.75};
+    ExposureEngine hestonEngine(50000, pool);
+    hestonEngine.setRegressionPaths(50000);
+    ExposureProfile hp = hestonEngine.profile(hestonBook, hestonDates);
+    HestonPricer reference(200000, 52, pool);
+    double h0 = reference.price(EuropeanOption(K, 1.0, OptionType::CALL), S0, r, h.v0, h.kappa, h.theta, h.xi, h.rho);
+    double hestonErr = 0.0;
+    for (std::size_t j = 0; j < hestonDates.size(); ++j) {
+        double ee = h0 * std::exp(r * hestonDates[j]);
+        hestonErr = std::max(hestonErr, std::abs(hp.expectedExposure[j] - ee) / ee);
+    }
+    std::cout << std::scientific << std::setprecision(2);
+    std::cout << "Heston (proxy) EE vs C0 e^rt: " << hestonErr << ", PFE95(0.5y) " << std::fixed << std::setprecision(3)
+              << hp.pfe[2] << ", EPE " << hp.expectedPositiveExposure() << "\n";
+    ok = ok && hestonErr < 0.03 && hp.pfe[2] > hp.expectedExposure[2];
+
+    // 6. Bad grids are rejected
+    bool rejected = false;
+    try {
+        engine.profile(book, {0.5, 0.25});
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    ok = ok && rejected;
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Exposure profiles match closed forms, proxies and quantiles!\n";
+    } else {
+        std::cout << "\n FAILURE: Exposure profiles are off.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <cstring>
+#include "EuropeanOption.h"
+#include "Executor.h"
+#include "HedgeSimulator.h"
+#include "OptionBook.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+void printRow(const char* name, const HedgeResult& r, double ms) {
+    std::cout << "  " << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(4)
+              << std::setw(9) << r.mean << std::setw(9) << r.stdDev << std::setw(9) << r.valueAtRisk(0.95)
+              << std::setw(9) << r.meanCost << std::setprecision(0) << std::setw(9) << ms << "\n";
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Delta-Hedging Backtest: Hedged P&L Distributions\n";
+    printSeparator();
+    bool ok = true;
+    using Clock = std::chrono::high_resolution_clock;
+
+    const double S = 100.0, r = 0.03, vol = 0.2;
+    EuropeanOption call(100.0, 1.0, OptionType::CALL);
+    EuropeanOption put(95.0, 0.5, OptionType::PUT);
+    ThreadPoolExecutor pool(4);
+    SerialExecutor serial;
+    const int PATHS = 100000;
+
+    std::cout << "\n  GBM, short ATM call         mean      std   VaR95     cost       ms\n";
+
+    // 1. Hedging error shrinks like 1/sqrt(rebalances); no costs and the right volatility
+    //    leave a mean of zero
+    double previousStd = 0.0;
+    for (int rebalances : {13, 52, 208}) {
+        HedgeSimulator sim(PATHS, rebalances, pool);
+        auto t0 = Clock::now();
+        HedgeResult res = sim.simulate(call, S, r, vol);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        std::string name = std::to_string(rebalances) + " rebalances";
+        printRow(name.c_str(), res, ms);
+        ok = ok && std::abs(res.mean) < 4.0 * res.stdError();
+        if (previousStd > 0.0) {
+            double ratio = previousStd / res.stdDev;
+            std::cout << "    std ratio vs 4x fewer rebalances: " << std::setprecision(3) << ratio << " (expect ~2)\n";
+            ok = ok && ratio > 1.7 && ratio < 2.3;
+        }
+        previousStd = res.stdDev;
+    }
+
+    // 2. Transaction costs lower the mean by what they cost; a put hedges the same way
+    HedgeSimulator sim(PATHS, 52, pool);
+    HedgeResult free = sim.simulate(call, S, r, vol);
+    sim.setTransactionCost(0.002);
+    HedgeResult costly = sim.simulate(call, S, r, vol);
+    printRow("52, 20bp costs", costly, 0.0);
+    double growth = std::exp(r * call.getMaturity());
+    ok = ok && costly.meanCost > 0.0 && costly.mean < free.mean &&
+         std::abs((free.mean - costly.mean) - costly.meanCost) < 0.05 * growth * costly.meanCost;
+    sim.setTransactionCost(0.0);
+    HedgeResult putRes = sim.simulate(put, S, r, vol);
+    printRow("52, OTM put", putRes, 0.0);
+    ok = ok && std::abs(putRes.mean) < 4.0 * putRes.stdError();
+
+    // 3. Distribution: sketch quantiles bracket the mean, VaR of a near-normal error
+    double q05 = free.quantile(0.05), q50 = free.quantile(0.5), q95 = free.quantile(0.95);
+    std::cout << "\nP&L quantiles 5/50/95%:        " << std::setprecision(4) << q05 << " / " << q50 << " / " << q95
+              << "  (min " << free.min << ", max " << free.max << ")\n";
+    ok = ok && free.min < q05 && q05 < q50 && q50 < q95 && q95 < free.max &&
+         free.valueAtRisk(0.95) > 1.0 * free.stdDev && free.valueAtRisk(0.95) < 2.5 * free.stdDev &&
+         free.losses.count() + free.gains.count() == static_cast<std::uint64_t>(PATHS);
+
+    // 4. Any thread count gives the same bits
+    HedgeSimulator one(PATHS, 52, serial);
+    HedgeResult single = one.simulate(call, S, r, vol);
+    bool same = sameBits(single.mean, free.mean) && sameBits(single.stdDev, free.stdDev) &&
+                sameBits(single.min, free.min) && sameBits(single.max, free.max) &&
+                single.losses == free.losses && single.gains == free.gains;
+    std::cout << "1 vs 4 threads:                " << (same ? "identical" : "DIFFERENT") << "\n";
+    ok = ok && same;
+
+    // 5. Math policies: vectorized exp/log in the step and delta loops, same draws
+    for (MathPolicy policy : {MathPolicy::PRECISE, MathPolicy::FAST}) {
+        sim.setMathPolicy(policy);
+        auto t0 = Clock::now();
+        HedgeResult res = sim.simulate(call, S, r, vol);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        double diff = std::abs(res.mean - free.mean) + std::abs(res.stdDev - free.stdDev);
+        std::cout << std::left << std::setw(31) << (std::string(mathPolicyName(policy)) + " policy |diff|:")
+                  << std::right << std::scientific << std::setprecision(2) << diff << std::fixed << std::setprecision(0)
+                  << "  (" << ms << " ms)\n";
+        ok = ok && diff < 1e-6;
+    }
+    sim.setMathPolicy(MathPolicy::LIBM);
+
+    // 6. Heston dynamics hedged at a constant volatility: the vol-of-vol error does not
+    //    diversify away with more rebalancing
+    HestonParams heston;
+    heston.v0 = 0.04;
+    heston.theta = 0.04;
+    heston.kappa = 1.5;
+    heston.xi = 0.6;
+    heston.rho = -0.7;
+    std::cout << "\n  Heston, hedged at sqrt(theta)\n";
+    double hestonStd[2];
+    int i = 0;
+    for (int rebalances : {52, 208}) {
+        HedgeSimulator hs(PATHS / 2, rebalances, pool);
+        auto t0 = Clock::now();
+        HedgeResult res = hs.simulate(call, S, r, heston);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        std::string name = std::to_string(rebalances) + " rebalances";
+        printRow(name.c_str(), res, ms);
+        hestonStd[i++] = res.stdDev;
+    }
+    double hestonRatio = hestonStd[0] / hestonStd[1];
+    std::cout << "    std ratio vs 4x fewer rebalances: " << std::setprecision(3) << hestonRatio << " (GBM ~2)\n";
+    ok = ok && hestonRatio < 1.5;
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Hedged P&L distributions behave as expected!\n";
+    } else {
+        std::cout << "\n FAILURE: A hedging error statistic is off.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
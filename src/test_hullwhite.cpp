@@ -0,0 +1,133 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <stdexcept>
+#include "BlackScholes.h"
+#include "EuropeanOption.h"
+#include "Executor.h"
+#include "HestonMC.h"
+#include "TermStructure.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+// Black-Scholes with Hull-White rates (constant spot volatility): the forward S e^(-qT) / P(t, T)
+// is lognormal with variance sigma_S^2 T + 2 rho sigma_S sigma_r int B + sigma_r^2 int B^2,
+// B(tau) = (1 - e^(-a tau)) / a the bond volatility per unit of rate volatility
+double hullWhiteCall(double S, double K, double r0, double q, double T, double volS, const HullWhiteParams& hw) {
+    double a = hw.meanReversion, sr = hw.volatility;
+    double bT = (1.0 - std::exp(-a * T)) / a;
+    double b2T = (1.0 - std::exp(-2.0 * a * T)) / (2.0 * a);
+    double intB = (T - bT) / a;
+    double intB2 = (T - 2.0 * bT + b2T) / (a * a);
+    double variance = volS * volS * T + 2.0 * hw.rhoSpot * volS * sr * intB + sr * sr * intB2;
+    return BlackScholes(S, K, r0, std::sqrt(variance / T), T, OptionType::CALL, q).price();
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Heston-Hull-White Hybrid: Stochastic Rates Monte Carlo\n";
+    printSeparator();
+    bool ok = true;
+    using Clock = std::chrono::high_resolution_clock;
+
+    const double S = 100.0, r = 0.03, T = 10.0;
+    const int PATHS = 200000, STEPS = 100;
+    EuropeanOption call(100.0, T, OptionType::CALL);
+    EuropeanOption put(100.0, T, OptionType::PUT);
+    HullWhiteParams hw;
+    hw.meanReversion = 0.05;
+    hw.volatility = 0.01;
+
+    // 1. A vanishing rate volatility gives back plain Heston (same spot/variance draws)
+    HestonPricer plain(PATHS / 4, STEPS);
+    HestonPricer hybrid(PATHS / 4, STEPS);
+    HullWhiteParams tiny = hw;
+    tiny.volatility = 1e-12;
+    hybrid.setHullWhite(tiny);
+    double base = plain.price(call, S, r, 0.04, 1.5, 0.04, 0.5, -0.7);
+    double limit = hybrid.price(call, S, r, 0.04, 1.5, 0.04, 0.5, -0.7);
+    std::cout << "sigma_r -> 0 vs plain Heston:   " << std::fixed << std::setprecision(6) << limit << " vs " << base
+              << " (rel diff " << std::scientific << std::setprecision(2) << std::abs(limit / base - 1.0) << ")\n";
+    ok = ok && std::abs(limit / base - 1.0) < 1e-9;
+
+    // 2. Constant spot volatility (xi = 0): closed form with Gaussian rates, 10y call
+    std::cout << "\n  rho(S, r)        MC     closed form   no rate vol    |err|\n" << std::fixed;
+    HestonPricer pricer(PATHS, STEPS);
+    for (double rho : {-0.5, 0.0, 0.5}) {
+        hw.rhoSpot = rho;
+        pricer.setHullWhite(hw);
+        double mc = pricer.price(call, S, r, 0.04, 1.0, 0.04, 0.0, -0.7);
+        double exact = hullWhiteCall(S, 100.0, r, 0.0, T, 0.2, hw);
+        double flat = BlackScholes(S, 100.0, r, 0.2, T, OptionType::CALL).price();
+        std::cout << std::setprecision(1) << std::setw(9) << rho << std::setprecision(4) << std::setw(12) << mc
+                  << std::setw(13) << exact << std::setw(13) << flat << std::setw(11) << std::abs(mc - exact) << "\n";
+        ok = ok && std::abs(mc - exact) < 0.01 * exact;
+    }
+
+    // 3. Full hybrid: put-call parity holds against the curve (exact martingale and fitted
+    //    bond prices), through an expiry context with a dividend yield
+    hw.rhoSpot = 0.3;
+    hw.rhoVariance = -0.2;
+    pricer.setHullWhite(hw);
+    YieldCurve curve({2.0, T}, {0.02, r});
+    DividendCurve dividends(0.01);
+    ExpiryContext ctx = makeExpiryContext(S, T, curve, dividends);
+    double c = pricer.price(call, ctx, 0.04, 1.5, 0.04, 0.5, -0.7);
+    double p = pricer.price(put, ctx, 0.04, 1.5, 0.04, 0.5, -0.7);
+    double parity = S * std::exp(-0.01 * T) - 100.0 * ctx.discount;
+    std::cout << "\nParity C - P:                   " << std::setprecision(4) << c - p << " vs " << parity << "\n";
+    ok = ok && std::abs((c - p) - parity) < 0.01 * c;
+
+    // 4. Cost of the extra factor per step (same paths, libm and vectorized math)
+    std::cout << "\n  policy       heston ms   hybrid ms   cost\n";
+    for (MathPolicy policy : {MathPolicy::LIBM, MathPolicy::FAST}) {
+        HestonPricer h1(PATHS / 2, STEPS), h2(PATHS / 2, STEPS);
+        h1.setMathPolicy(policy);
+        h2.setMathPolicy(policy);
+        h2.setHullWhite(hw);
+        h1.price(call, S, r, 0.04, 1.5, 0.04, 0.5, -0.7);   // Warm-up (arenas)
+        auto t0 = Clock::now();
+        double x1 = h1.price(call, S, r, 0.04, 1.5, 0.04, 0.5, -0.7);
+        auto t1 = Clock::now();
+        double x2 = h2.price(call, S, r, 0.04, 1.5, 0.04, 0.5, -0.7);
+        auto t2 = Clock::now();
+        double ms1 = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        double ms2 = std::chrono::duration<double, std::milli>(t2 - t1).count();
+        std::cout << "  " << std::left << std::setw(10) << mathPolicyName(policy) << std::right << std::setprecision(1)
+                  << std::setw(12) << ms1 << std::setw(12) << ms2 << std::setprecision(2) << std::setw(8) << ms2 / ms1
+                  << "x" << (x1 > 0.0 && x2 > 0.0 ? "" : " (bad price)") << "\n";
+    }
+
+    // 5. Inconsistent correlations and chains are rejected
+    bool rejected = false;
+    HullWhiteParams bad = hw;
+    bad.rhoSpot = 0.9;
+    bad.rhoVariance = 0.9;   // With rho(S, v) = -0.7 the 3x3 matrix is not PSD
+    pricer.setHullWhite(bad);
+    try {
+        pricer.price(call, S, r, 0.04, 1.5, 0.04, 0.5, -0.7);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    bool chainRejected = false;
+    try {
+        pricer.priceChain(S, r, 0.04, 1.5, 0.04, 0.5, -0.7, {1.0}, {100.0});
+    } catch (const std::invalid_argument&) {
+        chainRejected = true;
+    }
+    std::cout << "\nInconsistent correlations / chain rejected: " << (rejected && chainRejected ? "yes" : "NO") << "\n";
+    ok = ok && rejected && chainRejected;
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Hybrid prices match the stochastic-rates closed forms!\n";
+    } else {
+        std::cout << "\n FAILURE: Hybrid prices are off.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
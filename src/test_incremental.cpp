@@ -0,0 +1,78 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include "BlackScholes.h"
+#include "OptionBook.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Incremental Repricing: Dependency-Tracked Option Book\n";
+    printSeparator();
+
+    // 1. Book with two underlyings and 1000 Black-Scholes trades
+    OptionBook book(0.05);
+    book.addUnderlying("AAPL", 100.0, 0.20);
+    book.addUnderlying("MSFT", 250.0, 0.30);
+
+    for (int i = 0; i < 1000; ++i) {
+        Trade t;
+        t.underlying = (i % 4 == 0) ? "MSFT" : "AAPL";
+        t.strike = (i % 4 == 0) ? 200.0 + (i % 100) : 80.0 + (i % 40);
+        t.maturity = 0.25 + (i % 8) * 0.25;
+        t.type = (i % 2 == 0) ? OptionType::CALL : OptionType::PUT;
+        book.addTrade(t);
+    }
+
+    // A couple of Heston trades on MSFT
+    book.setHestonSimulation(2000, 20);
+    for (int i = 0; i < 4; ++i) {
+        book.addTrade({"MSFT", 240.0 + 10.0 * i, 1.0, OptionType::CALL, PricingModel::HESTON, 1.0});
+    }
+
+    std::size_t first = book.reprice();
+    std::cout << "Initial pricing:          " << first << " trades repriced\n";
+
+    // 2. Spot move on AAPL: only AAPL trades should be recomputed
+    book.setSpot("AAPL", 101.0);
+    std::size_t afterSpot = book.reprice();
+    std::cout << "AAPL spot 100 -> 101:     " << afterSpot << " trades repriced\n";
+
+    // 3. Same value again: nothing to do
+    book.setSpot("AAPL", 101.0);
+    std::size_t afterNoop = book.reprice();
+    std::cout << "AAPL spot unchanged:      " << afterNoop << " trades repriced\n";
+
+    // 4. Heston parameter move on MSFT: only the Heston trades
+    HestonParams h;
+    h.xi = 0.3;
+    book.setHestonParams("MSFT", h);
+    std::size_t afterHeston = book.reprice();
+    std::cout << "MSFT Heston xi 0.1 -> 0.3: " << afterHeston << " trades repriced\n";
+
+    // 5. Check every BS result against a fresh BlackScholes object
+    double max_err = 0.0;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        const Trade& t = book.trade(i);
+        BlackScholes bs(book.getSpot(t.underlying), t.strike, book.getRate(),
+                        book.getVolatility(t.underlying), t.maturity, t.type);
+        max_err = std::max(max_err, std::abs(bs.price() - book.result(i).price));
+        max_err = std::max(max_err, std::abs(bs.delta() - book.result(i).delta));
+    }
+    std::cout << "\nMax error vs BlackScholes: " << std::scientific << std::setprecision(2) << max_err << "\n";
+    std::cout << "Book value:                " << std::fixed << std::setprecision(4) << book.bookValue() << "\n";
+
+    bool ok = (first == 1004) && (afterSpot == 750) && (afterNoop == 0) && (afterHeston == 4) && (max_err < 1e-12);
+    if (ok) {
+        std::cout << "\n SUCCESS: Only dependent trades were repriced!\n";
+    } else {
+        std::cout << "\n FAILURE: Unexpected repricing counts or values.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "EuropeanOption.h"
+#include "Executor.h"
+#include "HestonMC.h"
+#include "JobSystem.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+// Result of one background pricing job
+struct PriceResult {
+    double spot = 0.0;
+    int paths = 0;
+    double price = 0.0;
+};
+
+int main() {
+    printSeparator();
+    std::cout << "   Background Jobs: Cancellation, Progressive Results, Double Buffering\n";
+    printSeparator();
+    bool ok = true;
+
+    using Clock = std::chrono::high_resolution_clock;
+    ThreadPoolExecutor pool;
+    DoubleBuffer<PriceResult> buffer;
+    const int levels = 3;
+    const int paths[levels] = {1000, 10000, 50000};
+    std::atomic<int> levelsStarted{0};
+
+    // Heston price of an ATM call, refined from 1k to 50k paths
+    auto pricingJob = [&](double spot) {
+        return [&, spot](const JobToken& token) {
+            refineProgressively(buffer, token, levels, [&](int level, PriceResult& out, const JobToken&) {
+                ++levelsStarted;
+                HestonPricer heston(paths[level], 50, pool);
+                out.spot = spot;
+                out.paths = paths[level];
+                out.price = heston.price(EuropeanOption(100.0, 1.0, OptionType::CALL), spot, 0.05,
+                                         0.04, 2.0, 0.04, 0.3, -0.7);
+            });
+        };
+    };
+
+    // 1. A "slider drag": 40 submissions, one per 2 ms frame, while the render loop reads
+    JobRunner runner;
+    double maxReadUs = 0.0;
+    std::uint64_t lastSeen = 0;
+    bool generationsMonotone = true;
+    bool consistent = true;
+    auto frame = [&]() {
+        auto t0 = Clock::now();
+        buffer.read([&](const PriceResult& r, std::uint64_t generation, int level) {
+            if (generation < lastSeen) generationsMonotone = false;
+            lastSeen = generation;
+            // Never a mix of two results: the path count always matches the level
+            if (generation != 0 && r.paths != paths[level]) consistent = false;
+        });
+        maxReadUs = std::max(maxReadUs, std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+    };
+    for (int i = 0; i < 40; ++i) {
+        runner.submit(pricingJob(80.0 + i));
+        frame();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    std::uint64_t last = runner.generation();
+    while (runner.busy()) {
+        frame();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    runner.waitIdle();
+    frame();
+
+    PriceResult final;
+    std::uint64_t finalGeneration = 0;
+    int finalLevel = -1;
+    buffer.read([&](const PriceResult& r, std::uint64_t generation, int level) {
+        final = r;
+        finalGeneration = generation;
+        finalLevel = level;
+    });
+    std::cout << "Submitted:                  40 generations (last " << last << ")\n";
+    std::cout << "Dropped before start:       " << runner.dropped() << "\n";
+    std::cout << "Superseded while running:   " << runner.superseded() << "\n";
+    std::cout << "Completed:                  " << runner.completed() << "\n";
+    std::cout << "Levels started:             " << levelsStarted.load() << " (40 x 3 if nothing were cancelled)\n";
+    std::cout << "Final result:               generation " << finalGeneration << ", level " << finalLevel
+              << ", spot " << std::fixed << std::setprecision(1) << final.spot << "\n";
+    std::cout << "Longest frame read:         " << std::setprecision(1) << maxReadUs << " us\n";
+    ok = ok && finalGeneration == last && finalLevel == levels - 1 && final.spot == 119.0;
+    ok = ok && runner.completed() >= 1 && runner.dropped() + runner.superseded() + runner.completed() == 40;
+    ok = ok && levelsStarted.load() < 40 * levels && generationsMonotone && consistent;
+
+    // 2. Progressive publication: the coarse level shows up before the job finishes
+    std::vector<int> seenLevels;
+    DoubleBuffer<int> steps;
+    JobRunner slow;
+    slow.submit([&](const JobToken& token) {
+        refineProgressively(steps, token, 3, [&](int level, int& out, const JobToken&) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(30 * (level + 1)));
+            out = level;
+        });
+    });
+    while (seenLevels.size() < 3) {
+        steps.read([&](const int& value, std::uint64_t generation, int level) {
+            if (generation != 0 && (seenLevels.empty() || seenLevels.back() != level) && value == level) {
+                seenLevels.push_back(level);
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::cout << "\nLevels seen by the reader:  " << seenLevels[0] << " " << seenLevels[1] << " " << seenLevels[2] << "\n";
+    ok = ok && seenLevels[0] == 0 && seenLevels[1] == 1 && seenLevels[2] == 2;
+
+    // 3. A stale job never publishes
+    DoubleBuffer<int> stale;
+    JobRunner staleRunner;
+    std::atomic<bool> started{false};
+    staleRunner.submit([&](const JobToken& token) {
+        refineProgressively(stale, token, 1, [&](int, int& out, const JobToken& t) {
+            started = true;
+            while (!t.cancelled()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            out = 1;
+        });
+    });
+    while (!started) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    staleRunner.submit([](const JobToken&) {});
+    staleRunner.waitIdle();
+    ok = ok && stale.version() == 0 && staleRunner.superseded() == 1;
+    std::cout << "Stale job published:        " << (stale.version() == 0 ? "no" : "YES") << "\n";
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Latest inputs win, stale work is cancelled, reads never block on pricing!\n";
+    } else {
+        std::cout << "\n FAILURE: Job scheduling or publication is inconsistent.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <vector>
+#include "BatchPricer.h"
+#include "BlackScholes.h"
+#include "HestonMC.h"
+#include "JumpDiffusion.h"
+#include "OptionBook.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Jump-Diffusion: Merton Series and Bates Monte Carlo\n";
+    printSeparator();
+    bool ok = true;
+
+    double S = 100.0, r = 0.05, sigma = 0.2, T = 0.5;
+    JumpParams jumps;
+    jumps.intensity = 1.0;
+    jumps.mean = -0.1;
+    jumps.stddev = 0.15;
+
+    // 1. No jumps = Black-Scholes
+    JumpParams none;
+    double noJump = MertonJumpDiffusion(S, 100.0, r, sigma, T, OptionType::CALL, none).price();
+    double bs = BlackScholes(S, 100.0, r, sigma, T, OptionType::CALL).price();
+    std::cout << "lambda = 0 vs BS:           " << std::scientific << std::setprecision(2)
+              << std::abs(noJump - bs) << "\n";
+    ok = ok && std::abs(noJump - bs) < 1e-12;
+
+    // 2. Adaptive truncation vs a long fixed series, and put-call parity
+    std::cout << "\n" << std::left << std::setw(12) << "lambda" << std::right << std::setw(8) << "terms"
+              << std::setw(14) << "price" << std::setw(14) << "vs 500 terms" << std::setw(14) << "parity err" << "\n";
+    std::cout << std::string(62, '-') << "\n";
+    for (double lambda : {0.1, 1.0, 5.0, 25.0}) {
+        JumpParams j = jumps;
+        j.intensity = lambda;
+        MertonJumpDiffusion adaptive(S, 95.0, r, sigma, T, OptionType::CALL, j);
+        double price = adaptive.price();
+        double full = MertonJumpDiffusion(S, 95.0, r, sigma, T, OptionType::CALL, j, 0.0, 500).price();
+        double put = MertonJumpDiffusion(S, 95.0, r, sigma, T, OptionType::PUT, j).price();
+        double parity = std::abs(price - put - (S - 95.0 * std::exp(-r * T)));
+        std::cout << std::left << std::setw(12) << std::fixed << std::setprecision(1) << lambda << std::right
+                  << std::setw(8) << adaptive.termsUsed() << std::setprecision(6) << std::setw(14) << price
+                  << std::scientific << std::setprecision(2) << std::setw(14) << std::abs(price - full)
+                  << std::setw(14) << parity << "\n";
+        ok = ok && std::abs(price - full) < 1e-9 && parity < 1e-9 && adaptive.termsUsed() < 500;
+    }
+
+    // 3. Batch kernel = scalar pricer
+    std::vector<double> spot(64, S), strike(64), rate(64, r), vol(64, sigma), maturity(64), price(64);
+    std::vector<OptionType> type(64);
+    for (int i = 0; i < 64; ++i) {
+        strike[i] = 70.0 + i;
+        maturity[i] = 0.1 + 0.03 * i;
+        type[i] = (i % 2 == 0) ? OptionType::CALL : OptionType::PUT;
+    }
+    OptionBatch batch;
+    batch.size = 64;
+    batch.spot = spot.data();
+    batch.strike = strike.data();
+    batch.rate = rate.data();
+    batch.volatility = vol.data();
+    batch.maturity = maturity.data();
+    batch.type = type.data();
+    GreeksBatch out;
+    out.price = price.data();
+    BatchPricer::priceMerton(batch, jumps, out);
+    double batchErr = 0.0;
+    for (int i = 0; i < 64; ++i) {
+        double ref = MertonJumpDiffusion(S, strike[i], r, sigma, maturity[i], type[i], jumps).price();
+        batchErr = std::max(batchErr, std::abs(ref - price[i]));
+    }
+    std::cout << "\nBatch vs scalar Merton:     " << batchErr << "\n";
+    ok = ok && batchErr < 1e-14;
+
+    // 4. Bates MC with a frozen variance process (xi ~ 0, v0 = theta = sigma^2) is Merton
+    HestonPricer bates(400000, 10);
+    bates.setJumps(jumps);
+    std::cout << "\n" << std::left << std::setw(12) << "Strike" << std::right << std::setw(14) << "Bates MC"
+              << std::setw(14) << "Merton" << std::setw(14) << "Diff" << "\n";
+    std::cout << std::string(54, '-') << "\n";
+    for (double K : {80.0, 100.0, 120.0}) {
+        EuropeanOption put(K, T, OptionType::PUT);
+        double mc = bates.price(put, S, r, sigma * sigma, 1.0, sigma * sigma, 1e-8, 0.0);
+        double merton = MertonJumpDiffusion(S, K, r, sigma, T, OptionType::PUT, jumps).price();
+        std::cout << std::left << std::setw(12) << std::fixed << std::setprecision(1) << K << std::right
+                  << std::setprecision(4) << std::setw(14) << mc << std::setw(14) << merton
+                  << std::setw(14) << mc - merton << "\n";
+        ok = ok && std::abs(mc - merton) < 0.05 + 0.01 * merton;
+    }
+
+    // Frequent small jumps: lambda T = 1500 is far past the underflow of exp(-lambda T). The
+    // jumps add about lambda sigma_J^2 of variance per year, so the price is close to
+    // Black-Scholes at sqrt(sigma^2 + lambda sigma_J^2)
+    JumpParams frequent;
+    frequent.intensity = 3000.0;
+    frequent.stddev = 0.003;
+    HestonPricer busy(200000, 10);
+    busy.setJumps(frequent);
+    double busyMC = busy.price(EuropeanOption(S, T, OptionType::CALL), S, r, sigma * sigma, 1.0, sigma * sigma, 1e-8, 0.0);
+    double busyRef = BlackScholes(S, S, r, std::sqrt(sigma * sigma + frequent.intensity * frequent.stddev * frequent.stddev),
+                                  T, OptionType::CALL).price();
+    std::cout << "\nlambda T = 1500: Bates MC " << std::setprecision(4) << busyMC << ", diffusion limit " << busyRef << "\n";
+    ok = ok && std::abs(busyMC - busyRef) < 0.05 + 0.01 * busyRef;
+
+    // 5. Book: jump-parameter moves reprice only the Merton and Bates trades
+    OptionBook book(r);
+    book.addUnderlying("SPX", S, sigma, HestonParams(), jumps);
+    book.setHestonSimulation(2000, 10);
+    for (int i = 0; i < 10; ++i) book.addTrade({"SPX", 90.0 + 2.0 * i, T, OptionType::PUT, PricingModel::BLACK_SCHOLES, 1.0});
+    for (int i = 0; i < 10; ++i) book.addTrade({"SPX", 90.0 + 2.0 * i, T, OptionType::PUT, PricingModel::MERTON, 1.0});
+    book.addTrade({"SPX", 100.0, T, OptionType::PUT, PricingModel::BATES, 1.0});
+    book.reprice();
+    double bookErr = std::abs(book.result(15).price -
+                              MertonJumpDiffusion(S, 100.0, r, sigma, T, OptionType::PUT, jumps).price());
+    JumpParams moved = jumps;
+    moved.intensity = 2.0;
+    book.setJumpParams("SPX", moved);
+    std::size_t repriced = book.reprice();
+    std::cout << "\nBook Merton vs scalar:      " << std::scientific << bookErr << "\n";
+    std::cout << "Jump move repriced:         " << repriced << " of " << book.size() << " trades\n";
+    ok = ok && bookErr < 1e-14 && repriced == 11;
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Merton series and Bates simulation agree!\n";
+    } else {
+        std::cout << "\n FAILURE: Jump-diffusion prices disagree.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include "BlackScholes.h"
+#include "EuropeanOption.h"
+#include "MonteCarlo.h"
+#include "TermStructure.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Spot Ladder: One Simulation, Many Spots and Strikes\n";
+    printSeparator();
+    bool ok = true;
+
+    double r = 0.05, vol = 0.2, T = 1.0;
+    const int N = 200000;
+    EuropeanOption call(100.0, T, OptionType::CALL);
+
+    std::vector<double> spots;
+    for (int i = 0; i < 100; ++i) spots.push_back(50.0 + i);
+
+    // 1. Each rung is the price() of its spot (same draws, different summation order)
+    MonteCarloPricer pricer(N, 42);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    SpotLadder ladder = pricer.priceLadder(call, spots, r, vol);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double ladderErr = 0.0;
+    for (std::size_t i = 0; i < spots.size(); ++i) {
+        auto ref = pricer.price(call, spots[i], r, vol);
+        ladderErr = std::max(ladderErr, std::abs(ref.first - ladder.price(i)) / std::max(1.0, ref.first));
+        ladderErr = std::max(ladderErr, std::abs(ref.second - ladder.std_errors[i]));
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    double ladderMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double loopMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    std::cout << "Ladder vs price() per spot: " << std::scientific << std::setprecision(2) << ladderErr << "\n";
+    std::cout << "100 spots: ladder " << std::fixed << std::setprecision(1) << ladderMs << " ms, one price() per spot "
+              << loopMs << " ms\n";
+    ok = ok && ladderErr < 1e-10;
+
+    // 2. Shared draws: the curve is monotone and convex, rung to rung
+    bool smooth = true;
+    for (std::size_t i = 1; i + 1 < spots.size(); ++i) {
+        smooth = smooth && ladder.price(i + 1) >= ladder.price(i) &&
+                 ladder.price(i + 1) - 2.0 * ladder.price(i) + ladder.price(i - 1) >= -1e-12;
+    }
+    std::cout << "Monotone and convex curve:  " << (smooth ? "yes" : "NO") << "\n";
+    ok = ok && smooth;
+
+    // 3. Pathwise delta and mixed gamma against Black-Scholes, calls and puts, several strikes
+    MonteCarloPricer big(2000000, 7);
+    std::vector<double> strikes = {80.0, 100.0, 120.0};
+    std::vector<double> greekSpots = {90.0, 100.0, 110.0};
+    std::cout << "\n" << std::left << std::setw(6) << "Type" << std::setw(8) << "Spot" << std::setw(8) << "Strike"
+              << std::right << std::setw(12) << "Price err" << std::setw(12) << "Delta err" << std::setw(12) << "Gamma err" << "\n";
+    std::cout << std::string(58, '-') << "\n";
+    for (OptionType type : {OptionType::CALL, OptionType::PUT}) {
+        EuropeanOption opt(100.0, T, type);
+        SpotLadder grid = big.priceLadder(opt, greekSpots, r, vol, true, strikes);
+        for (std::size_t k = 0; k < strikes.size(); ++k) {
+            for (std::size_t i = 0; i < greekSpots.size(); ++i) {
+                BlackScholes bs(greekSpots[i], strikes[k], r, vol, T, type);
+                double priceErr = std::abs(grid.price(i, k) - bs.price());
+                double deltaErr = std::abs(grid.delta(i, k) - bs.delta());
+                double gammaErr = std::abs(grid.gamma(i, k) - bs.gamma());
+                if (i == 1) {
+                    std::cout << std::left << std::setw(6) << (type == OptionType::CALL ? "Call" : "Put")
+                              << std::setw(8) << std::fixed << std::setprecision(0) << greekSpots[i] << std::setw(8)
+                              << strikes[k] << std::right << std::setprecision(5) << std::setw(12) << priceErr
+                              << std::setw(12) << deltaErr << std::setw(12) << gammaErr << "\n";
+                }
+                ok = ok && priceErr < 4.0 * grid.std_errors[grid.index(i, k)] && deltaErr < 2e-3 && gammaErr < 2e-4;
+            }
+        }
+    }
+
+    // 4. Re-evaluation of the stored returns needs no new draws
+    SpotLadder first = big.priceLadder(call, {100.0}, r, vol);
+    SpotLadder again = big.evaluateLadder(OptionType::CALL, {100.0}, {100.0});
+    std::cout << "\nRe-evaluated without draws: " << (first.price(0) == again.price(0) ? "identical" : "DIFFERENT") << "\n";
+    ok = ok && first.price(0) == again.price(0);
+
+    // 5. Curves and dividends: each rung is price(option, ctx) at its escrowed spot
+    MarketCurves curves(YieldCurve({0.5, 1.0, 2.0}, {0.03, 0.04, 0.045}),
+                        DividendCurve(YieldCurve::flat(0.015), {{0.4, 1.5}}));
+    ExpiryContext ctx = curves.expiry(100.0, T);
+    std::vector<double> ctxSpots = {ctx.spot - 5.0, ctx.spot, ctx.spot + 5.0};
+    SpotLadder onCurves = pricer.priceLadder(call, ctxSpots, ctx, vol);
+    double ctxErr = 0.0;
+    for (std::size_t i = 0; i < ctxSpots.size(); ++i) {
+        ExpiryContext bumped = ctx;
+        bumped.spot = ctxSpots[i];
+        auto ref = pricer.price(call, bumped, vol);
+        ctxErr = std::max(ctxErr, std::abs(ref.first - onCurves.price(i)) / std::max(1.0, ref.first));
+    }
+    std::cout << "Curves: ladder vs price(ctx): " << std::scientific << std::setprecision(2) << ctxErr << "\n";
+    ok = ok && ctxErr < 1e-10;
+
+    // 6. Float paths: the ladder follows the pricer's precision
+    pricer.setPrecision(Precision::FLOAT);
+    SpotLadder single = pricer.priceLadder(call, spots, r, vol);
+    pricer.setPrecision(Precision::DOUBLE);
+    double floatDiff = 0.0;
+    for (std::size_t i = 0; i < spots.size(); ++i) {
+        floatDiff = std::max(floatDiff, std::abs(single.price(i) - ladder.price(i)));
+    }
+    std::cout << "Float vs double ladder:      " << floatDiff << "\n";
+    ok = ok && floatDiff > 0.0 && floatDiff < 1e-3;
+
+    if (ok) {
+        std::cout << "\n SUCCESS: The spot ladder matches per-spot pricing and Black-Scholes Greeks!\n";
+    } else {
+        std::cout << "\n FAILURE: Spot ladder results are inconsistent.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "OptionBook.h"
+#include "ResultStore.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+// Result written by the stress test: every field a multiple of one integer, so any torn
+// read or half-applied aggregate breaks the ratios (all sums stay exact in double)
+TradeResult tagged(double g) {
+    return {g, 2.0 * g, 3.0 * g, 4.0 * g};
+}
+
+bool proportional(double value, double delta, double gamma, double vega) {
+    return delta == 2.0 * value && gamma == 3.0 * value && vega == 4.0 * value;
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Concurrent Result Store: Seqlock Shards and Live Aggregates\n";
+    printSeparator();
+    bool ok = true;
+    using Clock = std::chrono::high_resolution_clock;
+
+    // 1. A priced book: the store's aggregates are the quantity-weighted sums of the results
+    OptionBook book(0.03);
+    book.addUnderlying("AAPL", 100.0, 0.2);
+    book.addUnderlying("MSFT", 250.0, 0.3);
+    for (int i = 0; i < 2000; ++i) {
+        book.addTrade({i % 3 ? "AAPL" : "MSFT", (i % 3 ? 80.0 : 200.0) + (i % 40), 0.25 + (i % 8) * 0.25,
+                       i % 2 ? OptionType::PUT : OptionType::CALL, PricingModel::BLACK_SCHOLES, (i % 5) - 2.0});
+    }
+    book.reprice();
+    ResultStore store(book, 16);
+    store.publishAll(book);
+    book.setSpot("AAPL", 103.0);
+    std::size_t repriced = book.reprice();
+    store.publishRepriced(book);   // Replaces the AAPL contributions only
+
+    RiskSnapshot snap = store.snapshot();
+    double maxErr = 0.0;
+    for (std::size_t u = 0; u < store.underlyings().size(); ++u) {
+        RiskAggregate expected;
+        for (std::size_t i = 0; i < book.size(); ++i) {
+            const Trade& t = book.trade(i);
+            if (t.underlying != store.underlyings()[u]) continue;
+            const TradeResult& r = book.result(i);
+            expected.value += t.quantity * r.price;
+            expected.delta += t.quantity * r.delta;
+            expected.gamma += t.quantity * r.gamma;
+            expected.vega += t.quantity * r.vega;
+        }
+        const RiskAggregate& got = snap.byUnderlying[u];
+        std::cout << "  " << std::left << std::setw(6) << store.underlyings()[u] << std::right << std::fixed
+                  << std::setprecision(4) << " value " << std::setw(11) << got.value << "  delta " << std::setw(9)
+                  << got.delta << "  gamma " << std::setw(7) << got.gamma << "  vega " << std::setw(10) << got.vega << "\n";
+        maxErr = std::max({maxErr, std::abs(got.value - expected.value), std::abs(got.delta - expected.delta),
+                           std::abs(got.gamma - expected.gamma), std::abs(got.vega - expected.vega)});
+    }
+    std::cout << "Book value: store " << snap.total.value << " vs book " << book.bookValue() << ", max |err| "
+              << std::scientific << std::setprecision(2) << maxErr << ", " << snap.updates << " updates\n";
+    ok = ok && maxErr < 1e-9 && std::abs(snap.total.value - book.bookValue()) < 1e-9 && snap.updates == book.size() + repriced &&
+         repriced < book.size();
+
+    // A trade added after the store was built has no slot: rejected, nothing published
+    book.addTrade({"AAPL", 100.0, 1.0, OptionType::CALL, PricingModel::BLACK_SCHOLES, 1.0});
+    book.reprice();
+    bool rejectedBook = false, rejectedTrade = false;
+    try {
+        store.publishRepriced(book);
+    } catch (const std::invalid_argument&) {
+        rejectedBook = true;
+    }
+    try {
+        store.publish(book.size() - 1, book.result(book.size() - 1));
+    } catch (const std::out_of_range&) {
+        rejectedTrade = true;
+    }
+    bool untouched = store.snapshot().updates == snap.updates;
+    std::cout << "Trade added after build:    " << (rejectedBook && rejectedTrade && untouched ? "rejected" : "ACCEPTED") << "\n";
+    ok = ok && rejectedBook && rejectedTrade && untouched;
+
+    // 2. Stress: writers overwrite random trades (several writers on the same shards) while
+    //    readers take snapshots and read single trades; no read may ever be torn
+    const int TRADES = 4096, UNDERLYINGS = 8, WRITERS = 3, READERS = 2;
+    std::vector<std::string> names;
+    for (int u = 0; u < UNDERLYINGS; ++u) names.push_back("U" + std::to_string(u));
+    std::vector<std::size_t> underlyingOf(TRADES);
+    std::vector<double> quantity(TRADES);
+    for (int i = 0; i < TRADES; ++i) {
+        underlyingOf[i] = static_cast<std::size_t>((i * 7) % UNDERLYINGS);
+        quantity[i] = static_cast<double>(i % 3) + 1.0;
+    }
+    ResultStore live(names, underlyingOf, quantity, 8);
+
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> published{0}, snapshots{0}, tradeReads{0}, torn{0};
+    std::vector<std::thread> threads;
+    for (int w = 0; w < WRITERS; ++w) {
+        threads.emplace_back([&, w]() {
+            std::uint64_t state = 0x9E3779B97F4A7C15ull * (w + 1), count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                live.publish(state % TRADES, tagged(static_cast<double>((state >> 32) % 1000)));
+                ++count;
+            }
+            published += count;
+        });
+    }
+    for (int r = 0; r < READERS; ++r) {
+        threads.emplace_back([&, r]() {
+            std::uint64_t n = 0, reads = 0, bad = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                RiskSnapshot s = live.snapshot();
+                for (const RiskAggregate& a : s.byUnderlying) bad += !proportional(a.value, a.delta, a.gamma, a.vega);
+                bad += !proportional(s.total.value, s.total.delta, s.total.gamma, s.total.vega);
+                ++n;
+                for (int k = 0; k < 64; ++k) {
+                    TradeResult t = live.result((n * 64 + k + r * 977) % TRADES);
+                    bad += !proportional(t.price, t.delta, t.gamma, t.vega);
+                    ++reads;
+                }
+            }
+            snapshots += n;
+            tradeReads += reads;
+            torn += bad;
+        });
+    }
+    auto t0 = Clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    stop = true;
+    for (std::thread& t : threads) t.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    // Quiescent: aggregates equal the sums of the final trade results, exactly
+    RiskSnapshot last = live.snapshot();
+    std::vector<RiskAggregate> expected(UNDERLYINGS);
+    for (int i = 0; i < TRADES; ++i) {
+        TradeResult t = live.result(i);
+        RiskAggregate& a = expected[underlyingOf[i]];
+        a.value += quantity[i] * t.price;
+        a.delta += quantity[i] * t.delta;
+        a.gamma += quantity[i] * t.gamma;
+        a.vega += quantity[i] * t.vega;
+    }
+    bool exact = last.updates == published.load();
+    for (int u = 0; u < UNDERLYINGS; ++u) {
+        exact = exact && last.byUnderlying[u].value == expected[u].value && last.byUnderlying[u].delta == expected[u].delta &&
+                last.byUnderlying[u].gamma == expected[u].gamma && last.byUnderlying[u].vega == expected[u].vega;
+    }
+    std::cout << "\n" << WRITERS << " writers, " << READERS << " readers, " << std::fixed << std::setprecision(1) << seconds
+              << " s (" << std::thread::hardware_concurrency() << " hardware threads)\n";
+    std::cout << "  published:              " << published.load() << " ("
+              << std::setprecision(2) << published.load() / seconds / 1e6 << " M/s)\n";
+    std::cout << "  snapshots / trade reads: " << snapshots.load() << " / " << tradeReads.load() << "\n";
+    std::cout << "  torn reads:              " << torn.load() << "\n";
+    std::cout << "  final aggregates exact:  " << (exact ? "yes" : "NO") << "\n";
+    ok = ok && torn.load() == 0 && exact && snapshots.load() > 0 && published.load() > 0;
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Readers always see consistent results and totals!\n";
+    } else {
+        std::cout << "\n FAILURE: Inconsistent reads or aggregates.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
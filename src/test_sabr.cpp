@@ -0,0 +1,150 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include "BlackScholes.h"
+#include "Executor.h"
+#include "SABR.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   SABR: Hagan/Obloj Implied Vols and Per-Expiry Calibration\n";
+    printSeparator();
+    bool ok = true;
+    std::cout << std::scientific << std::setprecision(2);
+
+    // 1. Limits: nu = 0, beta = 1 is flat Black at alpha; the ATM point is continuous
+    SABRParams flat;
+    flat.alpha = 0.25;
+    flat.beta = 1.0;
+    flat.rho = -0.3;
+    flat.nu = 0.0;
+    double flatErr = 0.0;
+    for (double K : {50.0, 80.0, 100.0, 130.0, 200.0}) {
+        flatErr = std::max(flatErr, std::abs(SABR::impliedVol(100.0, K, 2.0, flat) - 0.25));
+    }
+    std::cout << "nu = 0, beta = 1 vs alpha:  " << flatErr << "\n";
+    ok = ok && flatErr < 1e-14;
+
+    SABRParams p;
+    p.alpha = 0.3;
+    p.beta = 0.5;
+    p.rho = -0.4;
+    p.nu = 0.6;
+    double F = 100.0;
+    double atm = SABR::impliedVol(F, F, 1.0, p);
+    double jump = std::max(std::abs(SABR::impliedVol(F, F * (1.0 + 1e-9), 1.0, p) - atm),
+                           std::abs(SABR::impliedVol(F, F * (1.0 - 1e-9), 1.0, p) - atm));
+    // Closed-form ATM vol: alpha / F^(1-b) (1 + T (...))
+    double atmRef = p.alpha / std::pow(F, 0.5) *
+        (1.0 + (0.25 / 24.0 * p.alpha * p.alpha / F + 0.25 * p.rho * p.beta * p.nu * p.alpha / std::sqrt(F) +
+                (2.0 - 3.0 * p.rho * p.rho) / 24.0 * p.nu * p.nu));
+    std::cout << "ATM vs closed form:         " << std::abs(atm - atmRef) << "\n";
+    std::cout << "ATM continuity (K = F+-):   " << jump << "\n";
+    ok = ok && std::abs(atm - atmRef) < 1e-14 && jump < 1e-9;
+
+    // Skew sign follows rho
+    ok = ok && SABR::impliedVol(F, 80.0, 1.0, p) > atm && SABR::impliedVol(F, 120.0, 1.0, p) < SABR::impliedVol(F, 80.0, 1.0, p);
+
+    // 2. SABR chain through the batch Black kernel = scalar Black-Scholes at the SABR vol
+    MarketCurves market(YieldCurve::flat(0.03), DividendCurve(0.01));
+    ExpiryContext ctx = market.expiry(100.0, 1.0);
+    const std::size_t N = 41;
+    std::vector<double> strikes(N), vols(N), price(N), delta(N);
+    std::vector<OptionType> types(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        strikes[i] = 60.0 + 2.0 * i;
+        types[i] = strikes[i] < ctx.forward ? OptionType::PUT : OptionType::CALL;
+    }
+    SABR::priceExpiry(ctx, p, strikes.data(), types.data(), N, vols.data(), {price.data(), delta.data(), nullptr, nullptr});
+    double chainErr = 0.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        double vol = SABR::impliedVol(ctx.forward, strikes[i], ctx.maturity, p);
+        BlackScholes bs(ctx, strikes[i], vol, types[i]);
+        chainErr = std::max(chainErr, std::abs(bs.price() - price[i]) + std::abs(vol - vols[i]));
+    }
+    std::cout << "SABR chain vs scalar BS:    " << chainErr << "\n";
+    ok = ok && chainErr < 1e-12;
+
+    // 3. Calibration recovers the parameters of a synthetic surface
+    const double beta = 0.7;
+    std::vector<SABRParams> truth;
+    std::vector<SABRSlice> surface;
+    for (int e = 0; e < 12; ++e) {
+        SABRParams t;
+        t.beta = beta;
+        t.alpha = 0.2 * std::pow(100.0, 1.0 - beta) * (1.0 + 0.02 * e);
+        t.rho = -0.5 + 0.05 * e;
+        t.nu = 0.8 - 0.04 * e;
+        truth.push_back(t);
+        SABRSlice s;
+        s.maturity = 0.1 + 0.25 * e;
+        s.forward = 100.0 * std::exp(0.02 * s.maturity);
+        for (int k = 0; k < 21; ++k) {
+            double K = s.forward * std::exp(0.6 * std::sqrt(s.maturity) * (k - 10) / 10.0);
+            s.strikes.push_back(K);
+            s.vols.push_back(SABR::impliedVol(s.forward, K, s.maturity, t));
+        }
+        surface.push_back(s);
+    }
+
+    ThreadPoolExecutor pool;
+    SABRCalibrator calibrator(beta, pool);
+    auto t0 = std::chrono::high_resolution_clock::now();
+    std::vector<SABRFit> cold = calibrator.calibrate(surface);
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    double paramErr = 0.0, worstRmse = 0.0;
+    int coldIterations = 0;
+    for (std::size_t e = 0; e < surface.size(); ++e) {
+        paramErr = std::max(paramErr, std::abs(cold[e].params.alpha - truth[e].alpha) / truth[e].alpha);
+        paramErr = std::max(paramErr, std::abs(cold[e].params.rho - truth[e].rho));
+        paramErr = std::max(paramErr, std::abs(cold[e].params.nu - truth[e].nu));
+        worstRmse = std::max(worstRmse, cold[e].rmse);
+        coldIterations += cold[e].iterations;
+        ok = ok && cold[e].converged;
+    }
+    std::cout << "\nCold calibration (12 x 21): " << std::fixed << std::setprecision(2)
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, "
+              << coldIterations << " LM iterations\n";
+    std::cout << "  max parameter error:      " << std::scientific << paramErr << "\n";
+    std::cout << "  worst vol RMSE:           " << worstRmse << "\n";
+    ok = ok && paramErr < 1e-5 && worstRmse < 1e-8;
+
+    // 4. Intraday move: vols shift a little, the warm start needs fewer iterations
+    for (SABRSlice& s : surface) {
+        for (std::size_t k = 0; k < s.vols.size(); ++k) s.vols[k] += 0.002 * (1.0 + 0.1 * std::sin(static_cast<double>(k)));
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    std::vector<SABRFit> warm = calibrator.calibrate(surface);
+    auto t3 = std::chrono::high_resolution_clock::now();
+    SABRCalibrator fresh(beta, pool);
+    std::vector<SABRFit> again = fresh.calibrate(surface);
+    int warmIterations = 0, freshIterations = 0;
+    double agreement = 0.0;
+    for (std::size_t e = 0; e < surface.size(); ++e) {
+        warmIterations += warm[e].iterations;
+        freshIterations += again[e].iterations;
+        agreement = std::max(agreement, std::abs(warm[e].rmse - again[e].rmse));
+    }
+    std::cout << "Warm recalibration:         " << std::fixed << std::setprecision(2)
+              << std::chrono::duration<double, std::milli>(t3 - t2).count() << " ms, " << warmIterations
+              << " iterations (cold: " << freshIterations << ")\n";
+    std::cout << "  warm vs cold RMSE:        " << std::scientific << agreement << "\n";
+    ok = ok && warmIterations < freshIterations && agreement < 1e-6;
+
+    if (ok) {
+        std::cout << "\n SUCCESS: SABR vols, pricing and calibration are consistent!\n";
+    } else {
+        std::cout << "\n FAILURE: SABR results are off.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
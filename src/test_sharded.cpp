@@ -0,0 +1,153 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include <stdexcept>
+#include "BlackScholes.h"
+#include "Executor.h"
+#include "MCAccumulator.h"
+#include "MonteCarlo.h"
+#include "ShardedMC.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+int main() {
+    // Worker processes are forked before any thread exists (see ShardedMonteCarlo)
+    ShardedMonteCarlo two(2, 2), three(3, 2), five(5, 2);
+
+    printSeparator();
+    std::cout << "   Mergeable MC Accumulators and Multi-Process Sharding\n";
+    printSeparator();
+    bool ok = true;
+    using Clock = std::chrono::high_resolution_clock;
+
+    double S = 100.0, K = 105.0, r = 0.04, v = 0.25, T = 1.5;
+    EuropeanOption call(K, T, OptionType::CALL);
+    BlackScholes bs(S, K, r, v, T, OptionType::CALL);
+
+    // 1. Exact sums: order and grouping do not change a single bit
+    ExactSum forward, backward, halves, other;
+    std::vector<double> xs;
+    for (int i = 0; i < 10000; ++i) xs.push_back(std::ldexp(std::sin(i * 1.7), (i * 37) % 200 - 100));
+    for (double x : xs) forward.add(x);
+    for (auto it = xs.rbegin(); it != xs.rend(); ++it) backward.add(*it);
+    for (std::size_t i = 0; i < xs.size(); ++i) (i < 3000 ? halves : other).add(xs[i]);
+    halves.merge(other);
+    bool exact = forward == backward && forward == halves && sameBits(forward.value(), halves.value());
+    ExactSum cancel;
+    cancel.add(1e300);
+    cancel.add(1.0);
+    cancel.add(-1e300);
+    // Rounded once: a + b is the correctly rounded sum, and digits far below the head still
+    // break a tie (1 + 2^-53 + 2^-106 rounds up)
+    bool rounded = true;
+    for (std::size_t i = 0; i + 1 < xs.size(); ++i) {
+        ExactSum pair;
+        pair.add(xs[i]);
+        pair.add(xs[i + 1] * 1e-7);
+        rounded = rounded && sameBits(pair.value(), xs[i] + xs[i + 1] * 1e-7);
+    }
+    ExactSum tie;
+    tie.add(1.0);
+    tie.add(std::ldexp(1.0, -53));
+    tie.add(std::ldexp(1.0, -106));
+    rounded = rounded && tie.value() == 1.0 + std::ldexp(1.0, -52);
+    std::cout << "Exact sum order-independent: " << (exact ? "yes" : "NO")
+              << ", 1e300 + 1 - 1e300 = " << cancel.value() << "\n";
+    std::cout << "Rounded once to nearest:    " << (rounded ? "yes" : "NO") << "\n";
+    ok = ok && exact && rounded && cancel.value() == 1.0;
+
+    // 2. One process: any thread count, any chunk split and merge order give the same bits
+    const int PATHS = 4'000'003;
+    MonteCarloPricer mc(PATHS, 11);
+    SerialExecutor serial;
+    ThreadPoolExecutor pool(4);
+    mc.setExecutor(serial);
+    auto t0 = Clock::now();
+    MCAccumulator single = mc.accumulate(call, S, r, v);
+    auto t1 = Clock::now();
+    mc.setExecutor(pool);
+    MCAccumulator threaded = mc.accumulate(call, S, r, v);
+
+    const std::uint64_t chunks = mc.numChunks();
+    MCAccumulator pieces = mc.accumulate(call, S, r, v, true, 2 * chunks / 3, MonteCarloPricer::ALL_CHUNKS);
+    pieces.merge(mc.accumulate(call, S, r, v, true, 0, 17));
+    pieces.merge(mc.accumulate(call, S, r, v, true, 17, 2 * chunks / 3));
+    std::cout << "\nPaths:                      " << single.count() << " in " << chunks << " chunks ("
+              << std::fixed << std::setprecision(1) << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms serial)\n";
+    std::cout << "1 vs 4 threads:             " << (single == threaded ? "identical" : "DIFFERENT") << "\n";
+    std::cout << "3 uneven pieces, reordered: " << (single == pieces ? "identical" : "DIFFERENT") << "\n";
+    ok = ok && single == threaded && single == pieces && single.count() == static_cast<std::uint64_t>(PATHS / 2 * 2);
+
+    // Same draws as the deterministic price(): equal up to summation order
+    mc.setDeterministic(true);
+    auto det = mc.price(call, S, r, v);
+    double detDiff = std::abs(det.first - single.price().first);
+    std::cout << "vs deterministic price():   " << std::scientific << std::setprecision(2) << detDiff << "\n";
+    ok = ok && detDiff < 1e-12 && std::abs(det.second - single.price().second) < 1e-12;
+
+    // 3. Serialisation round trip
+    std::string bytes = single.serialize();
+    MCAccumulator restored = MCAccumulator::deserialize(bytes);
+    bool rejected = false;
+    try {
+        MCAccumulator::deserialize(bytes.substr(1));
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    std::cout << "Serialised size:            " << bytes.size() << " bytes, round trip "
+              << (restored == single && sameBits(restored.price().first, single.price().first) ? "identical" : "DIFFERENT") << "\n";
+    ok = ok && restored == single && rejected;
+
+    // 4. Worker processes: the coordinator's merge equals the single run, bit for bit
+    for (ShardedMonteCarlo* sharded : {&two, &three, &five}) {
+        int processes = sharded->processes();
+        auto t2 = Clock::now();
+        MCAccumulator merged = sharded->accumulate(mc, call, S, r, v);
+        auto t3 = Clock::now();
+        bool same = merged == single && sameBits(merged.price().first, single.price().first) &&
+                    sameBits(merged.price().second, single.price().second);
+        std::cout << processes << " processes:                " << (same ? "identical" : "DIFFERENT") << " ("
+                  << std::fixed << std::setprecision(1) << std::chrono::duration<double, std::milli>(t3 - t2).count() << " ms)\n";
+        ok = ok && same;
+    }
+    MCAccumulator second = two.accumulate(mc, call, S, r, v);   // Workers serve more than one job
+    bool late = false;
+    try {
+        ShardedMonteCarlo forkedLate(2);   // The pool threads are running by now
+    } catch (const std::logic_error&) {
+        late = true;
+    }
+    std::cout << "Second job, late fork:      " << (second == single ? "identical" : "DIFFERENT") << ", "
+              << (late ? "refused" : "ALLOWED") << "\n";
+    ok = ok && second == single && late;
+
+    // 5. Estimates: price, pathwise delta and vega against Black-Scholes
+    std::cout << "\n            MC            BS           |err|/se\n" << std::setprecision(6);
+    struct Row { const char* name; MCQuantity q; double exact; };
+    for (const Row& row : {Row{"price", MCQuantity::PRICE, bs.price()}, Row{"delta", MCQuantity::DELTA, bs.delta()},
+                           Row{"vega ", MCQuantity::VEGA, bs.vega()}}) {
+        double z = std::abs(single.mean(row.q) - row.exact) / single.stdError(row.q);
+        std::cout << "  " << row.name << std::setw(14) << single.mean(row.q) << std::setw(14) << row.exact
+                  << std::setprecision(2) << std::setw(12) << z << std::setprecision(6) << "\n";
+        ok = ok && z < 4.0;
+    }
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Shards merge exactly into the single-process result!\n";
+    } else {
+        std::cout << "\n FAILURE: Merged results differ from the single run.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
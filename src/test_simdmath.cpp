@@ -0,0 +1,185 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "EuropeanOption.h"
+#include "Executor.h"
+#include "HestonMC.h"
+#include "MonteCarlo.h"
+#include "SimdMath.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+enum class Function { EXP, LOG, SQRT };
+
+const char* functionName(Function f) {
+    return f == Function::EXP ? "exp" : (f == Function::LOG ? "log" : "sqrt");
+}
+
+// One pass of f over the array: the loop the kernels contain
+template <typename Math, typename Real>
+void apply(Function f, const Real* in, Real* out, int n) {
+    switch (f) {
+    case Function::EXP:
+        SIMD_LOOP
+        for (int i = 0; i < n; ++i) out[i] = Math::exp(in[i]);
+        break;
+    case Function::LOG:
+        SIMD_LOOP
+        for (int i = 0; i < n; ++i) out[i] = Math::log(in[i]);
+        break;
+    case Function::SQRT:
+        SIMD_LOOP
+        for (int i = 0; i < n; ++i) out[i] = Math::sqrt(in[i]);
+        break;
+    }
+}
+
+double reference(Function f, double x) {
+    return f == Function::EXP ? std::exp(x) : (f == Function::LOG ? std::log(x) : std::sqrt(x));
+}
+
+// Inputs spanning each function's domain: exp over [-700, 700] (plus the kernel range),
+// log and sqrt log-uniformly over the normal numbers of the type
+template <typename Real>
+std::vector<Real> inputs(Function f, int n) {
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    const double maxExp = sizeof(Real) == 8 ? 700.0 : 85.0;
+    const double decades = sizeof(Real) == 8 ? 300.0 : 37.0;
+    std::vector<Real> x(n);
+    for (int i = 0; i < n; ++i) {
+        double v = u(gen);
+        if (f == Function::EXP) x[i] = static_cast<Real>(i % 2 ? (2 * v - 1) * maxExp : (2 * v - 1) * 5.0);
+        else x[i] = static_cast<Real>(std::pow(10.0, (2 * v - 1) * decades));
+    }
+    if (f == Function::SQRT) x[0] = 0;
+    return x;
+}
+
+struct Measurement {
+    double maxRelError;
+    double nsPerValue;
+};
+
+// Largest relative error against libm in double (log: relative to max(|ln x|, 1)), and
+// throughput over a cache-resident block
+template <typename Math, typename Real>
+Measurement measure(Function f) {
+    const int N = 1 << 20;
+    std::vector<Real> in = inputs<Real>(f, N), out(N);
+    apply<Math>(f, in.data(), out.data(), N);
+    double err = 0.0;
+    for (int i = 0; i < N; ++i) {
+        double exact = reference(f, static_cast<double>(in[i]));
+        double scale = f == Function::LOG ? std::max(std::abs(exact), 1.0) : std::abs(exact);
+        if (scale > 0.0) err = std::max(err, std::abs(static_cast<double>(out[i]) - exact) / scale);
+        else err = std::max(err, std::abs(static_cast<double>(out[i])));
+    }
+
+    const int BLOCK = 4096, REPS = 2000;
+    Real sink = 0;
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < REPS; ++r) {
+        apply<Math>(f, in.data() + (r % 64) * BLOCK, out.data(), BLOCK);
+        sink += out[r % BLOCK];
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    volatile Real keep = sink;
+    (void)keep;
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (static_cast<double>(BLOCK) * REPS);
+    return {err, ns};
+}
+
+// Accuracy/throughput table of every tier for one type; checks each error against its bound
+template <typename Real>
+bool table(const char* type, double preciseBound, double fastBound) {
+    bool ok = true;
+    std::cout << "\n" << type << "       max rel err      ns/value   vs libm\n";
+    for (Function f : {Function::EXP, Function::LOG, Function::SQRT}) {
+        Measurement libm = measure<LibmMath, Real>(f);
+        Measurement precise = measure<PreciseMath, Real>(f);
+        Measurement fast = measure<FastMath, Real>(f);
+        // libm float is compared with double libm too, so it has an error of its own
+        struct Row { const char* name; Measurement m; double bound; };
+        for (const Row& row : {Row{"libm", libm, sizeof(Real) == 8 ? 0.0 : preciseBound},
+                               Row{"precise", precise, preciseBound}, Row{"fast", fast, fastBound}}) {
+            std::cout << "  " << std::left << std::setw(5) << functionName(f) << std::setw(8) << row.name
+                      << std::right << std::scientific << std::setprecision(2) << std::setw(11) << row.m.maxRelError
+                      << std::fixed << std::setw(13) << row.m.nsPerValue << std::setw(9)
+                      << libm.nsPerValue / row.m.nsPerValue << "x\n";
+            ok = ok && row.m.maxRelError <= row.bound;
+        }
+    }
+    return ok;
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   SIMD Math: Accuracy and Throughput of exp / log / sqrt Tiers\n";
+    printSeparator();
+    bool ok = true;
+
+    // 1. Accuracy and throughput per function, tier and type
+    ok = table<double>("double", 1e-15, 1e-10) && ok;
+    ok = table<float>("float ", 3e-7, 1e-5) && ok;
+
+    // 2. Range ends: exp underflows to 0 and overflows to inf like libm, sqrt(0) = 0
+    bool ends = PreciseMath::exp(-1000.0) == 0.0 && std::isinf(PreciseMath::exp(1000.0)) &&
+                std::abs(PreciseMath::exp(-720.0) / std::exp(-720.0) - 1.0) < 1e-9 &&
+                FastMath::exp(-150.0f) == 0.0f && std::isinf(FastMath::exp(100.0f)) &&
+                PreciseMath::sqrt(0.0) == 0.0 && FastMath::sqrt(0.0f) == 0.0f;
+    std::cout << "\nRange ends (0, inf, subnormal exp, sqrt 0): " << (ends ? "ok" : "WRONG") << "\n";
+    ok = ok && ends;
+
+    // 3. Kernels: same draws under every policy, so the price moves only by the function error
+    SerialExecutor serial;
+    EuropeanOption call(100.0, 1.0, OptionType::CALL);
+    std::cout << "\nKernels           policy        price          |diff|      ms\n";
+    double mcBase = 0.0, hestonBase = 0.0, mcBaseMs = 0.0, hestonBaseMs = 0.0;
+    for (MathPolicy policy : {MathPolicy::LIBM, MathPolicy::PRECISE, MathPolicy::FAST}) {
+        MonteCarloPricer mc(2'000'000, 42, serial);
+        mc.setMathPolicy(policy);
+        HestonPricer heston(20'000, 100, serial);
+        heston.setMathPolicy(policy);
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+        double mcPrice = mc.price(call, 100.0, 0.05, 0.2).first;
+        auto t1 = std::chrono::high_resolution_clock::now();
+        double hestonPrice = heston.price(call, 100.0, 0.05, 0.04, 2.0, 0.04, 0.3, -0.7);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double mcMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        double hestonMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+        if (policy == MathPolicy::LIBM) {
+            mcBase = mcPrice;
+            hestonBase = hestonPrice;
+            mcBaseMs = mcMs;
+            hestonBaseMs = hestonMs;
+        }
+        double bound = policy == MathPolicy::FAST ? 1e-8 : 1e-12;
+        double mcDiff = std::abs(mcPrice - mcBase), hestonDiff = std::abs(hestonPrice - hestonBase);
+        for (int k = 0; k < 2; ++k) {
+            std::cout << "  " << std::left << std::setw(16) << (k == 0 ? "mc.antithetic" : "heston")
+                      << std::setw(9) << mathPolicyName(policy) << std::right << std::fixed << std::setprecision(8)
+                      << std::setw(14) << (k == 0 ? mcPrice : hestonPrice) << std::scientific << std::setprecision(2)
+                      << std::setw(12) << (k == 0 ? mcDiff : hestonDiff) << std::fixed << std::setprecision(1)
+                      << std::setw(8) << (k == 0 ? mcMs : hestonMs) << " (" << std::setprecision(2)
+                      << (k == 0 ? mcBaseMs / mcMs : hestonBaseMs / hestonMs) << "x)\n";
+        }
+        ok = ok && mcDiff < bound * mcBase && hestonDiff < bound * hestonBase;
+    }
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Every tier is within its error bound!\n";
+    } else {
+        std::cout << "\n FAILURE: A tier exceeds its error bound.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "BlackScholes.h"
+#include "ChebyshevSurrogate.h"
+#include "Executor.h"
+
+void printSeparator() {
+    std::cout << std::string(70, '=') << "\n";
+}
+
+int main() {
+    printSeparator();
+    std::cout << "   Chebyshev Surrogates: Build, Error Estimate, Save/Load, Evaluate\n";
+    printSeparator();
+    bool ok = true;
+    ThreadPoolExecutor pool;
+
+    // 1. Smooth 3-D function: Black-Scholes over (spot, vol, T)
+    auto bs = [](const double* x, int) {
+        return BlackScholes(x[0], 100.0, 0.05, x[1], x[2], OptionType::CALL).price();
+    };
+    std::vector<ChebyshevAxis> box = {{60.0, 140.0, 24}, {0.1, 0.5, 12}, {0.25, 2.0, 12}};
+    ChebyshevSurrogate bsSurrogate = ChebyshevSurrogate::build(box, bs, pool);
+    double bsErr = bsSurrogate.validate(bs, 20000);
+    std::cout << "BS (24x12x12 nodes)\n";
+    std::cout << "  tail estimate:            " << std::scientific << std::setprecision(2) << bsSurrogate.errorEstimate() << "\n";
+    std::cout << "  max error (20k points):   " << bsErr << "\n";
+    ok = ok && bsErr < 1e-3 && bsErr < 10.0 * bsSurrogate.errorEstimate();
+
+    // More nodes: the error and its estimate both shrink
+    std::vector<ChebyshevAxis> fine = {{60.0, 140.0, 40}, {0.1, 0.5, 20}, {0.25, 2.0, 20}};
+    ChebyshevSurrogate bsFine = ChebyshevSurrogate::build(fine, bs, pool);
+    double fineErr = bsFine.validate(bs, 20000);
+    std::cout << "BS (40x20x20 nodes)\n";
+    std::cout << "  tail estimate:            " << bsFine.errorEstimate() << "\n";
+    std::cout << "  max error (20k points):   " << fineErr << "\n";
+    ok = ok && fineErr < bsErr && bsFine.errorEstimate() < bsSurrogate.errorEstimate();
+
+    // 2. Save / load round trip
+    const std::string path = "test_surrogate.cheb";
+    bsSurrogate.save(path);
+    ChebyshevSurrogate loaded = ChebyshevSurrogate::load(path);
+    std::remove(path.c_str());
+    bool identical = loaded.coefficients() == bsSurrogate.coefficients() &&
+                     loaded.errorEstimate() == bsSurrogate.errorEstimate() &&
+                     loaded.evaluate({101.3, 0.27, 0.8}) == bsSurrogate.evaluate({101.3, 0.27, 0.8});
+    std::cout << "\nSave/load round trip:       " << (identical ? "identical" : "DIFFERENT") << "\n";
+    ok = ok && identical;
+
+    // 3. Heston MC over (spot, vol): the surrogate reproduces the pricer it sampled
+    HestonPoint base;
+    base.xi = 0.4;
+    const int paths = 4000, steps = 25;
+    std::vector<HestonAxis> hestonAxes = {{HestonInput::SPOT, {60.0, 140.0, 16}}, {HestonInput::VOL, {0.1, 0.5, 10}}};
+    auto t0 = std::chrono::high_resolution_clock::now();
+    ChebyshevSurrogate heston = buildHestonSurrogate(base, OptionType::CALL, hestonAxes, paths, steps, pool);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double hestonErr = heston.validate([&](const double* x, int) {
+        HestonPoint p = base;
+        p.spot = x[0];
+        p.vol = x[1];
+        return hestonPointPrice(p, OptionType::CALL, paths, steps);
+    }, 200);
+    std::cout << "\nHeston MC (16x10 nodes, " << paths << " paths)\n";
+    std::cout << "  build:                    " << std::fixed << std::setprecision(1)
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n";
+    std::cout << "  tail estimate:            " << std::scientific << heston.errorEstimate() << "\n";
+    std::cout << "  max error vs pricer:      " << hestonErr << "\n";
+    ok = ok && hestonErr < 0.05;
+
+    // 4. Evaluation cost
+    const int evals = 1000000;
+    double sink = 0.0;
+    auto t2 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < evals; ++i) {
+        double x[2] = {60.0 + 80.0 * (i % 1000) / 1000.0, 0.1 + 0.4 * (i / 1000) / 1000.0};
+        sink += heston.evaluate(x);
+    }
+    auto t3 = std::chrono::high_resolution_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t3 - t2).count() / evals;
+    std::cout << "  evaluation:               " << std::fixed << std::setprecision(1) << ns << " ns"
+              << " (checksum " << std::setprecision(3) << sink / evals << ")\n";
+
+    // 5. Bad input is rejected
+    bool rejected = false;
+    try {
+        ChebyshevSurrogate::build({{1.0, 1.0, 8}}, bs);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    ok = ok && rejected;
+
+    if (ok) {
+        std::cout << "\n SUCCESS: Surrogates are accurate, persistent and cheap to evaluate!\n";
+    } else {
+        std::cout << "\n FAILURE: Surrogate accuracy or serialisation is off.\n";
+    }
+
+    printSeparator();
+    return ok ? 0 : 1;
+}